@@ -0,0 +1,24 @@
+#
+# Copyright (C) 2026 Codership Oy <info@codership.com>
+#
+# System LZ4 library for write set data compression. It is required
+# whenever data compression is compiled in.
+#
+
+if (NOT GALERA_WITH_LZ4)
+  message(STATUS "Write set data compression disabled")
+  return()
+endif()
+
+check_include_file(lz4.h HAVE_LZ4_H)
+find_library(HAVE_LZ4_LIB lz4)
+
+if (NOT HAVE_LZ4_H OR NOT HAVE_LZ4_LIB)
+  message(FATAL_ERROR "LZ4 library required for write set data compression "
+    "was not found. Configure with -DGALERA_WITH_LZ4=OFF to build without "
+    "data compression.")
+endif()
+
+add_definitions(-DGALERA_HAVE_LZ4)
+set(GALERA_LZ4_LIBS ${HAVE_LZ4_LIB})
+message(STATUS "GALERA_LZ4_LIBS: ${GALERA_LZ4_LIBS}")
@@ -0,0 +1,21 @@
+#
+# Copyright (C) 2026 Codership Oy <info@codership.com>
+#
+# Optional zstd library for GCache cold tier compression. Write sets are
+# compressed only with LZ4, see lz4.cmake.
+#
+
+if (NOT GALERA_WITH_ZSTD)
+  return()
+endif()
+
+check_include_file(zstd.h HAVE_ZSTD_H)
+find_library(HAVE_ZSTD_LIB zstd)
+
+if (HAVE_ZSTD_H AND HAVE_ZSTD_LIB)
+  add_definitions(-DGALERA_HAVE_ZSTD)
+  set(GALERA_ZSTD_LIBS ${HAVE_ZSTD_LIB})
+  message(STATUS "GALERA_ZSTD_LIBS: ${GALERA_ZSTD_LIBS}")
+else()
+  message(STATUS "zstd not found, zstd GCache cold tier compression disabled")
+endif()
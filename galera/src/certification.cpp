@@ -6,9 +6,10 @@
 
 #include "gu_lock.hpp"
 #include "gu_throw.hpp"
+#include "gu_datetime.hpp"
 
 #include <map>
-#include <algorithm> // std::for_each
+#include <algorithm> // std::for_each, std::stable_sort, std::sort
 
 using namespace galera;
 
@@ -19,11 +20,18 @@ static const bool cert_debug_on(false);
 
 #define CERT_PARAM_LOG_CONFLICTS galera::Certification::PARAM_LOG_CONFLICTS
 #define CERT_PARAM_OPTIMISTIC_PA galera::Certification::PARAM_OPTIMISTIC_PA
+#define CERT_PARAM_INDEX_SHARDS  galera::Certification::PARAM_INDEX_SHARDS
+#define CERT_PARAM_PURGE_STEP_KEYS galera::Certification::PARAM_PURGE_STEP_KEYS
+#define CERT_PARAM_EXACT_DEPS    galera::Certification::PARAM_EXACT_DEPS
 
 static std::string const CERT_PARAM_PREFIX("cert.");
 
 std::string const CERT_PARAM_LOG_CONFLICTS(CERT_PARAM_PREFIX + "log_conflicts");
 std::string const CERT_PARAM_OPTIMISTIC_PA(CERT_PARAM_PREFIX + "optimistic_pa");
+std::string const CERT_PARAM_INDEX_SHARDS (CERT_PARAM_PREFIX + "index_shards");
+std::string const CERT_PARAM_PURGE_STEP_KEYS(CERT_PARAM_PREFIX +
+                                             "purge_step_keys");
+std::string const CERT_PARAM_EXACT_DEPS   (CERT_PARAM_PREFIX + "exact_deps");
 
 static std::string const CERT_PARAM_MAX_LENGTH   (CERT_PARAM_PREFIX +
                                                   "max_length");
@@ -32,6 +40,22 @@ static std::string const CERT_PARAM_LENGTH_CHECK (CERT_PARAM_PREFIX +
 
 static std::string const CERT_PARAM_LOG_CONFLICTS_DEFAULT("no");
 static std::string const CERT_PARAM_OPTIMISTIC_PA_DEFAULT("yes");
+static std::string const CERT_PARAM_INDEX_SHARDS_DEFAULT ("16");
+static std::string const CERT_PARAM_PURGE_STEP_KEYS_DEFAULT("10000");
+static std::string const CERT_PARAM_EXACT_DEPS_DEFAULT   ("no");
+
+/* write sets with more exact dependencies fall back to depends_seqno */
+static size_t const CERT_MAX_EXACT_DEPS(16);
+
+/* marks dependency on a shared or reference key holder: those don't depend
+ * on each other and only the latest one is referenced by the index, so
+ * earlier holders can't be tracked and depends_seqno must be used instead */
+static wsrep_seqno_t const CERT_INEXACT_DEP(WSREP_SEQNO_UNDEFINED);
+
+/* purge step and certification blocked time histogram bins, seconds */
+static std::string const CERT_HISTOGRAM_BINS(
+    "0.0,0.0001,0.00031623,0.001,0.0031623,0.01,0.031623,0.1,0.31623,1.,"
+    "3.1623,10.,31.623");
 
 /*** It is EXTREMELY important that these constants are the same on all nodes.
  *** Don't change them ever!!! ***/
@@ -44,6 +68,11 @@ galera::Certification::register_params(gu::Config& cnf)
     const int flags(gu::Config::Flag::type_bool);
     cnf.add(CERT_PARAM_LOG_CONFLICTS, CERT_PARAM_LOG_CONFLICTS_DEFAULT, flags);
     cnf.add(CERT_PARAM_OPTIMISTIC_PA, CERT_PARAM_OPTIMISTIC_PA_DEFAULT, flags);
+    cnf.add(CERT_PARAM_INDEX_SHARDS, CERT_PARAM_INDEX_SHARDS_DEFAULT,
+            gu::Config::Flag::read_only | gu::Config::Flag::type_integer);
+    cnf.add(CERT_PARAM_PURGE_STEP_KEYS, CERT_PARAM_PURGE_STEP_KEYS_DEFAULT,
+            gu::Config::Flag::type_integer);
+    cnf.add(CERT_PARAM_EXACT_DEPS, CERT_PARAM_EXACT_DEPS_DEFAULT, flags);
     /* The defaults below are deliberately not reflected in conf: people
      * should not know about these dangerous setting unless they read RTFM. */
     cnf.add(CERT_PARAM_MAX_LENGTH, gu::Config::Flag::hidden);
@@ -70,11 +99,91 @@ length_check(const gu::Config& conf)
         return gu::Config::from_config<int>(CERT_PARAM_LENGTH_CHECK_DEFAULT);
 }
 
+/* a function to get around unset defaults in ctor initialization list */
+static size_t
+index_shards(const gu::Config& conf)
+{
+    long long const ret(conf.get<long long>(CERT_PARAM_INDEX_SHARDS));
+    if (ret < 1 || ret > 1024)
+    {
+        gu_throw_error(EINVAL) << "Bad value " << ret << " for "
+                               << CERT_PARAM_INDEX_SHARDS
+                               << ", must be in range [1, 1024]";
+    }
+    return ret;
+}
+
+static size_t
+purge_step_keys(const std::string& value)
+{
+    long long const ret(gu::Config::from_config<long long>(value));
+    if (ret < 0)
+    {
+        gu_throw_error(EINVAL) << "Bad value " << ret << " for "
+                               << CERT_PARAM_PURGE_STEP_KEYS
+                               << ", must be non-negative";
+    }
+    return ret;
+}
+
+static size_t
+shards_mask(size_t const n_shards)
+{
+    size_t n(1);
+    while (n < n_shards) n <<= 1;
+    return n - 1;
+}
+
+galera::Certification::CertIndexNGShards::CertIndexNGShards(size_t n_shards)
+    :
+    mask_  (shards_mask(n_shards)),
+    shards_(new Shard[mask_ + 1]),
+    size_  (0)
+{}
+
+void
+galera::Certification::CertIndexNGShards::clear()
+{
+    for (size_t i(0); i < n_shards(); ++i)
+    {
+        shards_[i].index.clear();
+    }
+    size_ = 0;
+}
+
+size_t
+galera::Certification::CertIndexNGShards::shards_size() const
+{
+    size_t ret(0);
+    for (size_t i(0); i < n_shards(); ++i)
+    {
+        gu::Lock lock(shards_[i].mutex);
+        ret += shards_[i].index.size();
+    }
+    return ret;
+}
+
+namespace
+{
+    /* Releases mutex locked in the enclosing scope for the lifetime of
+     * the object. */
+    class Unlock
+    {
+    public:
+        explicit Unlock(const gu::Mutex& mtx) : mtx_(mtx) { mtx_.unlock(); }
+        ~Unlock() { mtx_.lock(); }
+    private:
+        Unlock(const Unlock&);
+        Unlock& operator=(const Unlock&);
+        const gu::Mutex& mtx_;
+    };
+}
+
 static void
-report_stale_entry(const galera::Certification::CertIndexNG::value_type& ke,
+report_stale_entry(const galera::KeyEntryNG& ke,
                    const galera::KeySetIn& key_set)
 {
-    std::cerr << "Found stale entry for key: " << ke->key() << "\n";
+    std::cerr << "Found stale entry for key: " << ke.key() << "\n";
     key_set.rewind();
     std::cerr << "Key set\n";
     for (long i = 0; i < key_set.count(); ++i)
@@ -91,42 +200,79 @@ report_stale_entry(const galera::Certification::CertIndexNG::value_type& ke,
 // This method requires iterating over whole index, so it is relatively
 // expensive, and should be used only for debugging purposes.
 static void
-check_purge_complete(const galera::Certification::CertIndexNG& cert_index,
+check_purge_complete(const galera::Certification::CertIndexNGShards& cert_index,
                      const galera::TrxHandleSlave* ts,
                      const galera::KeySetIn& key_set)
 {
-    std::for_each(
-        cert_index.begin(), cert_index.end(),
-        [&key_set, ts]
-        (const galera::Certification::CertIndexNG::value_type& ke) {
-            ke->for_each_ref([&ke, &key_set, ts](const TrxHandleSlave* ref) {
-                if (ts == ref)
+    for (size_t i(0); i < cert_index.n_shards(); ++i)
+    {
+        galera::Certification::CertIndexNGShards::Shard& shard(cert_index[i]);
+        gu::Lock lock(shard.mutex);
+        shard.index.for_each(
+            [&key_set, ts]
+            (const galera::KeyEntryNG& ke) {
+                ke.for_each_ref([&ke, &key_set, ts](const TrxHandleSlave* ref)
                 {
-                    report_stale_entry(ke, key_set);
-                }
-                assert(ts != ref);
+                    if (ts == ref)
+                    {
+                        report_stale_entry(ke, key_set);
+                    }
+                    assert(ts != ref);
+                });
             });
-        });
+    }
+}
+
+/* Calls f(shard, key) for every key in keys. Keys are grouped by shard,
+ * see Certification::prepare_keys(), so every shard is locked only once per
+ * group. Stops and returns true as soon as f() returns true. */
+template <typename Func>
+static bool
+for_each_key(const galera::Certification::CertIndexNGShards& cert_index,
+             const galera::TrxHandleSlave::CertKeys&          keys,
+             Func                                             f)
+{
+    galera::TrxHandleSlave::CertKeys::const_iterator i(keys.begin());
+
+    while (i != keys.end())
+    {
+        size_t const shard_index(cert_index.shard_index(*i));
+        galera::Certification::CertIndexNGShards::Shard&
+            shard(cert_index[shard_index]);
+        gu::Lock lock(shard.mutex);
+
+        do
+        {
+            if (f(shard.index, *i)) return true;
+            ++i;
+        }
+        while (i != keys.end() && cert_index.shard_index(*i) == shard_index);
+    }
+
+    return false;
 }
 
-// Purge key set from given index
-static void purge_key_set(galera::Certification::CertIndexNG& cert_index,
-                          galera::TrxHandleSlave*             ts,
-                          const galera::KeySetIn&             key_set,
-                          const long                          count)
+// Purge key set from given index. Shard lock is taken for every key
+// separately, so that certification waits for at most one key erasure.
+static void purge_key_set(galera::Certification::CertIndexNGShards& cert_index,
+                          galera::TrxHandleSlave*                   ts,
+                          const galera::TrxHandleSlave::CertKeys&   keys)
 {
-    for (long i(0); i < count; ++i)
+    for (galera::TrxHandleSlave::CertKeys::const_iterator i(keys.begin());
+         i != keys.end(); ++i)
     {
-        const galera::KeySet::KeyPart& kp(key_set.next());
-        galera::KeyEntryNG ke(kp);
-        galera::Certification::CertIndexNG::iterator ci(cert_index.find(&ke));
-        assert(ci != cert_index.end());
-        if (ci == cert_index.end())
+        const galera::KeySet::KeyPart& kp(*i);
+        galera::Certification::CertIndexNGShards::Shard&
+            shard(cert_index.shard(kp));
+        gu::Lock lock(shard.mutex);
+
+        galera::KeyEntryNG* const kep(shard.index.find(kp));
+        assert(kep != NULL);
+        if (kep == NULL)
         {
             log_warn << "Could not find key from index";
             continue;
         }
-        galera::KeyEntryNG* const kep(*ci);
         assert(kep->referenced() == true);
 
         wsrep_key_type_t const p(kp.wsrep_type(ts->version()));
@@ -136,25 +282,26 @@ static void purge_key_set(galera::Certification::CertIndexNG& cert_index,
             kep->unref(p, ts);
             if (kep->referenced() == false)
             {
-                cert_index.erase(ci);
-                delete kep;
+                shard.index.erase(kep);
+                cert_index.erased();
             }
         }
     }
+
     if (cert_debug_on)
     {
-        check_purge_complete(cert_index, ts, key_set);
+        check_purge_complete(cert_index, ts, ts->write_set().keyset());
     }
 }
 
+/* Called either under mutex_ or by purge_step() for trxs it has already
+ * taken off trx_map_, so that nobody else purges the same trx. */
 void
 galera::Certification::purge_for_trx(TrxHandleSlave* trx)
 {
-    assert(mutex_.owned());
     assert(trx->version() >= 3 || trx->version() <= WriteSetNG::MAX_VERSION);
-    const KeySetIn& keys(trx->write_set().keyset());
-    keys.rewind();
-    purge_key_set(cert_index_ng_, trx, keys, keys.count());
+    purge_key_set(cert_index_ng_, trx, trx->cert_keys());
+    TrxHandleSlave::CertKeys().swap(trx->cert_keys());
 }
 
 /* Specifically for chain use in certify_and_depend_v3to6() */
@@ -165,7 +312,8 @@ check_against(const galera::KeyEntryNG*   const found,
               wsrep_key_type_t            const key_type,
               galera::TrxHandleSlave*     const trx,
               bool                        const log_conflict,
-              wsrep_seqno_t&                    depends_seqno)
+              wsrep_seqno_t&                    depends_seqno,
+              galera::TrxHandleSlave::Deps* const deps)
 {
     enum CheckType
     {
@@ -232,6 +380,16 @@ check_against(const galera::KeyEntryNG*   const found,
             /* fall through */
         case DEPENDENCY:
             depends_seqno = std::max(ref_trx->global_seqno(), depends_seqno);
+            if (deps)
+            {
+                wsrep_seqno_t const dep(
+                    REF_KEY_TYPE == WSREP_KEY_SHARED ||
+                    REF_KEY_TYPE == WSREP_KEY_REFERENCE ?
+                    CERT_INEXACT_DEP : ref_trx->global_seqno());
+
+                if (deps->empty() || deps->back() != dep)
+                    deps->push_back(dep);
+            }
             /* fall through */
         case NOTHING:;
         }
@@ -245,7 +403,8 @@ static inline bool
 certify_and_depend_v3to6(const galera::KeyEntryNG*   const found,
                          const galera::KeySet::KeyPart&    key,
                          galera::TrxHandleSlave*     const trx,
-                         bool                        const log_conflict)
+                         bool                        const log_conflict,
+                         galera::TrxHandleSlave::Deps* const deps)
 {
     bool ret(false);
     wsrep_seqno_t depends_seqno(trx->depends_seqno());
@@ -266,18 +425,19 @@ certify_and_depend_v3to6(const galera::KeyEntryNG*   const found,
      *   ------------------------
      *
      * Note that depends_seqno is an in/out parameter and is updated on every
-     * step.
+     * step. If deps is not NULL, seqnos of the write sets trx depends on are
+     * appended to it.
      */
     if (check_against<WSREP_KEY_EXCLUSIVE>
-        (found, key, key_type, trx, log_conflict, depends_seqno) ||
+        (found, key, key_type, trx, log_conflict, depends_seqno, deps) ||
         check_against<WSREP_KEY_UPDATE>
-        (found, key, key_type, trx, log_conflict, depends_seqno) ||
+        (found, key, key_type, trx, log_conflict, depends_seqno, deps) ||
         (key_type >= WSREP_KEY_UPDATE &&
          /* exclusive and update keys must be checked against shared */
          (check_against<WSREP_KEY_REFERENCE>
-          (found, key, key_type, trx, log_conflict, depends_seqno) ||
+          (found, key, key_type, trx, log_conflict, depends_seqno, deps) ||
           check_against<WSREP_KEY_SHARED>
-          (found, key, key_type, trx, log_conflict, depends_seqno))))
+          (found, key, key_type, trx, log_conflict, depends_seqno, deps))))
     {
         ret = true;
     }
@@ -290,53 +450,121 @@ certify_and_depend_v3to6(const galera::KeyEntryNG*   const found,
 
 /* returns true on collision, false otherwise */
 static bool
-certify_v3to6(const galera::Certification::CertIndexNG& cert_index_ng,
-              const galera::KeySet::KeyPart&      key,
-              galera::TrxHandleSlave*     const   trx,
-              bool                        const   log_conflicts)
+certify_v3to6(const galera::Certification::CertIndexNGShards& cert_index_ng,
+              const galera::TrxHandleSlave::CertKeys&          keys,
+              galera::TrxHandleSlave*                   const  trx,
+              bool                                      const  log_conflicts,
+              galera::TrxHandleSlave::Deps*             const  deps)
 {
-    galera::KeyEntryNG ke(key);
-    galera::Certification::CertIndexNG::const_iterator ci(cert_index_ng.find(&ke));
-
-    if (cert_index_ng.end() == ci)
+    return for_each_key(cert_index_ng, keys,
+                        [trx, log_conflicts, deps]
+                        (galera::Certification::CertIndexNG& index,
+                         const galera::KeySet::KeyPart&      key)
     {
-        return false; // No match
-    }
+        const galera::KeyEntryNG* const kep(index.find(key));
 
-    cert_debug << "found existing entry";
+        if (NULL == kep)
+        {
+            return false; // No match
+        }
 
-    galera::KeyEntryNG* const kep(*ci);
-    // Note: For we skip certification for isolated trxs, only
-    // cert index and key_list is populated.
-    return (!trx->is_toi() &&
-            certify_and_depend_v3to6(kep, key, trx, log_conflicts));
+        cert_debug << "found existing entry";
+
+        // Note: For we skip certification for isolated trxs, only
+        // cert index and key_list is populated.
+        return (!trx->is_toi() &&
+                certify_and_depend_v3to6(kep, key, trx, log_conflicts, deps));
+    });
 }
 
 // Add key to trx references for trx that passed certification.
 //
 // @param cert_index certification index in use
 // @param trx        certified transaction
-// @param key_set    key_set used in certification
-// @param key_count  number of keys in key set
-static void do_ref_keys(galera::Certification::CertIndexNG& cert_index,
-                        galera::TrxHandleSlave*       const trx,
-                        const galera::KeySetIn&             key_set,
-                        const long                          key_count)
+// @param keys       keys used in certification
+static void do_ref_keys(galera::Certification::CertIndexNGShards& cert_index,
+                        galera::TrxHandleSlave*             const trx,
+                        const galera::TrxHandleSlave::CertKeys&   keys)
 {
-    for (long i(0); i < key_count; ++i)
+    for_each_key(cert_index, keys,
+                 [&cert_index, trx]
+                 (galera::Certification::CertIndexNG& index,
+                  const galera::KeySet::KeyPart&      k)
     {
-        const galera::KeySet::KeyPart& k(key_set.next());
-        galera::KeyEntryNG ke(k);
-        galera::Certification::CertIndexNG::const_iterator
-            ci(cert_index.find(&ke));
+        std::pair<galera::KeyEntryNG*, bool> const ret(index.insert(k));
 
-        if (ci == cert_index.end())
+        if (ret.second)
         {
-            galera::KeyEntryNG* const kep(new galera::KeyEntryNG(ke));
-            ci = cert_index.insert(kep).first;
+            cert_index.inserted();
             cert_debug << "created new entry";
         }
-        (*ci)->ref(k.wsrep_type(trx->version()), k, trx);
+        ret.first->ref(k.wsrep_type(trx->version()), k, trx);
+        return false;
+    });
+}
+
+/* Parses the key set once, so that subsequent passes over the keys don't
+ * have to walk the record headers again */
+static void
+parse_keys(const galera::KeySetIn& key_set,
+           galera::TrxHandleSlave::CertKeys& keys)
+{
+    long const key_count(key_set.count());
+
+    keys.reserve(key_count);
+    key_set.rewind();
+    for (long i(0); i < key_count; ++i)
+    {
+        keys.push_back(key_set.next());
+    }
+}
+
+void
+galera::Certification::prepare_keys(TrxHandleSlave& trx) const
+{
+    TrxHandleSlave::CertKeys& keys(trx.cert_keys());
+
+    if (!keys.empty()) return; // already prepared
+
+    parse_keys(trx.write_set().keyset(), keys);
+
+    const CertIndexNGShards& index(cert_index_ng_);
+    std::stable_sort(keys.begin(), keys.end(),
+                     [&index](const KeySet::KeyPart& l,
+                              const KeySet::KeyPart& r)
+                     {
+                         return index.shard_index(l) < index.shard_index(r);
+                     });
+}
+
+/* Leaves only exact dependencies above base. If there are too many to be
+ * worth tracking or some can't be tracked, trx falls back to waiting for all
+ * up to depends_seqno. */
+static void
+set_exact_deps(galera::TrxHandleSlave& trx, wsrep_seqno_t const base)
+{
+    galera::TrxHandleSlave::Deps& deps(trx.deps());
+
+    std::sort(deps.begin(), deps.end());
+
+    if (!deps.empty() && deps.front() == CERT_INEXACT_DEP)
+    {
+        trx.clear_exact_deps();
+        return;
+    }
+
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    deps.erase(deps.begin(), std::upper_bound(deps.begin(), deps.end(), base));
+
+    if (deps.size() <= CERT_MAX_EXACT_DEPS)
+    {
+        assert(std::max(base, deps.empty() ? base : deps.back()) ==
+               trx.depends_seqno());
+        trx.set_exact_deps(base);
+    }
+    else
+    {
+        trx.clear_exact_deps();
     }
 }
 
@@ -345,48 +573,61 @@ galera::Certification::do_test_v3to6(TrxHandleSlave* trx)
 {
     cert_debug << "BEGIN CERTIFICATION v" << trx->version() << ": " << *trx;
 
+    const TrxHandleSlave::CertKeys& keys(trx->cert_keys());
+
+    /* Isolated trxs are not certified against the index and must be applied
+     * in isolation anyways, so exact dependencies are not tracked for them.
+     * Dependencies not coming from the keys are accounted in the base. */
+    trx->clear_exact_deps();
+    TrxHandleSlave::Deps* const deps(exact_deps_ && !trx->is_toi() ?
+                                     &trx->deps() : NULL);
+    wsrep_seqno_t const base(std::max(trx->depends_seqno(), last_pa_unsafe_));
+
 #ifndef NDEBUG
     // to check that cleanup after cert failure returns cert_index
     // to original size
-    size_t prev_cert_index_size(cert_index_ng_.size());
+    size_t const prev_cert_index_size(cert_index_ng_.shards_size());
 #endif // NDEBUG
 
-    const KeySetIn& key_set(trx->write_set().keyset());
-    long const      key_count(key_set.count());
-    long            processed(0);
-
-    key_set.rewind();
-
-    for (; processed < key_count; ++processed)
     {
-        const KeySet::KeyPart& key(key_set.next());
+        /* Index is accessed under shard locks only, so committing appliers
+         * are not blocked on mutex_ while keys are being processed.
+         * Concurrent certification is excluded by order_mutex_. */
+        assert(order_mutex_.owned());
+        Unlock unlock(mutex_);
+
+        prepare_keys(*trx); // no-op if done before ordering
 
-        if (certify_v3to6(cert_index_ng_, key, trx, log_conflicts_))
+        if (certify_v3to6(cert_index_ng_, keys, trx, log_conflicts_, deps))
         {
-            trx->set_depends_seqno(std::max(trx->depends_seqno(), last_pa_unsafe_));
+            trx->set_depends_seqno(std::max(trx->depends_seqno(),
+                                            last_pa_unsafe_));
             goto cert_fail;
         }
-    }
 
-    trx->set_depends_seqno(std::max(trx->depends_seqno(), last_pa_unsafe_));
+        trx->set_depends_seqno(std::max(trx->depends_seqno(), last_pa_unsafe_));
 
-    assert (key_count == processed);
-    key_set.rewind();
-    do_ref_keys(cert_index_ng_, trx, key_set, key_count);
+        if (deps) set_exact_deps(*trx, base);
+
+        do_ref_keys(cert_index_ng_, trx, keys);
+    }
 
     if (trx->pa_unsafe()) last_pa_unsafe_ = trx->global_seqno();
 
-    key_count_ += key_count;
+    key_count_ += keys.size();
 
     cert_debug << "END CERTIFICATION (success): " << *trx;
     return TEST_OK;
 
 cert_fail:
 
+    trx->clear_exact_deps();
+
     cert_debug << "END CERTIFICATION (failed): " << *trx;
 
-    assert (processed < key_count);
-    assert(cert_index_ng_.size() == prev_cert_index_size);
+    /* Index purge may remove entries concurrently, but entries are inserted
+     * only under order_mutex_, so the index must not have grown. */
+    assert(cert_index_ng_.shards_size() <= prev_cert_index_size);
 
     return TEST_FAILED;
 }
@@ -441,6 +682,24 @@ galera::Certification::do_test(const TrxHandleSlavePtr& trx)
         return TEST_FAILED;
     }
 
+    /* Keys hashed by different functions can't be matched against each other,
+     * so the trx must not overlap with write sets of the other hash family
+     * in the index and must depend on them. This happens only during
+     * protocol upgrade. */
+    const KeySetIn& key_set(trx->write_set().keyset());
+    int const key_hash(key_set.count() > 0 ?
+                       KeySet::fast_hash(key_set.version()) : -1);
+    if (gu_unlikely(key_hash >= 0 && trx->certified() == false &&
+                    trx->last_seen_seqno() < key_hash_seqno_[!key_hash]))
+    {
+        log_debug << "Certification failed for trx " << *trx
+                 << ": its keys are hashed with "
+                 << (key_hash ? "fast hash" : "MMH3")
+                 << " but keys hashed otherwise were certified up to seqno "
+                 << key_hash_seqno_[!key_hash];
+        return TEST_FAILED;
+    }
+
     TestResult res(TEST_FAILED);
 
     /* initialize parent seqno */
@@ -458,6 +717,12 @@ galera::Certification::do_test(const TrxHandleSlavePtr& trx)
         if (ds > trx->depends_seqno()) trx->set_depends_seqno(ds);
     }
 
+    /* dependencies on the other hash family can't be found in the index */
+    if (key_hash >= 0 && key_hash_seqno_[!key_hash] > trx->depends_seqno())
+    {
+        trx->set_depends_seqno(key_hash_seqno_[!key_hash]);
+    }
+
     switch (version_)
     {
     case 1:
@@ -477,11 +742,11 @@ galera::Certification::do_test(const TrxHandleSlavePtr& trx)
     if (res == TEST_OK)
     {
         ++trx_count_;
-        gu::Lock lock(stats_mutex_);
-        ++n_certified_;
-        deps_dist_ += (trx->global_seqno() - trx->depends_seqno());
-        cert_interval_ += (trx->global_seqno() - trx->last_seen_seqno() - 1);
-        index_size_ = cert_index_ng_.size();
+        ++pending_stats_.n_certified_;
+        pending_stats_.deps_dist_ +=
+            (trx->global_seqno() - trx->depends_seqno());
+        pending_stats_.cert_interval_ +=
+            (trx->global_seqno() - trx->last_seen_seqno() - 1);
     }
 
     // Additional NBO certification.
@@ -491,6 +756,11 @@ galera::Certification::do_test(const TrxHandleSlavePtr& trx)
         assert(TEST_FAILED == res || trx->depends_seqno() >= 0);
     }
 
+    if (TEST_OK == res && key_hash >= 0)
+    {
+        key_hash_seqno_[key_hash] = trx->global_seqno();
+    }
+
     byte_count_ += trx->size();
 
     return res;
@@ -593,18 +863,15 @@ galera::NBOEntry copy_ts(
 static void purge_key_set_nbo(galera::Certification::CertIndexNBO& cert_index,
                               bool                                 is_nbo_index,
                               galera::TrxHandleSlave*              ts,
-                              const galera::KeySetIn&              key_set,
-                              const long                           count)
+                              const galera::TrxHandleSlave::CertKeys& keys)
 {
     using galera::Certification;
     using galera::KeyEntryNG;
     using galera::KeySet;
 
-    key_set.rewind();
-
-    for (long i(0); i < count; ++i)
+    for (size_t i(0); i < keys.size(); ++i)
     {
-        KeyEntryNG ke(key_set.next());
+        KeyEntryNG ke(keys[i]);
         std::pair<Certification::CertIndexNBO::iterator,
                   Certification::CertIndexNBO::iterator>
             ci_range(cert_index.equal_range(&ke));
@@ -645,9 +912,8 @@ static void end_nbo(galera::NBOMap::iterator             i,
 
     log_debug << "Ending NBO started by " << *e.ts_ptr();
 
-    // Erase entry from index
-    const KeySetIn& key_set(e.ts_ptr()->write_set().keyset());
-    purge_key_set_nbo(nbo_index, true, e.ts_ptr(), key_set, key_set.count());
+    // Erase entry from index, keys were parsed at NBO start
+    purge_key_set_nbo(nbo_index, true, e.ts_ptr(), e.ts_ptr()->cert_keys());
 
     ts->set_ends_nbo(e.ts_ptr()->global_seqno());
 
@@ -740,20 +1006,17 @@ certify_nbo(galera::Certification::CertIndexNBO& cert_index,
 }
 
 static void
-do_ref_keys_nbo(galera::Certification::CertIndexNBO& index,
-                TrxHandleSlave*                const trx,
-                const galera::KeySetIn&              key_set,
-                const long                           key_count)
+do_ref_keys_nbo(galera::Certification::CertIndexNBO&    index,
+                TrxHandleSlave*                   const trx,
+                const galera::TrxHandleSlave::CertKeys& keys)
 {
     using galera::KeySet;
     using galera::KeyEntryNG;
     using galera::Certification;
 
-    key_set.rewind();
-
-    for (long i(0); i < key_count; ++i)
+    for (size_t i(0); i < keys.size(); ++i)
     {
-        const KeySet::KeyPart& key(key_set.next());
+        const KeySet::KeyPart& key(keys[i]);
         wsrep_key_type_t const type(key.wsrep_type(trx->version()));
         KeyEntryNG* kep (new KeyEntryNG(key));
         Certification::CertIndexNBO::iterator it;
@@ -824,15 +1087,15 @@ galera::Certification::TestResult galera::Certification::do_test_nbo(
                                nbo_ctx_unlocked(ts->global_seqno())));
 
         TrxHandleSlave* new_ts(entry.ts_ptr());
-        const KeySetIn& key_set(new_ts->write_set().keyset());
-        long const      key_count(key_set.count());
-        long            processed(0);
 
-        key_set.rewind();
-        for (; processed < key_count; ++processed)
+        /* the keys are walked again to reference them and once more at
+         * NBO end, so parse them only once and keep with the copy */
+        TrxHandleSlave::CertKeys& keys(new_ts->cert_keys());
+        parse_keys(new_ts->write_set().keyset(), keys);
+
+        for (size_t i(0); i < keys.size(); ++i)
         {
-            const KeySet::KeyPart& key(key_set.next());
-            if (certify_nbo(nbo_index_, key, new_ts, log_conflicts_))
+            if (certify_nbo(nbo_index_, keys[i], new_ts, log_conflicts_))
             {
                 ret = TEST_FAILED;
                 break;
@@ -842,7 +1105,7 @@ galera::Certification::TestResult galera::Certification::do_test_nbo(
         switch (ret)
         {
         case TEST_OK:
-            do_ref_keys_nbo(nbo_index_, new_ts, key_set, key_count);
+            do_ref_keys_nbo(nbo_index_, new_ts, keys);
             nbo_map_.insert(std::make_pair(new_ts->global_seqno(),
                                            entry));
             break;
@@ -918,7 +1181,7 @@ galera::Certification::Certification(gu::Config&     conf,
     conf_                  (conf),
     gcache_                (cache),
     trx_map_               (),
-    cert_index_ng_         (),
+    cert_index_ng_         (index_shards(conf)),
     nbo_map_               (),
     nbo_ctx_map_           (),
     nbo_index_             (),
@@ -926,20 +1189,28 @@ galera::Certification::Certification(gu::Config&     conf,
     deps_set_              (),
     current_view_          (),
     service_thd_           (thd),
+    order_mutex_           (gu::get_mutex_key(gu::GU_MUTEX_KEY_CERTIFICATION_ORDER)),
     mutex_                 (gu::get_mutex_key(gu::GU_MUTEX_KEY_CERTIFICATION)),
+    purge_cond_            (gu::get_cond_key(gu::GU_COND_KEY_CERTIFICATION_PURGE)),
+    purging_               (false),
     trx_size_warn_count_   (0),
     initial_position_      (-1),
     position_              (-1),
     nbo_position_          (-1),
     safe_to_discard_seqno_ (-1),
+    purge_seqno_           (-1),
     last_pa_unsafe_        (-1),
     last_preordered_seqno_ (position_),
     last_preordered_id_    (0),
+    key_hash_seqno_        (),
     stats_mutex_           (gu::get_mutex_key(gu::GU_MUTEX_KEY_CERTIFICATION_STATS)),
     n_certified_           (0),
     deps_dist_             (0),
     cert_interval_         (0),
     index_size_            (0),
+    pending_stats_         (),
+    purge_hs_              (CERT_HISTOGRAM_BINS),
+    blocked_hs_            (CERT_HISTOGRAM_BINS),
     key_count_             (0),
     byte_count_            (0),
     trx_count_             (0),
@@ -948,12 +1219,17 @@ galera::Certification::Certification(gu::Config&     conf,
     max_length_check_      (length_check(conf)),
     inconsistent_          (false),
     log_conflicts_         (conf.get<bool>(CERT_PARAM_LOG_CONFLICTS)),
-    optimistic_pa_         (conf.get<bool>(CERT_PARAM_OPTIMISTIC_PA))
+    optimistic_pa_         (conf.get<bool>(CERT_PARAM_OPTIMISTIC_PA)),
+    exact_deps_            (conf.get<bool>(CERT_PARAM_EXACT_DEPS)),
+    purge_step_keys_       (purge_step_keys(
+                                conf.get(CERT_PARAM_PURGE_STEP_KEYS)))
 {}
 
 
 galera::Certification::~Certification()
 {
+    if (service_thd_) service_thd_->purge_cert_cancel(*this);
+
     log_info << "cert index usage at exit "   << cert_index_ng_.size();
     log_info << "cert trx map usage at exit " << trx_map_.size();
     log_info << "deps set usage at exit "     << deps_set_.size();
@@ -1015,46 +1291,53 @@ void galera::Certification::assign_initial_position(const gu::GTID& gtid,
     }
 
     wsrep_seqno_t const seqno(gtid.seqno());
-    gu::Lock lock(mutex_);
+    gu::Lock order_lock(order_mutex_);
+    {
+        gu::Lock lock(mutex_);
 
-    std::for_each(trx_map_.begin(), trx_map_.end(), PurgeAndDiscard(*this));
+        wait_purge_step_(lock);
 
-    if (seqno >= position_)
-    {
-        assert(cert_index_ng_.size() == 0);
-    }
-    else
-    {
-        if (seqno > 0) // don't warn on index reset.
+        std::for_each(trx_map_.begin(), trx_map_.end(),
+                      PurgeAndDiscard(*this));
+
+        if (seqno >= position_)
         {
-            log_warn << "moving position backwards: " << position_ << " -> "
-                     << seqno;
+            assert(cert_index_ng_.size() == 0);
         }
+        else
+        {
+            if (seqno > 0) // don't warn on index reset.
+            {
+                log_warn << "moving position backwards: " << position_
+                         << " -> " << seqno;
+            }
 
-        std::for_each(cert_index_ng_.begin(), cert_index_ng_.end(),
-                      gu::DeleteObject());
-        cert_index_ng_.clear();
-    }
+            cert_index_ng_.clear();
+        }
 
-    trx_map_.clear();
-    assert(cert_index_ng_.empty());
+        trx_map_.clear();
+        assert(cert_index_ng_.empty());
 
-    if (service_thd_)
-    {
-        service_thd_->release_seqno(position_);
-        service_thd_->flush(gtid.uuid());
+        if (service_thd_) service_thd_->release_seqno(position_);
+
+        log_info << "####### Assign initial position for certification: "
+                 << gtid << ", protocol version: " << version;
+
+        initial_position_      = seqno;
+        position_              = seqno;
+        safe_to_discard_seqno_ = seqno;
+        purge_seqno_           = -1;
+        last_pa_unsafe_        = seqno;
+        last_preordered_seqno_ = position_;
+        last_preordered_id_    = 0;
+        version_               = version;
+        key_hash_seqno_[0]     = -1;
+        key_hash_seqno_[1]     = -1;
     }
 
-    log_info << "####### Assign initial position for certification: " << gtid
-             << ", protocol version: " << version;
-
-    initial_position_      = seqno;
-    position_              = seqno;
-    safe_to_discard_seqno_ = seqno;
-    last_pa_unsafe_        = seqno;
-    last_preordered_seqno_ = position_;
-    last_preordered_id_    = 0;
-    version_               = version;
+    /* flush without mutex_ as service thread may be waiting for it in
+     * purge_step() */
+    if (service_thd_) service_thd_->flush(gtid.uuid());
 }
 
 
@@ -1066,44 +1349,49 @@ galera::Certification::adjust_position(const View&         view,
     assert(gtid.uuid()  != GU_UUID_NIL);
     assert(gtid.seqno() >= 0);
 
-    gu::Lock lock(mutex_);
+    gu::Lock order_lock(order_mutex_);
+    {
+        gu::Lock lock(mutex_);
 
 // this assert is too strong: local ordered transactions may get canceled without
 // entering certification    assert(position_ + 1 == seqno || 0 == position_);
 
-    log_info << "####### Adjusting cert position: "
-             << position_ << " -> " << gtid.seqno();
+        log_info << "####### Adjusting cert position: "
+                 << position_ << " -> " << gtid.seqno();
 
-    if (version != version_)
-    {
-        std::for_each(trx_map_.begin(), trx_map_.end(), PurgeAndDiscard(*this));
-        assert(trx_map_.empty() || trx_map_.rbegin()->first + 1 == position_);
-        trx_map_.clear();
-        assert(cert_index_ng_.empty());
-        if (service_thd_)
+        if (version != version_)
         {
-            service_thd_->release_seqno(position_);
+            wait_purge_step_(lock);
+            std::for_each(trx_map_.begin(), trx_map_.end(),
+                          PurgeAndDiscard(*this));
+            assert(trx_map_.empty() ||
+                   trx_map_.rbegin()->first + 1 == position_);
+            trx_map_.clear();
+            assert(cert_index_ng_.empty());
+            if (service_thd_)
+            {
+                service_thd_->release_seqno(position_);
+            }
         }
-    }
 
-    if (service_thd_)
-    {
-        service_thd_->flush(gtid.uuid());
-    }
-
-    position_       = gtid.seqno();
-    last_pa_unsafe_ = position_;
-    version_        = version;
-    current_view_   = view;
+        position_       = gtid.seqno();
+        last_pa_unsafe_ = position_;
+        version_        = version;
+        current_view_   = view;
 
-    // Loop over NBO entries, clear state and abort waiters. NBO end waiters
-    // must resend end messages.
-    for (NBOMap::iterator i(nbo_map_.begin()); i != nbo_map_.end(); ++i)
-    {
-        NBOEntry& e(i->second);
-        e.clear_ended();
-        e.nbo_ctx()->set_aborted(true);
+        // Loop over NBO entries, clear state and abort waiters. NBO end
+        // waiters must resend end messages.
+        for (NBOMap::iterator i(nbo_map_.begin()); i != nbo_map_.end(); ++i)
+        {
+            NBOEntry& e(i->second);
+            e.clear_ended();
+            e.nbo_ctx()->set_aborted(true);
+        }
     }
+
+    /* flush without mutex_ as service thread may be waiting for it in
+     * purge_step() */
+    if (service_thd_) service_thd_->flush(gtid.uuid());
 }
 
 galera::Certification::TestResult
@@ -1133,30 +1421,142 @@ wsrep_seqno_t galera::Certification::get_safe_to_discard_seqno_() const
     }
     else
     {
-        retval = (*deps_set_.begin()) - 1;
+        retval = deps_set_.min() - 1;
     }
     return retval;
 }
 
 
+wsrep_seqno_t
+galera::Certification::purge_trxs_upto(wsrep_seqno_t const seqno,
+                                       bool const          handle_gcache)
+{
+    gu::Lock lock(mutex_);
+    const wsrep_seqno_t stds(get_safe_to_discard_seqno_());
+    // assert(seqno <= get_safe_to_discard_seqno());
+    // Note: setting trx committed is not done in total order so
+    // safe to discard seqno may decrease. Enable assertion above when
+    // this issue is fixed.
+    wsrep_seqno_t const purge_seqno(std::min(seqno, stds));
+
+    if (handle_gcache && service_thd_ && purge_step_keys_ > 0)
+    {
+        if (purge_seqno > purge_seqno_)
+        {
+            purge_seqno_ = purge_seqno;
+            service_thd_->purge_cert(*this);
+        }
+        return purge_seqno;
+    }
+
+    return purge_trxs_upto_(purge_seqno, handle_gcache, lock);
+}
+
+
+bool
+galera::Certification::purge_step()
+{
+    long long const start(gu_time_monotonic());
+    PurgeBatch    batch;
+    wsrep_seqno_t purged;
+    bool          more;
+    {
+        gu::Lock lock(mutex_);
+        /* safe to discard seqno may have decreased meanwhile, see above */
+        wsrep_seqno_t const seqno(std::min(purge_seqno_,
+                                           get_safe_to_discard_seqno_()));
+        if (seqno <= 0) return false;
+
+        more = take_purge_batch_(seqno, purge_step_keys_, batch, purged);
+        purging_ = true;
+    }
+
+    /* Trxs in the batch are not in trx_map_ anymore, so their index entries
+     * can be purged without mutex_, not blocking committing appliers.
+     * Synchronous purges wait for purging_ to be reset. */
+    try
+    {
+        std::for_each(batch.begin(), batch.end(), PurgeAndDiscard(*this));
+    }
+    catch (...)
+    {
+        gu::Lock lock(mutex_);
+        purging_ = false;
+        purge_cond_.broadcast();
+        throw;
+    }
+
+    {
+        gu::Lock lock(mutex_);
+        purging_ = false;
+        purge_cond_.broadcast();
+
+        /* gcache buffers may be released only after index entries pointing
+         * to them are gone */
+        if (service_thd_ && purged > 0) service_thd_->release_seqno(purged);
+    }
+
+    double const duration(double(gu_time_monotonic() - start)/
+                          gu::datetime::Sec);
+
+    gu::Lock lock(stats_mutex_);
+    purge_hs_.insert(duration);
+
+    return more;
+}
+
+
+bool
+galera::Certification::take_purge_batch_(wsrep_seqno_t const seqno,
+                                         size_t        const max_keys,
+                                         PurgeBatch&         batch,
+                                         wsrep_seqno_t&      purged)
+{
+    assert(mutex_.owned());
+
+    TrxMap::iterator i(trx_map_.begin());
+
+    /* every trx costs at least one key to bound the number of trxs too */
+    for (size_t keys(0); i != trx_map_.end() && i->first <= seqno &&
+             keys < max_keys; ++i)
+    {
+        keys += 1 + (i->second ? i->second->cert_keys().size() : 0);
+        batch.push_back(*i);
+    }
+
+    bool const more(i != trx_map_.end() && i->first <= seqno);
+    purged = more ? i->first - 1 : seqno;
+
+    trx_map_.erase(trx_map_.begin(), i);
+
+    return more;
+}
+
+
 wsrep_seqno_t
 galera::Certification::purge_trxs_upto_(wsrep_seqno_t const seqno,
-                                        bool const          handle_gcache)
+                                        bool const          handle_gcache,
+                                        gu::Lock&           lock)
 {
     assert (seqno > 0);
     assert(mutex_.owned());
 
-    TrxMap::iterator purge_bound(trx_map_.upper_bound(seqno));
+    wait_purge_step_(lock);
 
     cert_debug << "purging index up to " << seqno << ", safe to discard seqno " << get_safe_to_discard_seqno_();
 
-    assert(purge_bound == trx_map_.end() ||
-           purge_bound->first <= get_safe_to_discard_seqno_() + 1);
+    assert(trx_map_.upper_bound(seqno) == trx_map_.end() ||
+           trx_map_.upper_bound(seqno)->first <=
+           get_safe_to_discard_seqno_() + 1);
 
-    for_each(trx_map_.begin(), purge_bound, PurgeAndDiscard(*this));
-    trx_map_.erase(trx_map_.begin(), purge_bound);
+    TrxMap::iterator const upto(trx_map_.upper_bound(seqno));
+    std::for_each(trx_map_.begin(), upto, PurgeAndDiscard(*this));
+    trx_map_.erase(trx_map_.begin(), upto);
 
-    if (handle_gcache && service_thd_) service_thd_->release_seqno(seqno);
+    if (handle_gcache && service_thd_)
+    {
+        service_thd_->release_seqno(seqno);
+    }
 
     if (0 == ((trx_map_.size() + 1) % 10000))
     {
@@ -1170,74 +1570,104 @@ galera::Certification::purge_trxs_upto_(wsrep_seqno_t const seqno,
 
 
 galera::Certification::TestResult
-galera::Certification::append_trx(const TrxHandleSlavePtr& trx)
+galera::Certification::append_trx_(const TrxHandleSlavePtr& trx,
+                                   gu::Lock&                lock)
 {
+    assert(order_mutex_.owned());
+    assert(mutex_.owned());
 // explicit ROLLBACK is dummy()    assert(!trx->is_dummy());
     assert(trx->global_seqno() > 0 /* && trx->local_seqno() >= 0 */);
     assert(trx->global_seqno() > position_);
 
-#ifndef NDEBUG
-    bool const explicit_rollback(trx->explicit_rollback());
-#endif /* NDEBUG */
-    TestResult retval = TEST_FAILED;
+    if (gu_unlikely(trx->global_seqno() != position_ + 1))
     {
-        gu::Lock lock(mutex_);
+        // this is perfectly normal if trx is rolled back just after
+        // replication, keeping the log though
+        log_debug << "seqno gap, position: " << position_
+                  << " trx seqno " << trx->global_seqno();
+    }
 
-        if (gu_unlikely(trx->global_seqno() != position_ + 1))
+    if (gu_unlikely((trx->last_seen_seqno() + 1) < trx_map_.begin()->first))
+    {
+        /* See #733 - for now it is false positive */
+        cert_debug
+            << "WARNING: last_seen_seqno is below certification index: "
+            << trx_map_.begin()->first << " > " << trx->last_seen_seqno();
+    }
+
+    position_ = trx->global_seqno();
+
+    if (gu_unlikely(!(position_ & max_length_check_) &&
+                    (trx_map_.size() > static_cast<size_t>(max_length_))))
+    {
+        log_debug << "trx map size: " << trx_map_.size()
+                  << " - check if status.last_committed is incrementing";
+
+        wsrep_seqno_t       trim_seqno(position_ - max_length_);
+        wsrep_seqno_t const stds      (get_safe_to_discard_seqno_());
+
+        if (trim_seqno > stds)
         {
-            // this is perfectly normal if trx is rolled back just after
-            // replication, keeping the log though
-            log_debug << "seqno gap, position: " << position_
-                      << " trx seqno " << trx->global_seqno();
+            log_warn << "Attempt to trim certification index at "
+                     << trim_seqno << ", above safe-to-discard: " << stds;
+            trim_seqno = stds;
         }
-
-        if (gu_unlikely((trx->last_seen_seqno() + 1) < trx_map_.begin()->first))
+        else
         {
-            /* See #733 - for now it is false positive */
-            cert_debug
-                << "WARNING: last_seen_seqno is below certification index: "
-                << trx_map_.begin()->first << " > " << trx->last_seen_seqno();
+            cert_debug << "append_trx: purging index up to " << trim_seqno;
         }
 
-        position_ = trx->global_seqno();
+        purge_trxs_upto_(trim_seqno, true, lock);
+    }
 
-        if (gu_unlikely(!(position_ & max_length_check_) &&
-                        (trx_map_.size() > static_cast<size_t>(max_length_))))
-        {
-            log_debug << "trx map size: " << trx_map_.size()
-                      << " - check if status.last_committed is incrementing";
+    TestResult const retval(test(trx));
 
-            wsrep_seqno_t       trim_seqno(position_ - max_length_);
-            wsrep_seqno_t const stds      (get_safe_to_discard_seqno_());
+    /* seqnos are increasing, so the hint makes insertion constant time */
+    size_t const map_size(trx_map_.size());
+    trx_map_.insert(trx_map_.end(), std::make_pair(trx->global_seqno(), trx));
+    if (trx_map_.size() == map_size)
+        gu_throw_fatal << "duplicate trx entry " << *trx;
 
-            if (trim_seqno > stds)
-            {
-                log_warn << "Attempt to trim certification index at "
-                         << trim_seqno << ", above safe-to-discard: " << stds;
-                trim_seqno = stds;
-            }
-            else
-            {
-                cert_debug << "append_trx: purging index up to " << trim_seqno;
-            }
+    // trx with local seqno WSREP_SEQNO_UNDEFINED originates from
+    // IST so deps set tracking should not be done
+    if (trx->local_seqno() != WSREP_SEQNO_UNDEFINED)
+    {
+        assert(trx->last_seen_seqno() != WSREP_SEQNO_UNDEFINED);
+        deps_set_.insert(trx->last_seen_seqno());
+        assert(deps_set_.size() <= trx_map_.size());
+    }
 
-            purge_trxs_upto_(trim_seqno, true);
-        }
+    return retval;
+}
 
-        retval = test(trx);
 
-        if (trx_map_.insert(
-                std::make_pair(trx->global_seqno(), trx)).second == false)
-            gu_throw_fatal << "duplicate trx entry " << *trx;
+galera::Certification::TestResult
+galera::Certification::append_trx(const TrxHandleSlavePtr& trx)
+{
+#ifndef NDEBUG
+    bool const explicit_rollback(trx->explicit_rollback());
+#endif /* NDEBUG */
+    TestResult retval = TEST_FAILED;
+    long long blocked(gu_time_monotonic());
+    PendingStats stats;
+    {
+        gu::Lock order_lock(order_mutex_);
+        gu::Lock lock(mutex_);
 
-        // trx with local seqno WSREP_SEQNO_UNDEFINED originates from
-        // IST so deps set tracking should not be done
-        if (trx->local_seqno() != WSREP_SEQNO_UNDEFINED)
-        {
-            assert(trx->last_seen_seqno() != WSREP_SEQNO_UNDEFINED);
-            deps_set_.insert(trx->last_seen_seqno());
-            assert(deps_set_.size() <= trx_map_.size());
-        }
+        blocked = gu_time_monotonic() - blocked;
+
+        retval = append_trx_(trx, lock);
+
+        std::swap(stats, pending_stats_);
+    }
+
+    {
+        gu::Lock lock(stats_mutex_);
+        n_certified_   += stats.n_certified_;
+        deps_dist_     += stats.deps_dist_;
+        cert_interval_ += stats.cert_interval_;
+        index_size_     = cert_index_ng_.size();
+        blocked_hs_.insert(double(blocked)/gu::datetime::Sec);
     }
 
     if (!trx->certified()) trx->mark_certified();
@@ -1288,12 +1718,12 @@ wsrep_seqno_t galera::Certification::set_trx_committed(TrxHandleSlave& trx)
             !trx.cert_bypass())
         {
             assert(trx.last_seen_seqno() != WSREP_SEQNO_UNDEFINED);
-            DepsSet::iterator i(deps_set_.find(trx.last_seen_seqno()));
-            assert(i != deps_set_.end());
-
-            if (deps_set_.size() == 1) safe_to_discard_seqno_ = *i;
+            if (deps_set_.size() == 1)
+            {
+                safe_to_discard_seqno_ = trx.last_seen_seqno();
+            }
 
-            deps_set_.erase(i);
+            deps_set_.erase(trx.last_seen_seqno());
         }
 
         if (gu_unlikely(index_purge_required()))
@@ -1344,6 +1774,18 @@ galera::Certification::param_set(const std::string& key,
         set_boolean_parameter(optimistic_pa_, value, CERT_PARAM_OPTIMISTIC_PA,
                               "\"optimistic\" parallel applying.");
     }
+    else if (key == Certification::PARAM_EXACT_DEPS)
+    {
+        set_boolean_parameter(exact_deps_, value, CERT_PARAM_EXACT_DEPS,
+                              "exact dependency tracking for parallel "
+                              "applying.");
+    }
+    else if (key == Certification::PARAM_PURGE_STEP_KEYS)
+    {
+        size_t const step(purge_step_keys(value));
+        gu::Lock lock(mutex_);
+        purge_step_keys_ = step;
+    }
     else
     {
         throw gu::NotFound();
@@ -1352,6 +1794,14 @@ galera::Certification::param_set(const std::string& key,
     conf_.set(key, value);
 }
 
+void
+galera::Certification::get_status(gu::Status& status) const
+{
+    gu::Lock lock(stats_mutex_);
+    status.insert("cert_purge_hs",   purge_hs_.to_string());
+    status.insert("cert_blocked_hs", blocked_hs_.to_string());
+}
+
 void
 galera::Certification::mark_inconsistent()
 {
@@ -9,6 +9,8 @@
 #include "nbo.hpp"
 #include "trx_handle.hpp"
 #include "key_entry_ng.hpp"
+#include "key_entry_table.hpp"
+#include "deps_set.hpp"
 #include "galera_service_thd.hpp"
 #include "galera_view.hpp"
 
@@ -19,9 +21,13 @@
 #include <gu_lock.hpp>
 #include <gu_config.hpp>
 #include <gu_gtid.hpp>
+#include <gu_atomic.hpp>
+#include <gu_histogram.hpp>
+#include <gu_status.hpp>
 
 #include <map>
 #include <list>
+#include <vector>
 
 namespace galera
 {
@@ -31,25 +37,92 @@ namespace galera
 
         static std::string const PARAM_LOG_CONFLICTS;
         static std::string const PARAM_OPTIMISTIC_PA;
+        static std::string const PARAM_INDEX_SHARDS;
+        static std::string const PARAM_PURGE_STEP_KEYS;
+        static std::string const PARAM_EXACT_DEPS;
 
         static void register_params(gu::Config&);
 
         typedef gu::UnorderedSet<KeyEntryOS*,
                                  KeyEntryPtrHash, KeyEntryPtrEqual> CertIndex;
 
-        typedef gu::UnorderedSet<KeyEntryNG*,
-                                 KeyEntryPtrHashNG, KeyEntryPtrEqualNG>
-        CertIndexNG;
+        typedef KeyEntryTable CertIndexNG;
 
         typedef gu::UnorderedMultiset<KeyEntryNG*,
                                       KeyEntryPtrHashNG, KeyEntryPtrEqualNG>
         CertIndexNBO;
 
-    private:
+        /* NG certification index partitioned by key hash. Each shard has
+         * its own mutex, so certification and purge serialize only on the
+         * shards of the keys they touch. */
+        class CertIndexNGShards
+        {
+        public:
+
+            struct Shard
+            {
+                Shard()
+                    : mutex(gu::get_mutex_key(
+                                gu::GU_MUTEX_KEY_CERTIFICATION_INDEX)),
+                      index()
+                {}
+
+                gu::Mutex   mutex;
+                CertIndexNG index;
+            };
+
+            /* n_shards is rounded up to the nearest power of 2 */
+            explicit CertIndexNGShards(size_t n_shards);
+            ~CertIndexNGShards() { delete[] shards_; }
+
+            size_t shard_index(const KeySet::KeyPart& kp) const
+            {
+                return kp.hash() & mask_;
+            }
+
+            Shard& shard(const KeySet::KeyPart& kp) const
+            {
+                return shards_[shard_index(kp)];
+            }
+
+            Shard& operator[](size_t const i) const
+            {
+                assert(i < n_shards());
+                return shards_[i];
+            }
+
+            size_t n_shards() const { return mask_ + 1; }
+
+            /* Total number of entries in all shards. Entry insertions and
+             * removals must be accounted with inserted()/erased(). */
+            size_t size()  const { return size_(); }
+            bool   empty() const { return size() == 0; }
+
+            void inserted() { ++size_; }
+            void erased()   { --size_; }
+
+            /* Sum of shard index sizes, each taken under the shard mutex.
+             * Expensive, for debugging only. */
+            size_t shards_size() const;
 
-        typedef std::multiset<wsrep_seqno_t>             DepsSet;
+            /* Delete all entries. Caller must guarantee that the index is
+             * not accessed concurrently. */
+            void clear();
+
+        private:
+
+            CertIndexNGShards(const CertIndexNGShards&);
+            CertIndexNGShards& operator=(const CertIndexNGShards&);
+
+            size_t const       mask_;
+            Shard* const       shards_;
+            gu::Atomic<size_t> size_;
+        };
+
+    private:
 
         typedef std::map<wsrep_seqno_t, TrxHandleSlavePtr> TrxMap;
+        typedef std::vector<TrxMap::value_type>             PurgeBatch;
 
     public:
 
@@ -63,6 +136,13 @@ namespace galera
         ~Certification();
 
         void assign_initial_position(const gu::GTID& gtid, int version);
+
+        /* Decode the write set key set and group key parts by index shard.
+         * Does not access the index, so it may be called concurrently
+         * before the write set is ordered to take this work off the
+         * ordered certification path. Otherwise it is done by append_trx(). */
+        void prepare_keys(TrxHandleSlave&) const;
+
         TestResult append_trx(const TrxHandleSlavePtr&);
         /* Append dummy trx from cert index preload. */
         void append_dummy_preload(const TrxHandleSlavePtr&);
@@ -78,17 +158,18 @@ namespace galera
             return get_safe_to_discard_seqno_();
         }
 
+        /* If handle_gcache is true and service thread is available,
+         * the purge is only scheduled and then done incrementally
+         * by the service thread, see purge_step(). */
         wsrep_seqno_t
-        purge_trxs_upto(wsrep_seqno_t const seqno, bool const handle_gcache)
-        {
-            gu::Lock lock(mutex_);
-            const wsrep_seqno_t stds(get_safe_to_discard_seqno_());
-            // assert(seqno <= get_safe_to_discard_seqno());
-            // Note: setting trx committed is not done in total order so
-            // safe to discard seqno may decrease. Enable assertion above when
-            // this issue is fixed.
-            return purge_trxs_upto_(std::min(seqno, stds), handle_gcache);
-        }
+        purge_trxs_upto(wsrep_seqno_t const seqno, bool const handle_gcache);
+
+        /* Purge next portion of at most cert.purge_step_keys keys up to
+         * scheduled purge seqno. Returns true if there is more to purge.
+         * Called by service thread. The certification mutex is held only
+         * to take the portion off the trx map, index entries are removed
+         * under index shard locks. */
+        bool purge_step();
 
         // Set trx corresponding to handle committed. Return purge seqno if
         // index purge is required, -1 otherwise.
@@ -117,8 +198,13 @@ namespace galera
             deps_dist_ = 0;
             n_certified_ = 0;
             index_size_ = 0;
+            purge_hs_.clear();
+            blocked_hs_.clear();
         }
 
+        /* Adds purge duration and certification blocked time histograms */
+        void get_status(gu::Status& status) const;
+
         void param_set(const std::string& key, const std::string& value);
 
         wsrep_seqno_t lowest_trx_seqno() const
@@ -147,6 +233,7 @@ namespace galera
         Certification(const Certification&);
         Certification& operator=(const Certification&);
 
+        TestResult append_trx_(const TrxHandleSlavePtr&, gu::Lock&);
         TestResult test(const TrxHandleSlavePtr&);
         TestResult do_test(const TrxHandleSlavePtr&);
         TestResult do_test_v3to6(TrxHandleSlave*);
@@ -156,7 +243,15 @@ namespace galera
 
         // unprotected variants for internal use
         wsrep_seqno_t get_safe_to_discard_seqno_() const;
-        wsrep_seqno_t purge_trxs_upto_(wsrep_seqno_t, bool sync);
+        wsrep_seqno_t purge_trxs_upto_(wsrep_seqno_t, bool sync, gu::Lock&);
+        bool take_purge_batch_(wsrep_seqno_t, size_t max_keys, PurgeBatch&,
+                               wsrep_seqno_t& purged);
+        /* Waits until purge_step() is done with the index entries of
+         * the trxs it took off the trx map. */
+        void wait_purge_step_(gu::Lock& lock)
+        {
+            while (purging_) lock.wait(purge_cond_);
+        }
 
         gu::shared_ptr<NBOCtx>::type nbo_ctx_unlocked(wsrep_seqno_t);
 
@@ -235,7 +330,7 @@ namespace galera
         gu::Config&   conf_;
         gcache::GCache& gcache_;
         TrxMap        trx_map_;
-        CertIndexNG   cert_index_ng_;
+        CertIndexNGShards cert_index_ng_;
         NBOMap        nbo_map_;
         NBOCtxMap     nbo_ctx_map_;
         CertIndexNBO  nbo_index_;
@@ -243,21 +338,45 @@ namespace galera
         DepsSet       deps_set_;
         View          current_view_;
         ServiceThd*   service_thd_;
+        /* Serializes certification tests. Protects certification state
+         * which is not touched outside of test(). Lock order: order_mutex_,
+         * mutex_, index shard mutex. */
+        gu::Mutex     order_mutex_;
         gu::Mutex     mutex_;
+        gu::Cond      purge_cond_; // signaled when purging_ is reset
+        bool          purging_;    // purge_step() is purging the index
         size_t        trx_size_warn_count_;
         wsrep_seqno_t initial_position_;
         wsrep_seqno_t position_;
         wsrep_seqno_t nbo_position_;
         wsrep_seqno_t safe_to_discard_seqno_;
+        wsrep_seqno_t purge_seqno_; // scheduled incremental purge seqno
         wsrep_seqno_t last_pa_unsafe_;
         wsrep_seqno_t last_preordered_seqno_;
         wsrep_trx_id_t last_preordered_id_;
+        /* last seqno certified with MMH3 [0] and fast [1] key hashes */
+        wsrep_seqno_t key_hash_seqno_[2];
         gu::Mutex     stats_mutex_;
         size_t        n_certified_;
         wsrep_seqno_t deps_dist_;
         wsrep_seqno_t cert_interval_;
         size_t        index_size_;
 
+        /* Certification stats are accumulated under mutex_ and added to
+         * the above together with blocked_hs_ update in append_trx(). */
+        struct PendingStats
+        {
+            size_t        n_certified_;
+            wsrep_seqno_t deps_dist_;
+            wsrep_seqno_t cert_interval_;
+
+            PendingStats() : n_certified_(0), deps_dist_(0), cert_interval_(0)
+            {}
+        }             pending_stats_;
+
+        gu::Histogram purge_hs_;   // purge step duration, seconds
+        gu::Histogram blocked_hs_; // time append_trx() waits for locks
+
         size_t        key_count_;
         size_t        byte_count_;
         size_t        trx_count_;
@@ -274,6 +393,8 @@ namespace galera
         bool               inconsistent_;
         bool               log_conflicts_;
         bool               optimistic_pa_;
+        bool               exact_deps_;
+        size_t             purge_step_keys_;
     };
 }
 
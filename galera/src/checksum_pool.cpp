@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "checksum_pool.hpp"
+
+#include <gu_thread_keys.hpp>
+#include <gu_logger.hpp>
+#include <gu_time.h>
+
+#include <algorithm>
+#include <cstring> // strerror()
+
+galera::ChecksumPool::ChecksumPool(int const    threads,
+                                   size_t const queue_size,
+                                   size_t const threshold)
+    :
+    threads_    (),
+    queue_      (),
+    mtx_        (gu::get_mutex_key(gu::GU_MUTEX_KEY_CHECKSUM_POOL)),
+    cond_       (gu::get_cond_key(gu::GU_COND_KEY_CHECKSUM_POOL)),
+    done_       (gu::get_cond_key(gu::GU_COND_KEY_CHECKSUM_POOL_DONE)),
+    queue_size_ (queue_size),
+    threshold_  (threshold),
+    latency_sum_(0),
+    latency_cnt_(0),
+    pending_    (0),
+    exit_       (false)
+{
+    if (0 == queue_size_) return; // nowhere to queue jobs
+
+    threads_.reserve(threads);
+
+    for (int i(0); i < threads; ++i)
+    {
+        gu_thread_t thd;
+        int const err(gu_thread_create(
+                          gu::get_thread_key(gu::GU_THREAD_KEY_WRITE_SET_CHECK),
+                          &thd, thread_func, this));
+        if (gu_unlikely(0 != err))
+        {
+            log_warn << "Starting checksum thread failed: " << err
+                     << '(' << ::strerror(err) << "), continuing with "
+                     << threads_.size() << " threads";
+            break;
+        }
+
+        threads_.push_back(thd);
+    }
+}
+
+galera::ChecksumPool::~ChecksumPool()
+{
+    {
+        gu::Lock lock(mtx_);
+        exit_ = true;
+        cond_.broadcast();
+    }
+
+    for (size_t i(0); i < threads_.size(); ++i)
+    {
+        gu_thread_join(threads_[i], NULL);
+    }
+
+    assert(queue_.empty());
+
+    /* jobs refer to the pool until waited for by write sets being
+     * destroyed in other threads */
+    gu::Lock lock(mtx_);
+    gu::datetime::Date const until(gu::datetime::Date::calendar()
+                                   + 10 * gu::datetime::Sec);
+    while (pending_ > 0)
+    {
+        try { lock.wait(done_, until); }
+        catch (gu::Exception&)
+        {
+            log_warn << "Checksum pool destroyed with " << pending_
+                     << " jobs not waited for";
+            break;
+        }
+    }
+}
+
+bool
+galera::ChecksumPool::submit(Job& job, Job::Func const func, void* const arg)
+{
+    assert(!job.pending());
+
+    if (!enabled()) return false;
+
+    gu::Lock lock(mtx_);
+
+    if (queue_.size() >= queue_size_ || exit_) return false;
+
+    job.func_   = func;
+    job.arg_    = arg;
+    job.pool_   = this;
+    job.queued_ = gu_time_monotonic();
+    job.state_  = Job::S_QUEUED;
+
+    ++pending_;
+    queue_.push_back(&job);
+    cond_.signal();
+
+    return true;
+}
+
+void
+galera::ChecksumPool::complete(Job& job)
+{
+    latency_sum_ += gu_time_monotonic() - job.queued_;
+    latency_cnt_ += 1;
+    job.state_ = Job::S_DONE;
+}
+
+void
+galera::ChecksumPool::wait_job(Job& job)
+{
+    assert(job.pool_ == this);
+
+    gu::Lock lock(mtx_);
+
+    if (Job::S_QUEUED == job.state_)
+    {
+        /* no thread got to it yet, don't wait for the queue to drain */
+        std::deque<Job*>::iterator const i
+            (std::find(queue_.begin(), queue_.end(), &job));
+        assert(i != queue_.end());
+        queue_.erase(i);
+        job.state_ = Job::S_RUNNING;
+        mtx_.unlock(); // job functions don't throw
+        job.func_(job.arg_);
+        mtx_.lock();
+        complete(job);
+    }
+
+    while (Job::S_DONE != job.state_) lock.wait(done_);
+
+    job.state_ = Job::S_IDLE;
+    job.pool_  = NULL;
+
+    if (0 == --pending_) done_.broadcast();
+}
+
+void
+galera::ChecksumPool::get_stats(long long& queue_len, double& latency) const
+{
+    gu::Lock lock(mtx_);
+
+    queue_len = queue_.size();
+    latency   = latency_cnt_ > 0 ?
+        double(latency_sum_) / latency_cnt_ / 1.0e9 : 0.0;
+}
+
+void
+galera::ChecksumPool::flush_stats()
+{
+    gu::Lock lock(mtx_);
+
+    latency_sum_ = 0;
+    latency_cnt_ = 0;
+}
+
+void
+galera::ChecksumPool::run()
+{
+    gu::Lock lock(mtx_);
+
+    while (true)
+    {
+        while (queue_.empty() && !exit_) lock.wait(cond_);
+
+        /* drain the queue before exiting: queued jobs must be completed */
+        if (queue_.empty()) break;
+
+        Job* const job(queue_.front());
+        queue_.pop_front();
+        assert(Job::S_QUEUED == job->state_);
+        job->state_ = Job::S_RUNNING;
+
+        mtx_.unlock(); // job functions don't throw
+        job->func_(job->arg_);
+        mtx_.lock();
+
+        complete(*job); // job may be gone after done_ is broadcast
+        done_.broadcast();
+    }
+}
+
+void*
+galera::ChecksumPool::thread_func(void* const arg)
+{
+    static_cast<ChecksumPool*>(arg)->run();
+    return NULL;
+}
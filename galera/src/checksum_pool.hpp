@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#ifndef GALERA_CHECKSUM_POOL_HPP
+#define GALERA_CHECKSUM_POOL_HPP
+
+#include <gu_lock.hpp> // gu::Mutex and gu::Cond
+#include <gu_threads.h>
+
+#include <deque>
+#include <vector>
+
+namespace galera
+{
+    /*!
+     * Fixed pool of threads verifying write set checksums in the background,
+     * so that checksumming of several write sets overlaps with certification.
+     * The queue is bounded: when it is full submit() refuses the job and
+     * the caller is expected to do the work in the foreground.
+     */
+    class ChecksumPool
+    {
+    public:
+
+        class Job
+        {
+        public:
+
+            typedef void* (*Func)(void*);
+
+            Job() : func_(NULL), arg_(NULL), pool_(NULL), queued_(0),
+                    state_(S_IDLE)
+            {}
+
+            /* job was accepted by a pool and must be waited for */
+            bool pending() const { return (pool_ != NULL); }
+
+        private:
+
+            friend class ChecksumPool;
+
+            enum State { S_IDLE, S_QUEUED, S_RUNNING, S_DONE };
+
+            Func          func_;
+            void*         arg_;
+            ChecksumPool* pool_;
+            long long     queued_; // monotonic time of submission, ns
+            State         state_;
+
+            Job(const Job&);
+            Job& operator=(const Job&);
+        };
+
+        /*!
+         * @param threads    number of verifier threads, 0 disables the pool
+         * @param queue_size maximum number of jobs waiting for a thread
+         * @param threshold  minimum write set size worth a background job
+         */
+        ChecksumPool(int threads, size_t queue_size, size_t threshold);
+
+        /*! completes all queued jobs, stops the threads and waits for a while
+         *  for the accepted jobs to be waited for, the pool must be
+         *  uninstalled by now */
+        ~ChecksumPool();
+
+        bool   enabled()   const { return !threads_.empty(); }
+        size_t threshold() const { return threshold_; }
+
+        /*!
+         * Queues func(arg) for execution.
+         * @return false if pool is disabled or the queue is full */
+        bool submit(Job& job, Job::Func func, void* arg);
+
+        /*!
+         * Waits for submitted job to complete. If the job has not been
+         * picked up by a thread yet, it is executed by the caller. */
+        static void wait(Job& job)
+        {
+            if (job.pool_) job.pool_->wait_job(job);
+        }
+
+        /*! current queue depth and average verification latency (seconds,
+         *  from submission to completion) since last flush_stats() */
+        void get_stats(long long& queue_len, double& latency) const;
+
+        void flush_stats();
+
+    private:
+
+        std::vector<gu_thread_t> threads_;
+        std::deque<Job*>         queue_;
+        gu::Mutex mutable        mtx_;
+        gu::Cond                 cond_; // work available or exit
+        gu::Cond                 done_; // some job completed
+        size_t const             queue_size_;
+        size_t const             threshold_;
+        long long                latency_sum_; // ns
+        long long                latency_cnt_;
+        long                     pending_; // accepted, not waited for yet
+        bool                     exit_;
+
+        void wait_job(Job& job);
+        void complete(Job& job); // must be called under mtx_
+        void run();
+
+        static void* thread_func(void* arg);
+
+        ChecksumPool(const ChecksumPool&);
+        ChecksumPool& operator=(const ChecksumPool&);
+    };
+}
+
+#endif // GALERA_CHECKSUM_POOL_HPP
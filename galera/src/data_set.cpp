@@ -1,6 +1,136 @@
 //
-// Copyright (C) 2013 Codership Oy <info@codership.com>
+// Copyright (C) 2013-2026 Codership Oy <info@codership.com>
 //
 
 #include "data_set.hpp"
 
+#include <limits>
+
+gu::Compression::Type
+galera::DataSet::compression(const std::string& name)
+{
+    gu::Compression::Type const ret(gu::Compression::type(name));
+
+    if (!compression_supported(ret))
+    {
+        gu_throw_error(EINVAL) << "Compression '" << name
+                               << "' is not supported for data sets, "
+                               << "expected one of: none, lz4";
+    }
+
+    return ret;
+}
+
+void
+galera::DataSetOut::pack()
+{
+    assert(version_ >= DataSet::VER2);
+    assert(NULL == packed_);
+
+    GatherVector raw;
+    payload(raw);
+
+    assert(raw->size() > 0);
+    assert(raw[0].size > 0);
+
+    size_t raw_size(0);
+    for (size_t i(0); i < raw->size(); ++i) raw_size += raw[i].size;
+
+    /* skip the leading Compression::NONE byte */
+    --raw_size;
+
+    size_t const hdr_size(1 + gu::uleb128_size(raw_size));
+    if (raw_size <= hdr_size) return;
+
+    /* compressor needs contiguous input */
+    std::vector<gu::byte_t> tmp;
+    const gu::byte_t* src(static_cast<const gu::byte_t*>(raw[0].ptr) + 1);
+
+    if (raw->size() > 1)
+    {
+        tmp.reserve(raw_size);
+        tmp.insert(tmp.end(), src, src + raw[0].size - 1);
+
+        for (size_t i(1); i < raw->size(); ++i)
+        {
+            const gu::byte_t* const ptr
+                (static_cast<const gu::byte_t*>(raw[i].ptr));
+            tmp.insert(tmp.end(), ptr, ptr + raw[i].size);
+        }
+
+        src = tmp.data();
+    }
+
+    /* anything not smaller than the raw data is no gain */
+    packed_buf_.resize(raw_size);
+
+    size_t const packed_size(
+        gu::Compression::compress(compression_, src, raw_size,
+                                  packed_buf_.data() + hdr_size,
+                                  raw_size - hdr_size));
+
+    if (0 == packed_size)
+    {
+        /* incompressible, send as is */
+        std::vector<gu::byte_t>().swap(packed_buf_);
+        return;
+    }
+
+    packed_buf_[0] = compression_;
+    gu::uleb128_encode(raw_size, packed_buf_.data(), hdr_size, 1);
+    packed_buf_.resize(hdr_size + packed_size);
+
+    packed_ = new gu::RecordSetOut<DataSet::RecordOut>(
+        NULL, 0, *base_name_, check_type(version_, gu::RecordSet::version()),
+        gu::RecordSet::version());
+
+    /* packed_buf_ stays until this object is destroyed */
+    gu_trace(packed_->append(packed_buf_.data(), packed_buf_.size(),
+                             false, false));
+}
+
+
+gu::Buf
+galera::DataSetIn::unpack(const gu::Buf& buf) const
+{
+    const gu::byte_t* const ptr(static_cast<const gu::byte_t*>(buf.ptr));
+
+    if (gu_unlikely(buf.size < 1))
+    {
+        gu_throw_error(EINVAL) << "Empty DataSet record";
+    }
+
+    gu::Compression::Type const type(gu::Compression::type(ptr[0]));
+
+    if (gu::Compression::NONE == type)
+    {
+        gu::Buf const ret = { ptr + 1, buf.size - 1 };
+        return ret;
+    }
+
+    if (gu_unlikely(!DataSet::compression_supported(type)))
+    {
+        gu_throw_error(EINVAL) << "Unsupported DataSet compression: " << type;
+    }
+
+    if (plain_.empty())
+    {
+        uint64_t     size;
+        size_t const off(gu::uleb128_decode(ptr, buf.size, 1, size));
+
+        if (gu_unlikely(0 == size ||
+                        size > uint64_t(std::numeric_limits<int>::max())))
+        {
+            gu_throw_error(EINVAL) << "Invalid uncompressed DataSet size: "
+                                   << size;
+        }
+
+        std::vector<gu::byte_t> tmp(size);
+        gu_trace(gu::Compression::decompress(type, ptr + off, buf.size - off,
+                                             tmp.data(), tmp.size()));
+        plain_.swap(tmp);
+    }
+
+    gu::Buf const ret = { plain_.data(), ssize_t(plain_.size()) };
+    return ret;
+}
@@ -8,6 +8,10 @@
 
 #include "gu_rset.hpp"
 #include "gu_vlq.hpp"
+#include "gu_compress.hpp"
+
+#include <string>
+#include <vector>
 
 
 namespace galera
@@ -16,13 +20,19 @@ namespace galera
     {
     public:
 
+        /*
+         * VER2 data set record starts with gu::Compression::Type byte.
+         * If it is not NONE, it is followed by ULEB128 uncompressed size
+         * and compressed data.
+         */
         enum Version
         {
             EMPTY = 0,
-            VER1
+            VER1,
+            VER2
         };
 
-        static Version const MAX_VERSION = VER1;
+        static Version const MAX_VERSION = VER2;
 
         static Version version (unsigned int ver)
         {
@@ -33,6 +43,18 @@ namespace galera
             return static_cast<Version>(ver); // Silence compiler
         }
 
+        /*! Data set compression must be decodable by every node, so only
+         *  LZ4, which is always built in, goes on the wire. */
+        static bool compression_supported (gu::Compression::Type const type)
+        {
+            return (gu::Compression::NONE == type ||
+                    gu::Compression::LZ4  == type);
+        }
+
+        /*! parses repl.data_compression value, throws EINVAL for types
+         *  which can't be used for data sets */
+        static gu::Compression::Type compression (const std::string& name);
+
         /*! Dummy class to instantiate DataSetOut */
         class RecordOut {};
 
@@ -80,7 +102,9 @@ namespace galera
 
         DataSetOut () // empty ctor for slave TrxHandle
             :
-            gu::RecordSetOut<DataSet::RecordOut>(), version_()
+            gu::RecordSetOut<DataSet::RecordOut>(), version_(),
+            base_name_(NULL), compression_(gu::Compression::NONE),
+            threshold_(0), packed_(NULL), packed_buf_()
         {}
 
         DataSetOut (gu::byte_t*             reserved,
@@ -93,17 +117,37 @@ namespace galera
                 reserved,
                 reserved_size,
                 base_name,
-                check_type(version),
+                check_type(version, rsv),
                 rsv
                 ),
-            version_(version)
+            version_(version),
+            base_name_(&base_name),
+            compression_(gu::Compression::NONE),
+            threshold_(0),
+            packed_(NULL),
+            packed_buf_()
         {
             assert((uintptr_t(reserved) % GU_WORD_BYTES) == 0);
         }
 
+        ~DataSetOut() { delete packed_; }
+
         size_t
         append (const void* const src, size_t const size, bool const store)
         {
+            size_t ret(size);
+
+            if (version_ >= DataSet::VER2 && 0 == count())
+            {
+                /* uncompressed until proven otherwise in gather() */
+                static gu::byte_t const plain(gu::Compression::NONE);
+                gu_trace(
+                    gu::RecordSetOut<DataSet::RecordOut>::append (
+                        &plain, sizeof(plain), true, false);
+                    );
+                ret += sizeof(plain);
+            }
+
             /* append data as is, don't count as a new record */
             gu_trace(
                 gu::RecordSetOut<DataSet::RecordOut>::append (src, size, store,
@@ -111,7 +155,18 @@ namespace galera
                 );
             /* this will be deserialized using DataSet::RecordIn in DataSetIn */
 
-            return size;
+            return ret;
+        }
+
+        /* VER2 data sets of at least threshold bytes will be compressed
+         * with the given algorithm if that makes them smaller */
+        void set_compression (gu::Compression::Type const type,
+                              size_t const                threshold)
+        {
+            assert(version_ >= DataSet::VER2 ||
+                   gu::Compression::NONE == type);
+            compression_ = type;
+            threshold_   = threshold;
         }
 
         DataSet::Version
@@ -119,22 +174,58 @@ namespace galera
 
         typedef gu::RecordSet::GatherVector GatherVector;
 
+        /* compresses the data set if configured and worth it,
+         * returns true if gather() will return compressed data set */
+        bool compress ()
+        {
+            if (gu::Compression::NONE != compression_ && count() &&
+                size() >= threshold_)
+            {
+                gu_trace(pack());
+                compression_ = gu::Compression::NONE; // done
+            }
+
+            return (packed_ != NULL);
+        }
+
+        ssize_t gather (GatherVector& out)
+        {
+            if (compress()) return packed_->gather(out);
+
+            return gu::RecordSetOut<DataSet::RecordOut>::gather(out);
+        }
+
     private:
 
         // depending on version we may pack data differently
         DataSet::Version const version_;
+        const BaseName*        base_name_;
+        gu::Compression::Type  compression_;
+        size_t                 threshold_;
+        /* compressed replacement of this record set */
+        gu::RecordSetOut<DataSet::RecordOut>* packed_;
+        std::vector<gu::byte_t>               packed_buf_;
+
+        void pack();
 
         static gu::RecordSet::CheckType
-        check_type (DataSet::Version ver)
+        check_type (DataSet::Version ver, gu::RecordSet::Version const rsv)
         {
             switch (ver)
             {
             case DataSet::EMPTY: break; /* Can't create EMPTY DataSetOut */
-            case DataSet::VER1:  return gu::RecordSet::CHECK_MMH128;
+            case DataSet::VER1:
+            case DataSet::VER2:
+                return (rsv >= gu::RecordSet::VER3 ?
+                        gu::RecordSet::CHECK_CRC32C4 :
+                        gu::RecordSet::CHECK_MMH128);
             }
             throw;
         }
 
+        DataSetOut (const DataSetOut&);
+        DataSetOut& operator= (const DataSetOut&);
+
     }; /* class DataSetOut */
 
 
@@ -145,27 +236,39 @@ namespace galera
         DataSetIn (DataSet::Version ver, const gu::byte_t* buf, size_t size)
             :
             gu::RecordSetIn<DataSet::RecordIn>(buf, size, false),
-            version_(ver)
+            version_(ver),
+            plain_()
         {}
 
         DataSetIn () : gu::RecordSetIn<DataSet::RecordIn>(),
-                       version_(DataSet::EMPTY)
+                       version_(DataSet::EMPTY),
+                       plain_()
         {}
 
         void init (DataSet::Version ver, const gu::byte_t* buf, size_t size)
         {
             gu::RecordSetIn<DataSet::RecordIn>::init(buf, size, false);
             version_ = ver;
+            plain_.clear();
         }
 
         gu::Buf next () const
         {
-            return gu::RecordSetIn<DataSet::RecordIn>::next().buf();
+            gu::Buf const ret
+                (gu::RecordSetIn<DataSet::RecordIn>::next().buf());
+
+            if (version_ >= DataSet::VER2) return unpack(ret);
+
+            return ret;
         }
 
     private:
 
         DataSet::Version version_;
+        /* decompressed record, filled on first read */
+        std::vector<gu::byte_t> mutable plain_;
+
+        gu::Buf unpack (const gu::Buf& buf) const;
 
     }; /* class DataSetIn */
 
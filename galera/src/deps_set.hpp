@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+#ifndef GALERA_DEPS_SET_HPP
+#define GALERA_DEPS_SET_HPP
+
+#include "wsrep_api.h"
+
+#include <gu_deqmap.hpp>
+
+#include <cassert>
+
+namespace galera
+{
+    /*
+     * Multiset of last seen seqnos of write sets which are certified but not
+     * committed yet. Used by certification to find the lowest seqno which
+     * may still be referenced by uncommitted write sets.
+     *
+     * Last seen seqnos of write sets in certification are confined to
+     * the certification interval, so instead of a tree the set is a window
+     * of counters indexed by seqno. Insert and erase are constant time and
+     * the minimum is always at the window front, as counters which drop to
+     * zero at the front are trimmed.
+     */
+    class DepsSet
+    {
+    public:
+
+        DepsSet() : window_(0), size_(0) {}
+
+        void insert(wsrep_seqno_t const seqno)
+        {
+            Window::iterator const i(window_.find(seqno));
+
+            if (i != window_.end())
+            {
+                ++(*i); // holes are zero counters
+            }
+            else
+            {
+                window_.insert(seqno, 1);
+            }
+
+            ++size_;
+        }
+
+        /* Erases one instance of seqno which must be present in the set */
+        void erase(wsrep_seqno_t const seqno)
+        {
+            Window::iterator const i(window_.find(seqno));
+
+            assert(i != window_.end());
+            assert(!Window::not_set(*i));
+
+            if (1 == *i) window_.erase(seqno); else --(*i);
+
+            --size_;
+        }
+
+        /* The lowest seqno in the set, must not be empty */
+        wsrep_seqno_t min() const
+        {
+            assert(!empty());
+            return window_.index_front();
+        }
+
+        /* Number of seqnos in the set, including repeated */
+        size_t size()  const { return size_; }
+        bool   empty() const { return 0 == size_; }
+
+    private:
+
+        typedef gu::DeqMap<wsrep_seqno_t, size_t> Window;
+
+        Window window_;
+        size_t size_;
+    };
+}
+
+#endif // GALERA_DEPS_SET_HPP
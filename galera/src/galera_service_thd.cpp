@@ -6,12 +6,14 @@
  */
 
 #include "galera_service_thd.hpp"
+#include "certification.hpp"
 #include "gu_thread_keys.hpp"
 
 const uint32_t galera::ServiceThd::A_NONE = 0;
 
 static const uint32_t A_LAST_COMMITTED = 1U <<  0;
 static const uint32_t A_RELEASE_SEQNO  = 1U <<  1;
+static const uint32_t A_PURGE_CERT     = 1U <<  2;
 static const uint32_t A_FLUSH          = 1U << 30;
 static const uint32_t A_EXIT           = 1U << 31;
 
@@ -33,6 +35,8 @@ galera::ServiceThd::thd_func (void* arg)
             data = st->data_;
             st->data_.act_ = A_NONE; // clear pending actions
 
+            if (data.act_ & A_PURGE_CERT) st->purging_ = data.cert_;
+
             if (data.act_ & A_FLUSH)
             {
                 if (A_FLUSH == data.act_)
@@ -79,6 +83,32 @@ galera::ServiceThd::thd_func (void* arg)
                              << data.release_seqno_ << ": " << e.what();
                 }
             }
+
+            if (data.act_ & A_PURGE_CERT)
+            {
+                bool more(false);
+
+                try
+                {
+                    more = data.cert_->purge_step();
+                }
+                catch (std::exception& e)
+                {
+                    log_warn << "Exception purging certification index: "
+                             << e.what();
+                }
+
+                gu::Lock lock(st->mtx_);
+
+                st->purging_ = NULL;
+                st->flush_.broadcast(); // wake up purge_cert_cancel()
+
+                // continue unless cancelled meanwhile
+                if (more && st->data_.cert_ == data.cert_)
+                {
+                    st->data_.act_ |= A_PURGE_CERT;
+                }
+            }
         }
     }
 
@@ -92,7 +122,8 @@ galera::ServiceThd::ServiceThd (GcsI& gcs, gcache::GCache& gcache) :
     mtx_    (gu::get_mutex_key(gu::GU_MUTEX_KEY_SERVICE_THREAD)),
     cond_   (gu::get_cond_key(gu::GU_COND_KEY_SERVICE_THREAD)),
     flush_  (gu::get_cond_key(gu::GU_COND_KEY_SERVICE_THREAD_FLUSH)),
-    data_   ()
+    data_   (),
+    purging_(NULL)
 {
     gu_thread_create (gu::get_thread_key(gu::GU_THREAD_KEY_SERVICE), &thd_,
                       thd_func, this);
@@ -166,3 +197,29 @@ galera::ServiceThd::release_seqno(gcs_seqno_t seqno)
         data_.act_ |= A_RELEASE_SEQNO;
     }
 }
+
+void
+galera::ServiceThd::purge_cert(Certification& cert)
+{
+    gu::Lock lock(mtx_);
+
+    data_.cert_ = &cert;
+
+    if (data_.act_ == A_NONE) cond_.signal();
+
+    data_.act_ |= A_PURGE_CERT;
+}
+
+void
+galera::ServiceThd::purge_cert_cancel(const Certification& cert)
+{
+    gu::Lock lock(mtx_);
+
+    if (data_.cert_ == &cert)
+    {
+        data_.cert_ = NULL;
+        data_.act_ &= ~A_PURGE_CERT;
+    }
+
+    while (purging_ == &cert) lock.wait(flush_);
+}
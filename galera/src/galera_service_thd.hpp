@@ -12,6 +12,8 @@
 
 namespace galera
 {
+    class Certification;
+
     class ServiceThd
     {
     public:
@@ -41,6 +43,14 @@ namespace galera
         /*! release write sets up to and including seqno */
         void release_seqno (gcs_seqno_t seqno);
 
+        /*! schedule incremental purge of certification index, service
+         *  thread calls cert.purge_step() until it returns false */
+        void purge_cert (Certification& cert);
+
+        /*! cancel scheduled purge and wait for ongoing purge step to finish,
+         *  must be called without holding certification locks */
+        void purge_cert_cancel (const Certification& cert);
+
     private:
 
         static const uint32_t A_NONE;
@@ -49,11 +59,13 @@ namespace galera
         {
             gu::GTID    last_committed_;
             gcs_seqno_t release_seqno_;
+            Certification* cert_;
             uint32_t    act_;
 
             Data() :
                 last_committed_(),
                 release_seqno_ (0),
+                cert_          (NULL),
                 act_           (A_NONE)
             {}
         };
@@ -65,6 +77,7 @@ namespace galera
         gu::Cond        cond_;  // service request condition
         gu::Cond        flush_; // flush condition
         Data            data_;
+        const Certification* purging_; // purge step in progress
 
         static void* thd_func (void*);
 
@@ -685,9 +685,20 @@ void galera::ist::Sender::send(wsrep_seqno_t first, wsrep_seqno_t last,
                 std::min(static_cast<size_t>(last - first + 1),
                          static_cast<size_t>(1024)));
             ssize_t n_read;
+            gcache_.seqno_prefetch(first, buf_vec.size());
             while ((n_read = gcache_.seqno_get_buffers(buf_vec, first)) > 0)
             {
                 GU_DBUG_SYNC_WAIT("ist_sender_send_after_get_buffers");
+
+                // read the next batch in while this one is being sent
+                if (first + n_read <= last)
+                {
+                    gcache_.seqno_prefetch(
+                        first + n_read,
+                        std::min(static_cast<size_t>(last - first - n_read + 1),
+                                 buf_vec.size()));
+                }
+
                 //log_info << "read " << first << " + " << n_read
                 //         << " from gcache";
                 for (wsrep_seqno_t i(0); i < n_read; ++i)
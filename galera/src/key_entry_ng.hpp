@@ -8,6 +8,7 @@
 #include "trx_handle.hpp"
 
 #include <array>
+#include <cstring> // memcpy
 
 namespace galera
 {
@@ -19,8 +20,11 @@ namespace galera
 #ifndef NDEBUG
               seqnos_{0, 0, 0, 0},
 #endif // NDEBUG
-              key_(key)
+              key_(key),
+              hash_()
         {
+            assert(key_.hash_size() <= sizeof(hash_.buf));
+            ::memcpy(hash_.buf, key_.ptr(), key_.hash_size());
         }
 
         KeyEntryNG(const KeyEntryNG& other)
@@ -30,12 +34,22 @@ namespace galera
             seqnos_(other.seqnos_)
             ,
 #endif /* NDEBUG */
-            key_(other.key_)
+            key_(other.key_),
+            hash_(other.hash_)
         {
         }
 
         const KeySet::KeyPart& key() const { return key_; }
 
+        /* Matching and hashing use the copy of the key hash stored in the
+         * entry, so write set buffer pointed to by key() is not accessed. */
+        bool matches(const KeySet::KeyPart& kp) const
+        {
+            return KeySet::KeyPart(hash_.buf).matches(kp);
+        }
+
+        size_t hash() const { return KeySet::KeyPart(hash_.buf).hash(); }
+
         void ref(wsrep_key_type_t p, const KeySet::KeyPart& k,
                  TrxHandleSlave* trx)
         {
@@ -102,6 +116,7 @@ namespace galera
             std::swap(seqnos_, other.seqnos_);
 #endif /* NDEBUG */
             std::swap(key_,  other.key_);
+            std::swap(hash_, other.hash_);
         }
 
         KeyEntryNG& operator=(KeyEntryNG ke)
@@ -121,7 +136,7 @@ namespace galera
         std::array<wsrep_seqno_t, KeySet::Key::TYPE_MAX + 1> seqnos_;
 #endif // NDEBUG
         KeySet::KeyPart key_;
-
+        KeySet::KeyPart::HashData hash_;
     };
 
     inline void swap(KeyEntryNG& a, KeyEntryNG& b) { a.swap(b); }
@@ -131,7 +146,7 @@ namespace galera
     public:
         size_t operator()(const KeyEntryNG& ke) const
         {
-            return ke.key().hash();
+            return ke.hash();
         }
     };
 
@@ -140,7 +155,7 @@ namespace galera
     public:
         size_t operator()(const KeyEntryNG* const ke) const
         {
-            return ke->key().hash();
+            return ke->hash();
         }
     };
 
@@ -151,7 +166,7 @@ namespace galera
                         const KeyEntryNG& right)
             const
         {
-            return left.key().matches(right.key());
+            return left.matches(right.key());
         }
     };
 
@@ -162,7 +177,7 @@ namespace galera
                         const KeyEntryNG* const right)
             const
         {
-            return left->key().matches(right->key());
+            return left->matches(right->key());
         }
     };
 }
@@ -0,0 +1,164 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+#include "key_entry_table.hpp"
+
+#include <new>
+#include <cstring> // memset
+
+static galera::KeyEntryNG*
+allocate_slots(size_t const capacity)
+{
+    return static_cast<galera::KeyEntryNG*>(
+        ::operator new(capacity * sizeof(galera::KeyEntryNG)));
+}
+
+static gu::byte_t*
+allocate_ctrl(size_t const capacity, gu::byte_t const empty)
+{
+    gu::byte_t* const ret(new gu::byte_t[capacity]);
+    ::memset(ret, empty, capacity);
+    return ret;
+}
+
+galera::KeyEntryTable::KeyEntryTable()
+    :
+    ctrl_   (allocate_ctrl(MIN_CAPACITY, EMPTY)),
+    slots_  (allocate_slots(MIN_CAPACITY)),
+    mask_   (MIN_CAPACITY - 1),
+    size_   (0),
+    deleted_(0)
+{}
+
+galera::KeyEntryTable::~KeyEntryTable()
+{
+    clear();
+    delete[] ctrl_;
+    ::operator delete(slots_);
+}
+
+std::pair<galera::KeyEntryNG*, bool>
+galera::KeyEntryTable::insert(const KeySet::KeyPart& key)
+{
+    /* keep at least 1/8 of slots empty to terminate probing */
+    if (gu_unlikely((size_ + deleted_ + 1) * 8 > capacity() * 7))
+    {
+        /* grow only if live entries take more than half of the table,
+         * otherwise just drop deleted slots */
+        rehash((size_ + 1) * 2 > capacity() ? capacity() * 2 : capacity());
+    }
+
+    size_t const h(hash(key.hash()));
+    gu::byte_t const h2(ctrl_hash(h));
+    size_t pos(capacity()); // first deleted slot on the probe path
+
+    for (size_t i(h & mask_);; i = (i + 1) & mask_)
+    {
+        if (ctrl_[i] == h2 && slots_[i].matches(key))
+        {
+            return std::make_pair(&slots_[i], false);
+        }
+        else if (ctrl_[i] == DELETED)
+        {
+            if (pos == capacity()) pos = i;
+        }
+        else if (ctrl_[i] == EMPTY)
+        {
+            if (pos == capacity()) pos = i; else --deleted_;
+            break;
+        }
+    }
+
+    ctrl_[pos] = h2;
+    ++size_;
+
+    return std::make_pair(new (&slots_[pos]) KeyEntryNG(key), true);
+}
+
+void
+galera::KeyEntryTable::erase(KeyEntryNG* const ke)
+{
+    size_t const i(ke - slots_);
+
+    assert(i <= mask_);
+    assert(full(ctrl_[i]));
+
+    ke->~KeyEntryNG();
+
+    /* If the next slot is empty, no probe sequence continues past this
+     * slot and it can be marked empty right away. */
+    if (ctrl_[(i + 1) & mask_] == EMPTY)
+    {
+        ctrl_[i] = EMPTY;
+    }
+    else
+    {
+        ctrl_[i] = DELETED;
+        ++deleted_;
+    }
+
+    --size_;
+
+    /* shrink if less than 1/8 of slots is live, drop deleted slots if
+     * they take more than 1/4 of the table */
+    if (gu_unlikely((size_ * 8 < capacity() && capacity() > MIN_CAPACITY) ||
+                    deleted_ * 4 > capacity()))
+    {
+        rehash(shrink_capacity());
+    }
+}
+
+size_t
+galera::KeyEntryTable::shrink_capacity() const
+{
+    /* leave the table no more than 1/4 full, so that it neither grows nor
+     * shrinks again soon */
+    size_t ret(capacity());
+    while (ret > MIN_CAPACITY && (size_ + 1) * 8 <= ret) ret /= 2;
+    return ret;
+}
+
+void
+galera::KeyEntryTable::clear()
+{
+    for (size_t i(0); i <= mask_; ++i)
+    {
+        if (full(ctrl_[i])) slots_[i].~KeyEntryNG();
+    }
+
+    ::memset(ctrl_, EMPTY, capacity());
+    size_    = 0;
+    deleted_ = 0;
+}
+
+void
+galera::KeyEntryTable::rehash(size_t const capacity)
+{
+    gu::byte_t* const ctrl (allocate_ctrl(capacity, EMPTY));
+    KeyEntryNG* const slots(allocate_slots(capacity));
+    size_t      const mask (capacity - 1);
+
+    assert((capacity & mask) == 0);
+    assert(capacity > size_);
+
+    for (size_t i(0); i <= mask_; ++i)
+    {
+        if (!full(ctrl_[i])) continue;
+
+        size_t j(hash(slots_[i].hash()) & mask);
+        while (ctrl[j] != EMPTY) j = (j + 1) & mask;
+
+        ctrl[j] = ctrl_[i];
+        /* entries hold no resources, so the old copy is just abandoned */
+        new (&slots[j]) KeyEntryNG(slots_[i]);
+    }
+
+    delete[] ctrl_;
+    ::operator delete(slots_);
+
+    ctrl_    = ctrl;
+    slots_   = slots;
+    mask_    = mask;
+    deleted_ = 0;
+}
@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+#ifndef GALERA_KEY_ENTRY_TABLE_HPP
+#define GALERA_KEY_ENTRY_TABLE_HPP
+
+#include "key_entry_ng.hpp"
+
+#include <utility> // std::pair
+
+namespace galera
+{
+    /*
+     * Open addressing hash table of KeyEntryNG objects for certification
+     * index.
+     *
+     * Entries are stored inline in a flat slot array and probed linearly.
+     * A separate array of control bytes holds 7 bits of the key hash for
+     * every slot, so most mismatching slots are skipped without touching
+     * the entry itself, and matching compares the key hash copy stored in
+     * the entry instead of the write set buffer.
+     *
+     * Erased slots are only marked deleted and are reused by subsequent
+     * insertions or dropped on rehash, so erase is cheap. When erasures
+     * leave the table sparse or cluttered with deleted slots, it is rehashed
+     * to a smaller or the same capacity, so that a burst of keys does not
+     * keep the table at peak size and probing long forever.
+     *
+     * Entry pointers are invalidated by insertion and erasure.
+     */
+    class KeyEntryTable
+    {
+    public:
+
+        KeyEntryTable();
+        ~KeyEntryTable();
+
+        /* Returns pointer to the entry matching key or NULL */
+        KeyEntryNG* find(const KeySet::KeyPart& key) const
+        {
+            size_t const h(hash(key.hash()));
+            gu::byte_t const h2(ctrl_hash(h));
+
+            for (size_t i(h & mask_);; i = (i + 1) & mask_)
+            {
+                if (ctrl_[i] == h2 && slots_[i].matches(key))
+                {
+                    return &slots_[i];
+                }
+                else if (ctrl_[i] == EMPTY)
+                {
+                    return NULL;
+                }
+            }
+        }
+
+        /* Returns pointer to the entry matching key, inserting new entry
+         * if none was found. Second member is true if entry was inserted. */
+        std::pair<KeyEntryNG*, bool> insert(const KeySet::KeyPart& key);
+
+        /* Destroys unreferenced entry and marks its slot deleted. May shrink
+         * the table. */
+        void erase(KeyEntryNG* ke);
+
+        /* Calls f(const KeyEntryNG&) for every entry */
+        template <typename Func>
+        void for_each(Func f) const
+        {
+            for (size_t i(0); i <= mask_; ++i)
+            {
+                if (full(ctrl_[i])) f(slots_[i]);
+            }
+        }
+
+        /* Destroys all entries */
+        void clear();
+
+        size_t size()     const { return size_; }
+        bool   empty()    const { return size_ == 0; }
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+
+        KeyEntryTable(const KeyEntryTable&);
+        KeyEntryTable& operator=(const KeyEntryTable&);
+
+        static gu::byte_t const EMPTY   = 0x80;
+        static gu::byte_t const DELETED = 0xfe;
+
+        static size_t const MIN_CAPACITY = 16;
+
+        static bool full(gu::byte_t const c) { return (c & 0x80) == 0; }
+
+        /* Key part hash leaves upper bits zero and its lower bits select
+         * index shard, so it is mixed before use. */
+        static size_t hash(size_t const key_hash)
+        {
+            uint64_t h(key_hash);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        static gu::byte_t ctrl_hash(size_t const h)
+        {
+            return (h >> (GU_WORDSIZE - 7)) & 0x7f;
+        }
+
+        /* Capacity to shrink to after erasures, current capacity if
+         * the table should not shrink */
+        size_t shrink_capacity() const;
+
+        void rehash(size_t capacity);
+
+        gu::byte_t* ctrl_;
+        KeyEntryNG* slots_;
+        size_t      mask_;
+        size_t      size_;
+        size_t      deleted_;
+    };
+}
+
+#endif // GALERA_KEY_ENTRY_TABLE_HPP
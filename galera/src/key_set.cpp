@@ -1,5 +1,5 @@
 //
-// Copyright (C) 2013-2024 Codership Oy <info@codership.com>
+// Copyright (C) 2013-2026 Codership Oy <info@codership.com>
 //
 
 #include "key_set.hpp"
@@ -21,7 +21,8 @@ KeySet::throw_version(int ver)
 
 static const char* ver_str[KeySet::MAX_VERSION + 1] =
 {
-    "EMPTY", "FLAT8", "FLAT8A", "FLAT16", "FLAT16A"
+    "EMPTY", "FLAT8", "FLAT8A", "FLAT16", "FLAT16A",
+    "FLAT8X", "FLAT16X", "FLAT16XA"
 };
 
 KeySet::Version
@@ -238,14 +239,14 @@ KeySetOut::KeyPart::KeyPart (KeyParts&      added,
     own_  (false)
 {
     assert (ver_);
-    uint32_t const s(gu::htog(size_));
-    hash_.append (&s, sizeof(s));
-    hash_.append (value_, size_);
 
     KeySet::KeyPart::TmpStore ts;
     KeySet::KeyPart::HashData hd;
 
-    hash_.gather<sizeof(hd.buf)>(hd.buf);
+    if (KeySet::fast_hash(ver_))
+        hash_part<KeyHashXXH>(hd);
+    else
+        hash_part<KeyHashMMH>(hd);
 
     /* only leaf part of the key can be not of branch type */
     bool const leaf (part_num + 1 == kd.parts_num);
@@ -312,6 +313,26 @@ KeySetOut::KeyPart::print (std::ostream& os) const
     os << '(' << gu::Hexdump(value_, size_, true) << ')';
 }
 
+/* A few chains of key parts recently replaced in prev_. Keys interleaving
+ * between several tables (e.g. with foreign key checks) would otherwise
+ * rehash and look up schema and table parts every time. */
+class KeySetOut::PrefixCache
+{
+public:
+
+    static int const SIZE = 4;
+
+    PrefixCache() : next_(0) {}
+
+    std::vector<KeyPart> chain_[SIZE];
+    int                  next_; // round-robin replacement
+};
+
+KeySetOut::~KeySetOut()
+{
+    delete prefixes_;
+}
+
 /* Uncomment to enable KeySetOut::append() debug logging */
 // #define GALERA_KSO_APPEND_DEBUG 1
 #ifdef GALERA_KSO_APPEND_DEBUG
@@ -338,11 +359,83 @@ int KeySetOut::find_common_ancestor_with_previous(const KeyData& kd) const
     return i;
 }
 
+/* returns the number of leading parts of kd matching the chain */
+static int
+common_ancestor(const std::vector<KeySetOut::KeyPart>& chain,
+                const KeyData& kd)
+{
+    int i(0);
+    for (;
+         i < kd.parts_num &&
+             size_t(i + 1) < chain.size() &&
+             chain[i + 1].match(kd.parts[i].ptr, kd.parts[i].len);
+         ++i) {}
+    return i;
+}
+
+int
+KeySetOut::restore_prefix(const KeyData& kd, int const matched)
+{
+    if (!prefixes_) return matched;
+
+    int best(matched);
+    int best_chain(-1);
+
+    for (int c(0); c < PrefixCache::SIZE; ++c)
+    {
+        int const m(common_ancestor(prefixes_->chain_[c], kd));
+        if (m > best) { best = m; best_chain = c; }
+    }
+
+    if (best_chain < 0) return matched;
+
+    KSO_APPEND_DEBUG("Restoring prefix " << best_chain << " of length "
+                     << best);
+
+    /* swap with prev_ so that prev_ stays in the cache */
+    std::vector<KeyPart>& chain(prefixes_->chain_[best_chain]);
+    size_t const prev_size(prev_.size());
+    size_t const chain_size(chain.size());
+    size_t const n(std::max(prev_size, chain_size));
+
+    prev_().resize(n);
+    chain.resize(n);
+    for (size_t k(0); k < n; ++k) swap(prev_[k], chain[k]);
+    prev_().resize(chain_size);
+    chain.resize(prev_size);
+
+    return best;
+}
+
+void
+KeySetOut::stash_prefix(int const anc)
+{
+    /* nothing to save unless branch parts of prev_ are about to be replaced */
+    if (size_t(anc + 2) >= prev_.size()) return;
+
+    if (!prefixes_) prefixes_ = new PrefixCache;
+
+    std::vector<KeyPart>& chain(prefixes_->chain_[prefixes_->next_]);
+    prefixes_->next_ = (prefixes_->next_ + 1) % PrefixCache::SIZE;
+
+    chain.resize(prev_.size());
+    for (size_t k(0); k < chain.size(); ++k) chain[k].clone(prev_[k]);
+}
+
 size_t
 KeySetOut::append (const KeyData& kd)
 {
     int i = find_common_ancestor_with_previous(kd);
 
+    /* branch parts don't match prev_, try recently used prefixes */
+    bool restored(false);
+    if (i + 1 < kd.parts_num)
+    {
+        int const r(restore_prefix(kd, i));
+        restored = (r != i);
+        i = r;
+    }
+
     KSO_APPEND_DEBUG("Append " << kd);
     /* if we have a fully matched key OR common ancestor is stronger, return */
     if (i > 0)
@@ -426,6 +519,8 @@ KeySetOut::append (const KeyData& kd)
     assert (i == kd.parts_num);
     assert (anc + j == kd.parts_num);
 
+    if (!restored) stash_prefix(anc);
+
     /* copy new parts to prev_ */
     prev_().resize(1 + kd.parts_num);
     std::copy(new_().begin(), new_().begin() + j, prev_().begin() + anc + 1);
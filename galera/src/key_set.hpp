@@ -1,5 +1,5 @@
 //
-// Copyright (C) 2013-2018 Codership Oy <info@codership.com>
+// Copyright (C) 2013-2026 Codership Oy <info@codership.com>
 //
 
 
@@ -7,6 +7,7 @@
 #define GALERA_KEY_SET_HPP
 
 #include "gu_rset.hpp"
+#include "gu_xxh3.h"
 #include "gu_unordered.hpp"
 #include "gu_logger.hpp"
 #include "gu_hexdump.hpp"
@@ -31,9 +32,39 @@ public:
         FLAT16,   /* 16-byte hash (flat) */
         FLAT16A,  /* 16-byte hash (flat), annotated */
 //      TREE8,    /*  8-byte hash + full serialized key */
-        MAX_VERSION = FLAT16A
+        FLAT8X,   /*  8-byte fast hash (flat) */
+        FLAT16X,  /* 16-byte fast hash (flat) */
+        FLAT16XA, /* 16-byte fast hash (flat), annotated */
+        MAX_VERSION = FLAT16XA
     };
 
+    /* Versions FLAT8X and up hash key parts with XXH3-128 instead of MMH3.
+     * Keys hashed by different functions never match, so the versions of the
+     * two families can't be mixed in certification, see
+     * Certification::do_test() */
+    static bool fast_hash (Version const ver) { return (ver >= FLAT8X); }
+
+    /* Maps version to its counterpart in the requested hash family.
+     * There is no 8-byte annotated fast version, FLAT16XA is used instead. */
+    static Version version (Version const ver, bool const fast)
+    {
+        if (fast_hash(ver) == fast) return ver;
+
+        switch (ver)
+        {
+        case FLAT8:    return FLAT8X;
+        case FLAT8A:   return FLAT16XA;
+        case FLAT16:   return FLAT16X;
+        case FLAT16A:  return FLAT16XA;
+        case FLAT8X:   return FLAT8;
+        case FLAT16X:  return FLAT16;
+        case FLAT16XA: return FLAT16A;
+        case EMPTY:    break;
+        }
+
+        return ver;
+    }
+
     static Version version (unsigned int ver)
     {
         if (gu_likely (ver <= MAX_VERSION)) return static_cast<Version>(ver);
@@ -86,9 +117,7 @@ public:
         {
             assert(ver > EMPTY && ver <= MAX_VERSION);
 
-            /* 16 if ver in { FLAT16, FLAT16A }, 8 otherwise */
-            int const key_size
-                (8 << (static_cast<unsigned int>(ver - FLAT16) <= 1));
+            int const key_size(base_size(ver, NULL, 0));
 
             assert((key_size % alignment) == 0);
             assert((uintptr_t(tmp.buf)  % GU_WORD_BYTES) == 0);
@@ -219,21 +248,27 @@ public:
             const uint32_t* rhs(reinterpret_cast<const uint32_t*>(kp.data_));
 #endif /* WORDSIZE */
 
-            switch (std::min(version(), kp.version()))
+            if (gu_unlikely(EMPTY == version() || EMPTY == kp.version()))
             {
-            case EMPTY:
                 assert(0);
                 throw_match_empty_key(version(), kp.version());
-            case FLAT16:
-            case FLAT16A:
+            }
+
+            /* hashes of different functions are not comparable */
+            if (KeySet::fast_hash(version()) != KeySet::fast_hash(kp.version()))
+                return false;
+
+            switch (std::min(base_size(version(),    data_,    -1U),
+                             base_size(kp.version(), kp.data_, -1U)))
+            {
+            case 16:
 #if GU_WORDSIZE == 64
                 ret = (lhs[1] == rhs[1]);
 #else
                 ret = (lhs[2] == rhs[2] && lhs[3] == rhs[3]);
 #endif /* WORDSIZE */
                 /* fall through */
-            case FLAT8:
-            case FLAT8A:
+            case 8:
                 /* shift is to clear up the header */
 #if GU_WORDSIZE == 64
                 ret = ret && ((gtoh64(lhs[0]) >> HEADER_BITS) ==
@@ -270,6 +305,10 @@ public:
         size_t
         serial_size () const { return KeyPart::serial_size(data_, -1U); }
 
+        /* size of the key hash with header, without annotation */
+        size_t
+        hash_size () const { return base_size(version(), data_, -1U); }
+
         void
         print (std::ostream& os) const;
 
@@ -316,9 +355,12 @@ public:
             {
             case FLAT16:
             case FLAT16A:
+            case FLAT16X:
+            case FLAT16XA:
                 return 16;
             case FLAT8:
             case FLAT8A:
+            case FLAT8X:
                 return 8;
             case EMPTY: assert(0);
             }
@@ -329,7 +371,7 @@ public:
         static bool
         annotated (Version const ver)
         {
-            return (ver == FLAT16A || ver == FLAT8A);
+            return (ver == FLAT16A || ver == FLAT8A || ver == FLAT16XA);
         }
 
         typedef uint16_t ann_size_t;
@@ -566,6 +608,60 @@ public:
     };
 #endif /* 1 */
 
+    /* Running hash of the key parts from the root down to the current one.
+     * Each key part hash covers the whole key prefix, so that the leaf hash
+     * identifies the complete key. */
+    union KeyHash
+    {
+        gu_mmh128_ctx_t mmh;
+        uint64_t        xxh[2];
+    };
+
+    /* Key hash policies. Both hash the part size along with the value,
+     * so that a/bc and ab/c result in different hashes. */
+
+    /* MMH3 with a streaming context, KeySet versions FLAT8 - FLAT16A */
+    struct KeyHashMMH
+    {
+        static void init(KeyHash& h) { gu_mmh128_init(&h.mmh); }
+
+        static void append(KeyHash& h, const void* const v, size_t const s)
+        {
+            uint32_t const ss(gu::htog(uint32_t(s)));
+            gu_mmh128_append(&h.mmh, &ss, sizeof(ss));
+            gu_mmh128_append(&h.mmh, v, s);
+        }
+
+        static void gather(const KeyHash& h, KeySet::KeyPart::HashData& hd)
+        {
+            gu_mmh128_get(&h.mmh, hd.buf);
+        }
+    };
+
+    /* XXH3-128 seeded with the folded hash of the parent part, versions
+     * FLAT8X+. Root part is hashed with the default seed. Short key parts
+     * take a few multiplications and no context copying. */
+    struct KeyHashXXH
+    {
+        static void init(KeyHash& h)
+        {
+            h.xxh[0] = 0;
+            h.xxh[1] = 0;
+        }
+
+        static void append(KeyHash& h, const void* const v, size_t const s)
+        {
+            // s is mixed in by XXH3
+            gu_xxh3_128_seeded(v, s, h.xxh[0] ^ h.xxh[1], h.xxh);
+        }
+
+        static void gather(const KeyHash& h, KeySet::KeyPart::HashData& hd)
+        {
+            uint64_t const res[2] = { gu_le64(h.xxh[0]), gu_le64(h.xxh[1]) };
+            ::memcpy(hd.buf, res, sizeof(res));
+        }
+    };
+
     class KeyPart
     {
     public:
@@ -580,6 +676,10 @@ public:
             own_  (false)
         {
             assert (ver_);
+            if (KeySet::fast_hash(ver_))
+                KeyHashXXH::init(hash_);
+            else
+                KeyHashMMH::init(hash_);
         }
 
         /* to throw in KeyPart() ctor in case it is a duplicate */
@@ -650,6 +750,20 @@ public:
             own_ = false;
         }
 
+        /* unlike copy ctor, makes a copy of k value instead of taking it
+         * over, so that both objects can be used independently */
+        void
+        clone(const KeyPart& k)
+        {
+            release();
+            hash_  = k.hash_;
+            part_  = k.part_;
+            value_ = k.value_;
+            size_  = k.size_;
+            ver_   = k.ver_;
+            acquire();
+        }
+
         ~KeyPart() { release(); }
 
         void
@@ -659,7 +773,14 @@ public:
 
     private:
 
-        gu::Hash          hash_;
+        template <class H> void
+        hash_part (KeySet::KeyPart::HashData& hd)
+        {
+            H::append(hash_, value_, size_);
+            H::gather(hash_, hd);
+        }
+
+        KeyHash           hash_;
         const KeySet::KeyPart* part_;
         mutable
         const gu::byte_t* value_;
@@ -677,6 +798,7 @@ public:
         added_(),
         prev_ (),
         new_  (),
+        prefixes_(NULL),
         version_()
     {}
 
@@ -691,12 +813,13 @@ public:
             reserved,
             reserved_size,
             base_name,
-            check_type(version),
+            check_type(version, rsv),
             rsv
             ),
         added_(),
         prev_ (),
         new_  (),
+        prefixes_(NULL),
         version_(version),
         ws_ver_(ws_ver)
     {
@@ -707,7 +830,7 @@ public:
         prev_().push_back(zero);
     }
 
-    ~KeySetOut () {}
+    ~KeySetOut ();
 
     size_t
     append (const KeyData& kd);
@@ -721,17 +844,23 @@ private:
     KeyParts              added_;
     gu::Vector<KeyPart,5> prev_;
     gu::Vector<KeyPart,5> new_;
+    class PrefixCache;
+    PrefixCache*          prefixes_; // allocated on first use
     KeySet::Version       version_;
     int                   ws_ver_;
 
     int find_common_ancestor_with_previous(const KeyData&) const;
+    int restore_prefix(const KeyData&, int matched);
+    void stash_prefix(int anc);
     static gu::RecordSet::CheckType
-    check_type (KeySet::Version ver)
+    check_type (KeySet::Version ver, gu::RecordSet::Version const rsv)
     {
         switch (ver)
         {
         case KeySet::EMPTY: break; /* Can't create EMPTY KeySetOut */
-        default: return gu::RecordSet::CHECK_MMH128;
+        default: return (rsv >= gu::RecordSet::VER3 ?
+                         gu::RecordSet::CHECK_CRC32C4 :
+                         gu::RecordSet::CHECK_MMH128);
         }
 
         KeySet::throw_version(ver);
@@ -769,6 +898,9 @@ public:
     KeySet::KeyPart const
     next () const { return gu::RecordSetIn<KeySet::KeyPart>::next(); }
 
+    KeySet::Version
+    version () const { return version_; }
+
 private:
 
     KeySet::Version version_;
@@ -8,8 +8,10 @@
 #include "trx_handle.hpp"
 #include <gu_lock.hpp> // for gu::Mutex and gu::Cond
 #include <gu_limits.h>
+#include <gu_atomic.h>
 #include "gu_thread_keys.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -27,6 +29,9 @@ namespace galera
                 , cond_()
                 , wait_cond_()
                 , state_(S_IDLE)
+                , waiters_head_(WSREP_SEQNO_UNDEFINED)
+                , waiters_next_(WSREP_SEQNO_UNDEFINED)
+                , waiting_for_(WSREP_SEQNO_UNDEFINED)
 #ifndef NDEBUG
                 , dobj_()
 #endif /* NDEBUG */
@@ -43,6 +48,14 @@ namespace galera
                 S_APPLYING, // Applying
                 S_FINISHED  // Finished
             } state_;
+            // Objects waiting to enter are queued on the slot of the seqno
+            // they wait for to leave (see C::wait_seqno()) and are woken up
+            // when it does, instead of checking all waiting slots on every
+            // leave. The queue is linked by seqnos, so it stays valid when
+            // the window is grown.
+            wsrep_seqno_t waiters_head_; // first object waiting for this slot
+            wsrep_seqno_t waiters_next_; // next object in the same queue
+            wsrep_seqno_t waiting_for_;  // slot this object is queued on
 #ifndef NDEBUG
             C dobj_;
 #endif /* NDEBUG */
@@ -77,11 +90,44 @@ namespace galera
             void operator=(const Process&);
         };
 
-        static const ssize_t process_size_ = (1ULL << 16);
-        static const size_t  process_mask_ = process_size_ - 1;
     public:
 
-        Monitor(enum gu::MutexKey mutex_key, enum gu::CondKey cond_key)
+        static const ssize_t default_size = (1ULL << 16);
+        // the process window grows up to this many slots
+        static const ssize_t max_size     = (1ULL << 24);
+
+    private:
+
+        static ssize_t check_size(ssize_t const size)
+        {
+            if (size > max_size)
+            {
+                gu_throw_error(EINVAL) << "Bad monitor process window size '"
+                                       << size << "': must not exceed "
+                                       << max_size;
+            }
+            return size;
+        }
+
+        static ssize_t window_size(ssize_t const size)
+        {
+            ssize_t ret(1);
+            while (ret < size && ret < max_size) ret <<= 1;
+            return ret;
+        }
+
+    public:
+
+        /*
+         * @param size initial number of slots in the process window, rounded
+         *             up to a power of 2, at most max_size. The window is
+         *             grown as needed when seqnos further than that from last
+         *             left are entered, and shrunk back when they have left.
+         * @param group_stats collect group size metric, see start_group()
+         */
+        Monitor(enum gu::MutexKey mutex_key, enum gu::CondKey cond_key,
+                ssize_t const size = default_size,
+                bool const group_stats = false)
             :
             mutex_(gu::get_mutex_key(mutex_key)),
             cond_key_(cond_key),
@@ -89,13 +135,23 @@ namespace galera
             uuid_(WSREP_UUID_UNDEFINED),
             last_entered_(-1),
             last_left_(-1),
+            last_canceled_(-1),
             drain_seqno_(GU_LLONG_MAX),
+            min_size_(window_size(check_size(size))),
+            process_size_(min_size_),
+            process_mask_(process_size_ - 1),
             process_(new Process[process_size_]),
             entered_(0),
             oooe_(0),
             oool_(0),
             win_size_(0),
-            waits_(0)
+            waits_(0),
+            deps_waiters_(0),
+            group_stats_(group_stats),
+            group_end_(-1),
+            groups_(0),
+            grouped_(0),
+            win_max_(0)
         { }
 
         ~Monitor()
@@ -126,6 +182,10 @@ namespace galera
 
             state_debug_print("set_initial_position", seqno);
             uuid_ = uuid;
+
+            wsrep_seqno_t const prev_left(last_left_);
+            wsrep_seqno_t const prev_entered(last_entered_);
+            wsrep_seqno_t const prev_canceled(last_canceled_);
             // When the monitor position is reset, either all the
             // waiters must have been drained or the thread which is
             // resetting the position must hold the monitor (CC from IST).
@@ -136,13 +196,26 @@ namespace galera
             if (last_entered_ == -1 || seqno == -1)
             {
                 // first call or reset
-                last_entered_ = last_left_ = seqno;
+                set_last_entered(seqno);
+                set_last_left(seqno);
+                last_canceled_ = seqno;
+                group_end_ = seqno;
+
+                // nothing has entered canceled slots above last entered,
+                // forget them together with the old position
+                for (wsrep_seqno_t i(std::max(prev_left, prev_entered) + 1);
+                     i <= prev_canceled; ++i)
+                {
+                    Process& a(process_[indexof(i)]);
+                    if (a.state_ == Process::S_CANCELED)
+                        a.state_ = Process::S_IDLE;
+                }
             }
             else
 #if 1 // now
             {
-                if (last_left_    < seqno)      last_left_    = seqno;
-                if (last_entered_ < last_left_) last_entered_ = last_left_;
+                if (last_left_    < seqno)      set_last_left(seqno);
+                if (last_entered_ < last_left_) set_last_entered(last_left_);
             }
 
             // some drainers may wait for us here
@@ -160,12 +233,17 @@ namespace galera
                 const size_t idx(indexof(seqno));
                 process_[idx].wake_up_waiters(lock);
             }
+
+            // objects queued on the slots which were skipped
+            for (wsrep_seqno_t i(prev_left + 1); i <= prev_entered; ++i)
+            {
+                wake_up_queued(i);
+            }
         }
 
         void enter(C& obj)
         {
             const wsrep_seqno_t obj_seqno(obj.seqno());
-            const size_t        idx(indexof(obj_seqno));
             gu::Lock            lock(mutex_);
 
             state_debug_print("enter", obj);
@@ -173,28 +251,43 @@ namespace galera
 
             pre_enter(obj, lock);
 
+            // slot index changes if the window is grown while waiting
+            size_t idx(indexof(obj_seqno));
+
             if (gu_likely(process_[idx].state_ != Process::S_CANCELED))
             {
                 assert(process_[idx].state_ == Process::S_IDLE);
 
                 process_[idx].state_ = Process::S_WAITING;
                 process_[idx].obj_   = &obj;
+
+                // objects with exact dependencies may enter out of order
+                // and are checked on every leave, see wake_up_next()
+                bool const has_deps(obj.deps() != NULL);
+                deps_waiters_ += has_deps;
 #ifndef NDEBUG
                 process_[idx].dobj_.~C();
                 new (&process_[idx].dobj_) C(obj);
 #endif /* NDEBUG */
 #ifdef GU_DBUG_ON
                 obj.debug_sync(mutex_);
+                idx = indexof(obj_seqno);
 #endif // GU_DBUG_ON
                 while (may_enter(obj) == false &&
                        process_[idx].state_ == Process::S_WAITING)
                 {
                     process_[idx].cond_ = obj.cond();
+                    if (!has_deps) queue_waiter(obj, idx);
                     ++waits_;
-                    lock.wait(*process_[idx].cond_);
+                    lock.wait(*obj.cond());
+                    idx = indexof(obj_seqno);
                     process_[idx].cond_ = 0;
                 }
 
+                // still queued if canceled
+                dequeue_waiter(obj_seqno);
+                deps_waiters_ -= has_deps;
+
                 if (process_[idx].state_ != Process::S_CANCELED)
                 {
                     assert(process_[idx].state_ == Process::S_WAITING ||
@@ -233,11 +326,12 @@ namespace galera
 
         void leave(const C& obj)
         {
-#ifndef NDEBUG
-            size_t   idx(indexof(obj.seqno()));
-#endif /* NDEBUG */
             gu::Lock lock(mutex_);
             state_debug_print("leave", obj);
+#ifndef NDEBUG
+            // process_mask_ changes on resize, so index under the lock
+            size_t const idx(indexof(obj.seqno()));
+#endif /* NDEBUG */
 
             assert(process_[idx].state_ == Process::S_APPLYING ||
                    process_[idx].state_ == Process::S_CANCELED);
@@ -250,13 +344,14 @@ namespace galera
         void self_cancel(C& obj)
         {
             wsrep_seqno_t const obj_seqno(obj.seqno());
-            size_t   idx(indexof(obj_seqno));
             gu::Lock lock(mutex_);
 
             state_debug_print("self_cancel", obj);
 
             assert(obj_seqno > last_left_);
 
+            grow(obj_seqno);
+
             while (obj_seqno - last_left_ >= process_size_)
                 // TODO: exit on error
             {
@@ -268,8 +363,12 @@ namespace galera
                          << ". Deadlock is very likely.";
 
                 lock.wait(cond_);
+                grow(obj_seqno);
             }
 
+            size_t const idx(indexof(obj_seqno));
+            update_win_max(obj_seqno);
+
             assert(process_[idx].state_ == Process::S_IDLE ||
                    process_[idx].state_ == Process::S_CANCELED);
 
@@ -278,7 +377,7 @@ namespace galera
             new (&process_[idx].dobj_) C(obj);
 #endif /* NDEBUG */
 
-            if (obj_seqno > last_entered_) last_entered_ = obj_seqno;
+            if (obj_seqno > last_entered_) set_last_entered(obj_seqno);
 
             if (obj_seqno <= drain_seqno_)
             {
@@ -292,15 +391,19 @@ namespace galera
 
         bool interrupt(const C& obj)
         {
-            size_t   idx (indexof(obj.seqno()));
             gu::Lock lock(mutex_);
 
+            grow(obj.seqno());
+
             while (obj.seqno() - last_left_ >= process_size_)
                 // TODO: exit on error
             {
                 lock.wait(cond_);
+                grow(obj.seqno());
             }
 
+            size_t const idx(indexof(obj.seqno()));
+
             state_debug_print("interrupt", obj);
 
             if ((process_[idx].state_ == Process::S_IDLE &&
@@ -308,6 +411,7 @@ namespace galera
                 process_[idx].state_ == Process::S_WAITING )
             {
                 process_[idx].state_ = Process::S_CANCELED;
+                if (obj.seqno() > last_canceled_) last_canceled_ = obj.seqno();
                 if (process_[idx].cond_)
                 {
                     process_[idx].cond_->signal();
@@ -327,16 +431,19 @@ namespace galera
             return false;
         }
 
+        // position getters don't take the mutex, see set_last_left()
         wsrep_seqno_t last_left() const
         {
-            gu::Lock lock(mutex_);
-            return last_left_;
+            wsrep_seqno_t ret;
+            gu_atomic_get(&last_left_, &ret);
+            return ret;
         }
 
         wsrep_seqno_t last_entered() const
         {
-            gu::Lock lock(mutex_);
-            return last_entered_;
+            wsrep_seqno_t ret;
+            gu_atomic_get(&last_entered_, &ret);
+            return ret;
         }
 
         void last_left_gtid(wsrep_gtid_t& gtid) const
@@ -346,12 +453,21 @@ namespace galera
             gtid.seqno = last_left_;
         }
 
-        ssize_t       size()        const { return process_size_; }
+        ssize_t size() const
+        {
+            gu::Lock lock(mutex_);
+            return process_size_;
+        }
 
-        bool would_block (wsrep_seqno_t seqno) const
+        /*
+         * Returns true if seqno does not fit in the process window even
+         * grown to max_size, so entering the monitor would have to wait for
+         * the preceding seqnos to leave.
+         */
+        bool would_overflow(wsrep_seqno_t const seqno) const
         {
-            return (seqno - last_left_ >= process_size_ ||
-                    seqno > drain_seqno_);
+            gu::Lock lock(mutex_);
+            return (seqno - last_left_ >= max_size);
         }
 
         void drain(wsrep_seqno_t seqno)
@@ -418,10 +534,26 @@ namespace galera
             *waits = waits_;
         }
 
+        /* Largest number of slots occupied in the process window since
+         * the last flush_stats() */
+        wsrep_seqno_t window_max() const
+        {
+            gu::Lock lock(mutex_);
+            return win_max_;
+        }
+
+        /* Average number of objects in a group, see start_group() */
+        double group_size() const
+        {
+            gu::Lock lock(mutex_);
+            return (groups_ > 0 ? double(grouped_)/groups_ : .0);
+        }
+
         void flush_stats()
         {
             gu::Lock lock(mutex_);
             oooe_ = 0; oool_ = 0; win_size_ = 0; entered_ = 0; waits_ = 0;
+            groups_ = 0; grouped_ = 0; win_max_ = 0;
         }
 
     private:
@@ -441,9 +573,140 @@ namespace galera
             return (seqno & process_mask_);
         }
 
+        // Position is modified only under mutex_, but is stored atomically,
+        // so that last_left() and last_entered() may be called by
+        // replication threads without contending with appliers for the lock.
+        void set_last_left(wsrep_seqno_t const seqno)
+        {
+            gu_atomic_set(&last_left_, &seqno);
+        }
+
+        void set_last_entered(wsrep_seqno_t const seqno)
+        {
+            gu_atomic_set(&last_entered_, &seqno);
+        }
+
+        void update_win_max(wsrep_seqno_t const seqno)
+        {
+            if (seqno - last_left_ > win_max_) win_max_ = seqno - last_left_;
+        }
+
+        /*
+         * Grows the process window, if needed and possible, so that seqno
+         * fits in it instead of waiting for the window to shrink.
+         */
+        void grow(wsrep_seqno_t const seqno)
+        {
+            if (gu_likely(seqno - last_left_ < process_size_)) return;
+
+            ssize_t const size(window_size(seqno - last_left_ + 1));
+
+            if (size <= process_size_) return; // reached max_size
+
+            log_info << "Growing monitor process window from "
+                     << process_size_ << " to " << size << " slots";
+
+            resize(size);
+        }
+
+        /*
+         * Shrinks the grown process window by half towards the configured
+         * size when the occupied part falls below a quarter of it, so that
+         * it is not grown right back.
+         */
+        void shrink()
+        {
+            if (gu_likely(process_size_ == min_size_) ||
+                std::max(last_entered_, last_canceled_) - last_left_ >=
+                process_size_ / 4) return;
+
+            ssize_t const size(process_size_ / 2);
+
+            log_info << "Shrinking monitor process window from "
+                     << process_size_ << " to " << size << " slots";
+
+            resize(size);
+        }
+
+        /*
+         * Slots of the current window which fit in the new one are moved to
+         * their new positions, those waiting in wait() are woken up to
+         * requeue on the new slots. Objects waiting in the monitor find their
+         * slots by seqno after every wakeup.
+         */
+        void resize(ssize_t const size)
+        {
+            assert(std::max(last_entered_, last_canceled_) - last_left_ < size);
+
+            Process* const process(new Process[size]);
+            size_t   const mask(size - 1);
+
+            for (ssize_t i(0); i < process_size_; ++i)
+            {
+                wsrep_seqno_t const seqno_i(last_left_ + i);
+                Process& from(process_[indexof(seqno_i)]);
+
+                if (from.wait_cond_) from.wait_cond_->broadcast();
+
+                if (i >= size)
+                {
+                    // nothing beyond last entered or canceled to move
+                    assert(Process::S_IDLE == from.state_);
+                    assert(WSREP_SEQNO_UNDEFINED == from.waiters_head_);
+                    continue;
+                }
+
+                Process& to(process[seqno_i & mask]);
+
+                to.obj_          = from.obj_;
+                to.cond_         = from.cond_;
+                to.state_        = from.state_;
+                to.waiters_head_ = from.waiters_head_;
+                to.waiters_next_ = from.waiters_next_;
+                to.waiting_for_  = from.waiting_for_;
+#ifndef NDEBUG
+                to.dobj_.~C();
+                new (&to.dobj_) C(from.dobj_);
+#endif /* NDEBUG */
+            }
+
+            delete[] process_;
+            process_      = process;
+            process_size_ = size;
+            process_mask_ = mask;
+        }
+
         bool may_enter(const C& obj) const
         {
-            return obj.condition(last_entered_, last_left_);
+            return obj.condition(last_entered_, last_left_) &&
+                deps_left(obj.deps());
+        }
+
+        // true if all exact dependencies of the object have left the monitor,
+        // possibly out of order
+        bool deps_left(const TrxHandleSlave::Deps* const deps) const
+        {
+            if (deps)
+            {
+                for (TrxHandleSlave::Deps::const_iterator i(deps->begin());
+                     i != deps->end(); ++i)
+                {
+                    if (*i > last_left_ &&
+                        process_[indexof(*i)].state_ != Process::S_FINISHED)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // must be called with mutex_ locked
+        bool would_block (wsrep_seqno_t seqno) const
+        {
+            return (seqno - last_left_ >= process_size_ ||
+                    seqno > drain_seqno_);
         }
 
         // wait until it is possible to grab slot in monitor,
@@ -454,12 +717,17 @@ namespace galera
 
             const wsrep_seqno_t obj_seqno(obj.seqno());
 
+            grow(obj_seqno);
+
             while (would_block (obj_seqno)) // TODO: exit on error
             {
                 lock.wait(cond_);
+                grow(obj_seqno); // could have been shrunk meanwhile
             }
 
-            if (last_entered_ < obj_seqno) last_entered_ = obj_seqno;
+            update_win_max(obj_seqno);
+
+            if (last_entered_ < obj_seqno) set_last_entered(obj_seqno);
         }
 
         void update_last_left(gu::Lock& lock)
@@ -471,8 +739,9 @@ namespace galera
                 if (Process::S_FINISHED == a.state_)
                 {
                     a.state_   = Process::S_IDLE;
-                    last_left_ = i;
+                    set_last_left(i);
                     a.wake_up_waiters(lock);
+                    wake_up_queued(i);
                 }
                 else
                 {
@@ -482,25 +751,128 @@ namespace galera
             assert(last_left_ <= last_entered_);
         }
 
-        void wake_up_next()
+        // Lets the waiting object in. We need to set state to APPLYING
+        // here because if it is the last_left_ + 1 and it gets canceled in
+        // the race that follows, there will be nobody to clean up and
+        // advance last_left_.
+        static void let_in(Process& a)
         {
-            for (wsrep_seqno_t i = last_left_ + 1; i <= last_entered_; ++i)
+            a.state_ = Process::S_APPLYING;
+            if (a.cond_)
             {
-                Process& a(process_[indexof(i)]);
-                if (a.state_           == Process::S_WAITING &&
-                    may_enter(*a.obj_) == true)
+                a.cond_->signal();
+            }
+        }
+
+        // Queues waiting object on the slot of the seqno it waits for
+        void queue_waiter(const C& obj, size_t const idx)
+        {
+            Process& a(process_[idx]);
+            wsrep_seqno_t const wait_seqno(obj.wait_seqno());
+
+            assert(wait_seqno < obj.seqno());
+
+            if (a.waiting_for_ != WSREP_SEQNO_UNDEFINED || // already queued
+                wait_seqno <= last_left_) return;
+
+            Process& w(process_[indexof(wait_seqno)]);
+
+            a.waiting_for_  = wait_seqno;
+            a.waiters_next_ = w.waiters_head_;
+            w.waiters_head_ = obj.seqno();
+        }
+
+        void dequeue_waiter(wsrep_seqno_t const seqno)
+        {
+            Process& a(process_[indexof(seqno)]);
+
+            if (a.waiting_for_ == WSREP_SEQNO_UNDEFINED) return;
+
+            wsrep_seqno_t* next(
+                &process_[indexof(a.waiting_for_)].waiters_head_);
+
+            while (*next != seqno)
+            {
+                assert(*next != WSREP_SEQNO_UNDEFINED);
+                next = &process_[indexof(*next)].waiters_next_;
+            }
+
+            *next = a.waiters_next_;
+            a.waiters_next_ = WSREP_SEQNO_UNDEFINED;
+            a.waiting_for_  = WSREP_SEQNO_UNDEFINED;
+        }
+
+        // Wakes up objects queued on the slot of seqno which has just left
+        void wake_up_queued(wsrep_seqno_t const seqno)
+        {
+            Process& w(process_[indexof(seqno)]);
+
+            while (w.waiters_head_ != WSREP_SEQNO_UNDEFINED)
+            {
+                Process& a(process_[indexof(w.waiters_head_)]);
+
+                assert(a.waiting_for_ == seqno);
+                w.waiters_head_ = a.waiters_next_;
+                a.waiters_next_ = WSREP_SEQNO_UNDEFINED;
+                a.waiting_for_  = WSREP_SEQNO_UNDEFINED;
+
+                if (a.state_ == Process::S_WAITING && may_enter(*a.obj_))
                 {
-                    // We need to set state to APPLYING here because if
-                    // it is  the last_left_ + 1 and it gets canceled in
-                    // the race  that follows exit from this function,
-                    // there will be  nobody to clean up and advance
-                    // last_left_.
-                    a.state_ = Process::S_APPLYING;
-                    if (a.cond_)
-                    {
-                        a.cond_->signal();
-                    }
+                    let_in(a);
                 }
+                else if (a.cond_)
+                {
+                    a.cond_->signal(); // let it requeue
+                }
+            }
+        }
+
+        // Objects with exact dependencies are not queued, as they may enter
+        // on out of order leave too: check those in the window.
+        void wake_up_next()
+        {
+            long seen(0);
+
+            for (wsrep_seqno_t i = last_left_ + 1;
+                 seen < deps_waiters_ && i <= last_entered_; ++i)
+            {
+                Process& a(process_[indexof(i)]);
+
+                if (a.state_ != Process::S_WAITING || !a.obj_->deps())
+                    continue;
+
+                ++seen;
+
+                if (may_enter(*a.obj_) == true) let_in(a);
+            }
+        }
+
+        /*
+         * Group size metric. When the previous group has left in order,
+         * objects already waiting right after last_left_ form the next group:
+         * in an in-order monitor (NO_OOOC commit order) they are let in one
+         * by one without waiting for anything else, so e.g. the application
+         * commits they make can share a log flush. Group sizes tell how much
+         * of the commit cost can be amortized this way. Nothing is batched
+         * here, objects still enter and leave one by one.
+         */
+        void start_group()
+        {
+            wsrep_seqno_t i(last_left_ + 1);
+
+            // the first of them may have been let in, but not resumed yet
+            if (i <= last_entered_ &&
+                process_[indexof(i)].state_ == Process::S_APPLYING &&
+                process_[indexof(i)].cond_ != 0) ++i;
+
+            while (i <= last_entered_ &&
+                   process_[indexof(i)].state_ == Process::S_WAITING) ++i;
+
+            if (i > last_left_ + 1)
+            {
+                group_end_ = i - 1;
+                ++groups_;
+                grouped_  += group_end_ - last_left_;
             }
         }
 
@@ -511,18 +883,25 @@ namespace galera
             if (last_left_ + 1 == obj_seqno) // we're shrinking window
             {
                 process_[idx].state_ = Process::S_IDLE;
-                last_left_           = obj_seqno;
+                set_last_left(obj_seqno);
                 process_[idx].wake_up_waiters(lock);
+                wake_up_queued(obj_seqno);
 
                 update_last_left(lock);
                 oool_ += (last_left_ > obj_seqno);
-                // wake up waiters that may remain above us (last_left_
-                // now is max)
-                wake_up_next();
+
+                if (group_stats_ && last_left_ >= group_end_) start_group();
+
+                // wake up waiters with exact dependencies that may remain
+                // above us (last_left_ now is max)
+                if (deps_waiters_ > 0) wake_up_next();
             }
             else
             {
                 process_[idx].state_ = Process::S_FINISHED;
+                // waiters with exact dependencies may enter on out of order
+                // leave
+                if (deps_waiters_ > 0) wake_up_next();
             }
 
             process_[idx].obj_ = 0;
@@ -538,6 +917,7 @@ namespace galera
                                               //   we reached drain_seqno_
             {
                 cond_.broadcast();
+                shrink();
             }
         }
 
@@ -567,13 +947,12 @@ namespace galera
         typename Process::State state(const C& obj) const
         {
             const wsrep_seqno_t obj_seqno(obj.seqno());
-            const size_t        idx(indexof(obj_seqno));
             gu::Lock lock(mutex_);
             while (would_block (obj_seqno))
             {
                 lock.wait(cond_);
             }
-            return process_[idx].state_;
+            return process_[indexof(obj_seqno)].state_;
         }
 
         Monitor(const Monitor&);
@@ -586,7 +965,11 @@ namespace galera
         wsrep_uuid_t  uuid_;
         wsrep_seqno_t last_entered_;
         wsrep_seqno_t last_left_;
+        wsrep_seqno_t last_canceled_; // may be canceled before entered
         wsrep_seqno_t drain_seqno_;
+        ssize_t const min_size_; // configured window size
+        ssize_t       process_size_;
+        size_t        process_mask_;
         Process*      process_;
         long entered_;  // entered
         long oooe_;     // out of order entered
@@ -595,7 +978,17 @@ namespace galera
         // Total number of waits in the monitor. Incremented before
         // entering into waiting state.
         long long waits_;
+        // Number of objects with exact dependencies waiting to enter
+        long deps_waiters_;
+        bool const    group_stats_;
+        wsrep_seqno_t group_end_; // last seqno of the current group
+        long groups_;             // groups started
+        long grouped_;            // objects in started groups
+        wsrep_seqno_t win_max_;   // peak process window occupancy
     };
+
+    template <class C> const ssize_t Monitor<C>::default_size;
+    template <class C> const ssize_t Monitor<C>::max_size;
 }
 
 #endif // GALERA_APPLY_MONITOR_HPP
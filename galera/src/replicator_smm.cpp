@@ -69,6 +69,37 @@ std::ostream& galera::operator<<(std::ostream& os, ReplicatorSMM::State state)
     gu_throw_fatal << "invalid state " << static_cast<int>(state);
 }
 
+/* initial size of monitor process windows, the upper limit is checked by
+ * Monitor */
+static ssize_t
+monitor_window(const gu::Config& conf, const std::string& key)
+{
+    long long const ret(conf.get<long long>(key));
+
+    if (ret <= 0)
+    {
+        gu_throw_error(EINVAL) << "Bad value '" << ret << "' for parameter '"
+                               << key << "': must be positive";
+    }
+
+    return ret;
+}
+
+/* size or count parameter, e.g. minimum size of data set to compress */
+static size_t
+non_negative_param(const gu::Config& conf, const std::string& key)
+{
+    long long const ret(conf.get<long long>(key));
+
+    if (ret < 0)
+    {
+        gu_throw_error(EINVAL) << "Bad value '" << ret << "' for parameter '"
+                               << key << "': must not be negative";
+    }
+
+    return ret;
+}
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //                           Public
@@ -99,7 +130,12 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
                          KeySet::version(config_.get(Param::key_format)),
                          TrxHandleMaster::Defaults.record_set_ver_,
                          gu::from_string<int>(config_.get(
-                             Param::max_write_set_size))),
+                             Param::max_write_set_size)),
+                         TrxHandleMaster::Defaults.data_set_ver_,
+                         DataSet::compression(
+                             config_.get(Param::data_compression)),
+                         non_negative_param(
+                             config_, Param::data_compression_threshold)),
     uuid_               (WSREP_UUID_UNDEFINED),
     state_uuid_         (WSREP_UUID_UNDEFINED),
     state_uuid_str_     (),
@@ -121,6 +157,12 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     sst_cond_           (gu::get_cond_key(gu::GU_COND_KEY_SST)),
     sst_retry_sec_      (1),
     sst_received_       (false),
+    checksum_pool_      (non_negative_param(config_, Param::checksum_threads),
+                         non_negative_param(config_, Param::checksum_queue),
+                         non_negative_param(config_,
+                                            Param::checksum_threshold)),
+    page_pool_          (non_negative_param(config_, Param::page_pool_size),
+                         config_.get<bool>(Param::page_pool_huge)),
     gcache_progress_cb_ (ProgressCallback<int64_t>(WSREP_MEMBER_UNDEFINED,
                                                    WSREP_MEMBER_UNDEFINED)),
     gcache_             (&gcache_progress_cb_, config_, config_.get(BASE_DIR),
@@ -143,15 +185,21 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     pending_cert_queue_ (gcache_),
     write_set_waiters_  (),
     local_monitor_      (gu::GU_MUTEX_KEY_LOCAL_MONITOR,
-                         gu::GU_COND_KEY_LOCAL_MONITOR),
+                         gu::GU_COND_KEY_LOCAL_MONITOR,
+                         monitor_window(config_, Param::monitor_window)),
     apply_monitor_      (gu::GU_MUTEX_KEY_APPLY_MONITOR,
-                         gu::GU_COND_KEY_APPLY_MONITOR),
+                         gu::GU_COND_KEY_APPLY_MONITOR,
+                         monitor_window(config_, Param::monitor_window)),
     commit_monitor_     (gu::GU_MUTEX_KEY_COMMIT_MONITOR,
-                         gu::GU_COND_KEY_COMMIT_MONITOR),
+                         gu::GU_COND_KEY_COMMIT_MONITOR,
+                         monitor_window(config_, Param::monitor_window),
+                         true), // commit group metric
     causal_read_timeout_(config_.get(Param::causal_read_timeout)),
     receivers_          (),
     replicated_         (),
     replicated_bytes_   (),
+    repl_fragments_     (),
+    repl_fragment_bytes_(),
     keys_count_         (),
     keys_bytes_         (),
     data_bytes_         (),
@@ -231,6 +279,18 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     }
 
     build_stats_vars(wsrep_stats_);
+
+    /* the pool is process-wide: the first replicator instance owns it */
+    if (checksum_pool_.enabled() && NULL == WriteSetIn::check_pool())
+    {
+        WriteSetIn::set_check_pool(&checksum_pool_);
+    }
+
+    /* same for the write set buffer page pool */
+    if (page_pool_.enabled() && NULL == gu::Allocator::page_pool())
+    {
+        gu::Allocator::set_page_pool(&page_pool_);
+    }
 }
 
 void galera::ReplicatorSMM::start_closing()
@@ -314,6 +374,19 @@ galera::ReplicatorSMM::~ReplicatorSMM()
     }
 
     delete as_;
+
+    /* Uninstall the pools so that no new jobs and pages are taken from them.
+     * Those given out are returned when the members holding trx handles are
+     * destroyed, pool destructors wait for that. */
+    if (WriteSetIn::check_pool() == &checksum_pool_)
+    {
+        WriteSetIn::set_check_pool(NULL);
+    }
+
+    if (gu::Allocator::page_pool() == &page_pool_)
+    {
+        gu::Allocator::set_page_pool(NULL);
+    }
 }
 
 wsrep_status_t galera::ReplicatorSMM::connect(const std::string& cluster_name,
@@ -750,6 +823,12 @@ wsrep_status_t galera::ReplicatorSMM::replicate(TrxHandleMaster& trx,
     ++replicated_;
     replicated_bytes_ += rcode;
 
+    if (ts->is_streaming())
+    {
+        ++repl_fragments_;
+        repl_fragment_bytes_ += rcode;
+    }
+
     assert(trx.source_id() == ts->source_id());
     assert(trx.conn_id()   == ts->conn_id());
     assert(trx.trx_id()    == ts->trx_id());
@@ -1886,11 +1965,14 @@ writeset_from_handle (wsrep_po_handle_t&             handle,
 //                gu::String<256>(trx_params.working_dir_) << '/' << &handle,
                 trx_params.working_dir_, wsrep_trx_id_t(&handle),
                 /* key format is not essential since we're not adding keys */
-                KeySet::version(trx_params.key_format_), NULL, 0, 0,
+                trx_params.key_set_version(), NULL, 0, 0,
                 trx_params.record_set_ver_,
-                WriteSetNG::MAX_VERSION, DataSet::MAX_VERSION, DataSet::MAX_VERSION,
+                WriteSetNG::MAX_VERSION, trx_params.data_set_version(),
+                trx_params.data_set_version(),
                 trx_params.max_write_set_size_);
 
+            trx_params.set_compression(*ret);
+
             handle.opaque = ret;
         }
         catch (std::bad_alloc& ba)
@@ -2368,6 +2450,24 @@ galera::get_trx_protocol_versions(int proto_ver)
         trx_ver = 6; // zero-level key in the writeset
         record_set_ver = gu::RecordSet::VER2;
         break;
+    case 12:
+        // Protocol upgrade to enable support for compressed data sets
+        // (DataSet::VER2), no effect to TRX or STR protocols.
+        trx_ver = 6;
+        record_set_ver = gu::RecordSet::VER2;
+        break;
+    case 13:
+        // Protocol upgrade to enable support for 4-lane CRC-32C record set
+        // checksums (RecordSet::VER3), no effect to TRX or STR protocols.
+        trx_ver = 6;
+        record_set_ver = gu::RecordSet::VER3;
+        break;
+    case 14:
+        // Protocol upgrade to enable support for fast key hash
+        // (KeySet::FLAT8X and up), no effect to TRX or STR protocols.
+        trx_ver = 6;
+        record_set_ver = gu::RecordSet::VER3;
+        break;
     default:
         gu_throw_error(EPROTO)
             << "Configuration change resulted in an unsupported protocol "
@@ -2383,6 +2483,9 @@ void galera::ReplicatorSMM::establish_protocol_versions (int proto_ver)
         const auto trx_versions(get_trx_protocol_versions(proto_ver));
         trx_params_.version_ = std::get<0>(trx_versions);
         trx_params_.record_set_ver_ = std::get<1>(trx_versions);
+        trx_params_.data_set_ver_ = proto_ver >= PROTO_VER_DATA_COMPRESSION ?
+            DataSet::VER2 : DataSet::VER1;
+        trx_params_.fast_key_hash_ = proto_ver >= PROTO_VER_FAST_KEY_HASH;
         protocol_version_ = proto_ver;
         log_info << "REPL Protocols: " << protocol_version_ << " ("
                  << trx_params_.version_ << ")";
@@ -3174,7 +3277,7 @@ void galera::ReplicatorSMM::desync()
 /* #706 - the check below must be state request-specific. We are not holding
           any locks here and must be able to wait like any other action.
           However practice may prove different, leaving it here as a reminder.
-            if (local_monitor_.would_block(seqno_l))
+            if (local_monitor_.would_overflow(seqno_l))
             {
                 gu_throw_error (-EDEADLK) << "Ran out of resources waiting to "
                                           << "desync the node. "
@@ -3411,6 +3514,9 @@ wsrep_status_t galera::ReplicatorSMM::cert(TrxHandleMaster* trx,
     // Verify checksum before certification to avoid corrupting index.
     ts->verify_checksum();
 
+    // Decode and group keys while not holding the local monitor.
+    cert_.prepare_keys(*ts);
+
     LocalOrder lo(*ts);
     // Local monitor is either released or canceled in
     // handle_local_monitor_interrupted(), finish_cert().
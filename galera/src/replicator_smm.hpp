@@ -21,6 +21,7 @@
 #include "certification.hpp"
 #include "trx_handle.hpp"
 #include "write_set.hpp"
+#include "checksum_pool.hpp"
 #include "galera_service_thd.hpp"
 #include "fsm.hpp"
 #include "action_source.hpp"
@@ -408,6 +409,14 @@ namespace galera
             static const std::string commit_order;
             static const std::string causal_read_timeout;
             static const std::string max_write_set_size;
+            static const std::string monitor_window;
+            static const std::string data_compression;
+            static const std::string data_compression_threshold;
+            static const std::string checksum_threads;
+            static const std::string checksum_queue;
+            static const std::string checksum_threshold;
+            static const std::string page_pool_size;
+            static const std::string page_pool_huge;
         };
 
         typedef std::pair<std::string, std::string> Default;
@@ -566,6 +575,11 @@ namespace galera
                 return (last_left + 1 == seqno_);
             }
 
+            // seqno which has to leave before condition() may become true
+            wsrep_seqno_t wait_seqno() const { return seqno_ - 1; }
+
+            const TrxHandleSlave::Deps* deps() const { return NULL; }
+
 #ifdef GU_DBUG_ON
             void debug_sync(gu::Mutex& mutex)
             {
@@ -621,7 +635,11 @@ namespace galera
             ApplyOrder(const TrxHandleSlave& ts)
                 :
                 global_seqno_ (ts.global_seqno()),
-                depends_seqno_(ts.depends_seqno()),
+                /* with exact dependencies, wait for all up to their base
+                 * and then only for the write sets in deps() */
+                depends_seqno_(ts.exact_deps() ?
+                               ts.deps_base() : ts.depends_seqno()),
+                deps_(ts.exact_deps() && !ts.local() ? &ts.deps() : NULL),
                 cond_(&ts.apply_order_cond_),
                 is_local_     (ts.local()),
                 is_toi_       (ts.is_toi())
@@ -640,6 +658,7 @@ namespace galera
                 :
                 global_seqno_ (gs),
                 depends_seqno_(ds),
+                deps_(),
                 cond_(),
                 is_local_     (l),
                 is_toi_       (false)
@@ -659,6 +678,10 @@ namespace galera
                         last_left >= depends_seqno_);
             }
 
+            wsrep_seqno_t wait_seqno() const { return depends_seqno_; }
+
+            const TrxHandleSlave::Deps* deps() const { return deps_; }
+
 #ifdef GU_DBUG_ON
             void debug_sync(gu::Mutex& mutex)
             {
@@ -682,6 +705,7 @@ namespace galera
                 :
                 global_seqno_ (WSREP_SEQNO_UNDEFINED),
                 depends_seqno_(WSREP_SEQNO_UNDEFINED),
+                deps_(),
                 cond_(),
                 is_local_     (false),
                 is_toi_       (false),
@@ -702,6 +726,7 @@ namespace galera
 #endif /* NDEBUG */
             const wsrep_seqno_t global_seqno_;
             const wsrep_seqno_t depends_seqno_;
+            const TrxHandleSlave::Deps* const deps_;
             gu::Cond* cond_;
             const bool is_local_;
             const bool is_toi_;
@@ -785,6 +810,10 @@ namespace galera
                 gu_throw_fatal << "invalid commit mode value " << mode_;
             }
 
+            wsrep_seqno_t wait_seqno() const { return global_seqno_ - 1; }
+
+            const TrxHandleSlave::Deps* deps() const { return NULL; }
+
 #ifdef GU_DBUG_ON
             void debug_sync(gu::Mutex& mutex)
             {
@@ -977,6 +1006,11 @@ namespace galera
          * | 4.x            10 | PA range/ 5 | CC events /  3 |               2 |
          * |                   | UPD keys    | idx preload    |                 |
          * |                11 | SRV keys  6 |              3 |               2 |
+         * |                12 | DataSet   6 |              3 |               2 |
+         * |                   | VER2        |                |                 |
+         * |                13 |           6 |              3 | CRC32C4       3 |
+         * |                14 | fast key  6 |              3 |               3 |
+         * |                   | hash        |                |                 |
          * |--------------------------------------------------------------------|
          *
          * Note: str_proto_ver is decided in replicator_str.cpp based on
@@ -987,6 +1021,10 @@ namespace galera
         static int const PROTO_VER_GALERA_3_MAX = 9;
         /* repl protocol version which orders CC */
         static int const PROTO_VER_ORDERED_CC = 10;
+        /* repl protocol version which allows compressed data sets */
+        static int const PROTO_VER_DATA_COMPRESSION = 12;
+        /* repl protocol version which allows fast key hash in key sets */
+        static int const PROTO_VER_FAST_KEY_HASH = 14;
 
         int                    protocol_version_;// general repl layer proto
         int                    proto_max_;    // maximum allowed proto version
@@ -1041,6 +1079,8 @@ namespace galera
         bool          sst_received_;
 
         // services
+        ChecksumPool     checksum_pool_; // must outlive all write sets
+        gu::Allocator::PagePool page_pool_; // must outlive all trx handles
         ProgressCallback<int64_t> gcache_progress_cb_;
         gcache::GCache   gcache_;
         ProgressCallback<gcs_seqno_t> joined_progress_cb_;
@@ -1134,6 +1174,8 @@ namespace galera
         gu::Atomic<size_t>    receivers_;
         gu::Atomic<long long> replicated_;
         gu::Atomic<long long> replicated_bytes_;
+        gu::Atomic<long long> repl_fragments_;      // SR fragments
+        gu::Atomic<long long> repl_fragment_bytes_;
         gu::Atomic<long long> keys_count_;
         gu::Atomic<long long> keys_bytes_;
         gu::Atomic<long long> data_bytes_;
@@ -24,8 +24,24 @@ const std::string galera::ReplicatorSMM::Param::key_format =
     common_prefix + "key_format";
 const std::string galera::ReplicatorSMM::Param::max_write_set_size =
     common_prefix + "max_ws_size";
-
-int const galera::ReplicatorSMM::MAX_PROTO_VER(11);
+const std::string galera::ReplicatorSMM::Param::monitor_window =
+    common_prefix + "monitor_window";
+const std::string galera::ReplicatorSMM::Param::data_compression =
+    common_prefix + "data_compression";
+const std::string galera::ReplicatorSMM::Param::data_compression_threshold =
+    common_prefix + "data_compression_threshold";
+const std::string galera::ReplicatorSMM::Param::checksum_threads =
+    common_prefix + "checksum_threads";
+const std::string galera::ReplicatorSMM::Param::checksum_queue =
+    common_prefix + "checksum_queue";
+const std::string galera::ReplicatorSMM::Param::checksum_threshold =
+    common_prefix + "checksum_threshold";
+const std::string galera::ReplicatorSMM::Param::page_pool_size =
+    common_prefix + "page_pool_size";
+const std::string galera::ReplicatorSMM::Param::page_pool_huge =
+    common_prefix + "page_pool_huge";
+
+int const galera::ReplicatorSMM::MAX_PROTO_VER(14);
 
 galera::ReplicatorSMM::Defaults::Defaults() : map_()
 {
@@ -38,6 +54,15 @@ galera::ReplicatorSMM::Defaults::Defaults() : map_()
     const int max_write_set_size(galera::WriteSetNG::MAX_SIZE);
     map_.insert(Default(Param::max_write_set_size,
                         gu::to_string(max_write_set_size)));
+    map_.insert(Default(Param::monitor_window,
+                        gu::to_string(Monitor<ApplyOrder>::default_size)));
+    map_.insert(Default(Param::data_compression, "none"));
+    map_.insert(Default(Param::data_compression_threshold, "4096"));
+    map_.insert(Default(Param::checksum_threads, "2"));
+    map_.insert(Default(Param::checksum_queue, "128"));
+    map_.insert(Default(Param::checksum_threshold, "65536"));
+    map_.insert(Default(Param::page_pool_size, "16M"));
+    map_.insert(Default(Param::page_pool_huge, "no"));
 }
 
 const galera::ReplicatorSMM::Defaults galera::ReplicatorSMM::defaults;
@@ -63,8 +88,22 @@ galera::ReplicatorSMM::InitConfig::InitConfig(gu::Config&       conf,
     conf.set_flags(Param::causal_read_timeout, gu::Config::Flag::type_duration);
     conf.set_flags(Param::max_write_set_size, gu::Config::Flag::type_integer);
     conf.set_flags(Param::base_dir, gu::Config::Flag::read_only);
+    conf.set_flags(Param::monitor_window, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_integer);
     conf.set_flags(Param::base_port, gu::Config::Flag::read_only |
                    gu::Config::Flag::type_integer);
+    conf.set_flags(Param::data_compression_threshold,
+                   gu::Config::Flag::type_integer);
+    conf.set_flags(Param::checksum_threads, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_integer);
+    conf.set_flags(Param::checksum_queue, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_integer);
+    conf.set_flags(Param::checksum_threshold, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_integer);
+    conf.set_flags(Param::page_pool_size, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_integer);
+    conf.set_flags(Param::page_pool_huge, gu::Config::Flag::read_only |
+                   gu::Config::Flag::type_bool);
 
     // what is would be a better protection?
     int const pv(gu::from_string<int>(conf.get(Param::proto_max)));
@@ -175,7 +214,13 @@ galera::ReplicatorSMM::set_param (const std::string& key,
     else if (key == Param::base_host ||
              key == Param::base_port ||
              key == Param::base_dir ||
-             key == Param::proto_max)
+             key == Param::proto_max ||
+             key == Param::monitor_window ||
+             key == Param::checksum_threads ||
+             key == Param::checksum_queue ||
+             key == Param::checksum_threshold ||
+             key == Param::page_pool_size ||
+             key == Param::page_pool_huge)
     {
         // nothing to do here, these params take effect only at
         // provider (re)start
@@ -188,6 +233,23 @@ galera::ReplicatorSMM::set_param (const std::string& key,
     {
         trx_params_.max_write_set_size_ = gu::from_string<int>(value);
     }
+    else if (key == Param::data_compression)
+    {
+        trx_params_.compression_ = DataSet::compression(value);
+    }
+    else if (key == Param::data_compression_threshold)
+    {
+        long long const threshold(gu::from_string<long long>(value));
+
+        if (threshold < 0)
+        {
+            gu_throw_error(EINVAL) << "Bad value '" << value
+                                   << "' for parameter '" << key
+                                   << "': must not be negative";
+        }
+
+        trx_params_.compression_threshold_ = threshold;
+    }
     else
     {
         log_warn << "parameter '" << key << "' not found";
@@ -101,9 +101,12 @@ typedef enum status_vars
     STATS_APPLY_OOOL,
     STATS_APPLY_WINDOW,
     STATS_APPLY_WAITS,
+    STATS_APPLY_WINDOW_MAX,
     STATS_COMMIT_OOOE,
     STATS_COMMIT_OOOL,
     STATS_COMMIT_WINDOW,
+    STATS_COMMIT_GROUP,
+    STATS_COMMIT_WINDOW_MAX,
     STATS_LOCAL_STATE,
     STATS_LOCAL_STATE_COMMENT,
     STATS_CERT_INDEX_SIZE,
@@ -111,7 +114,11 @@ typedef enum status_vars
     STATS_CERT_INTERVAL,
     STATS_OPEN_TRX,
     STATS_OPEN_CONN,
+    STATS_CHECKSUM_QUEUE,
+    STATS_CHECKSUM_LATENCY,
     STATS_INCOMING_LIST,
+    STATS_REPL_FRAGMENTS,
+    STATS_REPL_FRAGMENT_BYTES,
     STATS_MAX
 } StatusVars;
 
@@ -152,9 +159,12 @@ static const struct wsrep_stats_var wsrep_stats[STATS_MAX + 1] =
     { "apply_oool",               WSREP_VAR_DOUBLE, { 0 }  },
     { "apply_window",             WSREP_VAR_DOUBLE, { 0 }  },
     { "apply_waits",              WSREP_VAR_INT64,  { 0 }  },
+    { "apply_window_max",         WSREP_VAR_INT64,  { 0 }  },
     { "commit_oooe",              WSREP_VAR_DOUBLE, { 0 }  },
     { "commit_oool",              WSREP_VAR_DOUBLE, { 0 }  },
     { "commit_window",            WSREP_VAR_DOUBLE, { 0 }  },
+    { "commit_group",             WSREP_VAR_DOUBLE, { 0 }  },
+    { "commit_window_max",        WSREP_VAR_INT64,  { 0 }  },
     { "local_state",              WSREP_VAR_INT64,  { 0 }  },
     { "local_state_comment",      WSREP_VAR_STRING, { 0 }  },
     { "cert_index_size",          WSREP_VAR_INT64,  { 0 }  },
@@ -162,7 +172,11 @@ static const struct wsrep_stats_var wsrep_stats[STATS_MAX + 1] =
     { "cert_interval",            WSREP_VAR_DOUBLE, { 0 }  },
     { "open_transactions",        WSREP_VAR_INT64,  { 0 }  },
     { "open_connections",         WSREP_VAR_INT64,  { 0 }  },
+    { "checksum_queue",           WSREP_VAR_INT64,  { 0 }  },
+    { "checksum_latency",         WSREP_VAR_DOUBLE, { 0 }  },
     { "incoming_addresses",       WSREP_VAR_STRING, { 0 }  },
+    { "repl_fragments",           WSREP_VAR_INT64,  { 0 }  },
+    { "repl_fragment_bytes",      WSREP_VAR_INT64,  { 0 }  },
     { 0,                          WSREP_VAR_STRING, { 0 }  }
 };
 
@@ -198,6 +212,8 @@ galera::ReplicatorSMM::stats_get() const
     sv[STATS_KEYS_BYTES         ].value._int64  = keys_bytes_();
     sv[STATS_DATA_BYTES         ].value._int64  = data_bytes_();
     sv[STATS_UNRD_BYTES         ].value._int64  = unrd_bytes_();
+    sv[STATS_REPL_FRAGMENTS     ].value._int64  = repl_fragments_();
+    sv[STATS_REPL_FRAGMENT_BYTES].value._int64  = repl_fragment_bytes_();
     sv[STATS_RECEIVED           ].value._int64  = as_->received();
     sv[STATS_RECEIVED_BYTES     ].value._int64  = as_->received_bytes();
     sv[STATS_LOCAL_COMMITS      ].value._int64  = local_commits_();
@@ -245,11 +261,16 @@ galera::ReplicatorSMM::stats_get() const
     sv[STATS_APPLY_OOOL          ].value._double = oool;
     sv[STATS_APPLY_WINDOW        ].value._double = win;
     sv[STATS_APPLY_WAITS         ].value._int64 = waits;
+    sv[STATS_APPLY_WINDOW_MAX    ].value._int64 = apply_monitor_.window_max();
     commit_monitor_.get_stats(&oooe, &oool, &win, &waits);
 
     sv[STATS_COMMIT_OOOE         ].value._double = oooe;
     sv[STATS_COMMIT_OOOL         ].value._double = oool;
     sv[STATS_COMMIT_WINDOW       ].value._double = win;
+    sv[STATS_COMMIT_GROUP        ].value._double =
+        commit_monitor_.group_size();
+    sv[STATS_COMMIT_WINDOW_MAX   ].value._int64 =
+        commit_monitor_.window_max();
 
     if (st_.corrupt())
     {
@@ -268,10 +289,17 @@ galera::ReplicatorSMM::stats_get() const
     sv[STATS_OPEN_TRX].value._int64 = wsdb_stats.n_trx_;
     sv[STATS_OPEN_CONN].value._int64 = wsdb_stats.n_conn_;
 
+    long long checksum_queue;
+    double    checksum_latency;
+    checksum_pool_.get_stats(checksum_queue, checksum_latency);
+    sv[STATS_CHECKSUM_QUEUE  ].value._int64  = checksum_queue;
+    sv[STATS_CHECKSUM_LATENCY].value._double = checksum_latency;
+
 
     // Get gcs backend status
     gu::Status status;
     int gcs_rc = gcs_.get_status(status);
+    if (gcs_rc == 0) cert_.get_status(status);
 
 #ifdef GU_DBUG_ON
     status.insert("debug_sync_waiters", gu_debug_sync_waiters());
@@ -314,7 +342,7 @@ galera::ReplicatorSMM::stats_get() const
         tail_buf += incoming_list_.size() + 1;
 
         // Iterate over dynamical status variables and assing strings
-        size_t sv_pos(STATS_INCOMING_LIST + 1);
+        size_t sv_pos(STATS_MAX);
         if (gcs_rc == 0)
         {
             for (gu::Status::const_iterator i(status.begin());
@@ -372,6 +400,8 @@ galera::ReplicatorSMM::stats_reset()
     commit_monitor_.flush_stats();
 
     cert_.stats_reset();
+
+    checksum_pool_.flush_stats();
 }
 
 void
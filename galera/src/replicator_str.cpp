@@ -33,6 +33,9 @@ static int get_str_proto_ver(int const group_proto_ver)
         return 2;
     case 10:
     case 11:
+    case 12:
+    case 13:
+    case 14:
         // 4.x
         // CC events in IST, certification index preload
         return 3;
@@ -819,7 +822,7 @@ ReplicatorSMM::send_state_request (const StateRequest* const req,
         if (seqno_l != GCS_SEQNO_ILL)
         {
             /* Check that we're not running out of space in monitor. */
-            if (local_monitor_.would_block(seqno_l))
+            if (local_monitor_.would_overflow(seqno_l))
             {
                 log_error << "Slave queue grew too long while trying to "
                           << "request state transfer " << tries << " time(s). "
@@ -27,6 +27,7 @@
 #include "gu_limits.h" // page size stuff
 
 #include <set>
+#include <vector>
 
 namespace galera
 {
@@ -629,6 +630,39 @@ namespace galera
 
         const WriteSetIn&  write_set () const { return write_set_;  }
 
+        /* Key parts of the write set grouped by certification index shard,
+         * see Certification::prepare_keys() */
+        typedef std::vector<KeySet::KeyPart> CertKeys;
+
+        CertKeys&       cert_keys()       { return cert_keys_; }
+        const CertKeys& cert_keys() const { return cert_keys_; }
+
+        /* Exact preceding write sets this one conflicts with, as found by
+         * certification with cert.exact_deps enabled. If exact_deps() is
+         * true, the write set may be applied once all write sets up to
+         * deps_base() and those in deps() are applied, instead of waiting
+         * for all write sets up to depends_seqno(). */
+        typedef std::vector<wsrep_seqno_t> Deps;
+
+        Deps&         deps()             { return deps_; }
+        const Deps&   deps()       const { return deps_; }
+        bool          exact_deps() const { return exact_deps_; }
+        wsrep_seqno_t deps_base()  const { return deps_base_; }
+
+        void set_exact_deps(wsrep_seqno_t const base)
+        {
+            assert(base <= depends_seqno_);
+            deps_base_  = base;
+            exact_deps_ = true;
+        }
+
+        void clear_exact_deps()
+        {
+            deps_.clear();
+            deps_base_  = WSREP_SEQNO_UNDEFINED;
+            exact_deps_ = false;
+        }
+
         bool   exit_loop() const { return exit_loop_; }
         void   set_exit_loop(bool x) { exit_loop_ |= x; }
 
@@ -713,13 +747,17 @@ namespace galera
             ends_nbo_          (WSREP_SEQNO_UNDEFINED),
             mem_pool_          (mp),
             write_set_         (),
+            cert_keys_         (),
+            deps_              (),
+            deps_base_         (WSREP_SEQNO_UNDEFINED),
             buf_               (buf),
             action_            (static_cast<const void*>(0), 0),
             certified_         (false),
             committed_         (false),
             exit_loop_         (false),
             cert_bypass_       (false),
-            queued_            (false)
+            queued_            (false),
+            exact_deps_        (false)
 #ifndef NDEBUG
             ,explicit_rollback_(false)
 #endif /* NDEBUG */
@@ -742,6 +780,9 @@ namespace galera
         wsrep_seqno_t          ends_nbo_;
         gu::MemPool<true>&     mem_pool_;
         WriteSetIn             write_set_;
+        CertKeys               cert_keys_;
+        Deps                   deps_;
+        wsrep_seqno_t          deps_base_;
         void* const            buf_;
         std::pair<const void*, size_t> action_;
         bool                   certified_;
@@ -749,6 +790,7 @@ namespace galera
         bool                   exit_loop_;
         bool                   cert_bypass_;
         bool                   queued_;
+        bool                   exact_deps_;
 #ifndef NDEBUG
         bool                   explicit_rollback_;
 #endif /* NDEBUG */
@@ -810,24 +852,60 @@ namespace galera
             KeySet::Version        key_format_;
             gu::RecordSet::Version record_set_ver_;
             int                    max_write_set_size_;
+            DataSet::Version       data_set_ver_; // max allowed by protocol
+            gu::Compression::Type  compression_;
+            size_t                 compression_threshold_;
+            bool                   fast_key_hash_; // allowed by protocol
 
             Params (const std::string& wdir,
                     int                ver,
                     KeySet::Version    kformat,
                     gu::RecordSet::Version rsv = gu::RecordSet::VER2,
-                    int                max_write_set_size = WriteSetNG::MAX_SIZE)
+                    int                max_write_set_size = WriteSetNG::MAX_SIZE,
+                    DataSet::Version   dsv = DataSet::VER1,
+                    gu::Compression::Type compression = gu::Compression::NONE,
+                    size_t             compression_threshold = 0,
+                    bool               fast_key_hash = false)
                 :
                 working_dir_       (wdir),
                 version_           (ver),
                 key_format_        (kformat),
                 record_set_ver_    (rsv),
-                max_write_set_size_(max_write_set_size)
+                max_write_set_size_(max_write_set_size),
+                data_set_ver_      (dsv),
+                compression_       (compression),
+                compression_threshold_(compression_threshold),
+                fast_key_hash_     (fast_key_hash)
             {}
 
             Params () :
                 working_dir_(), version_(), key_format_(),
-                record_set_ver_(), max_write_set_size_()
+                record_set_ver_(), max_write_set_size_(), data_set_ver_(),
+                compression_(), compression_threshold_(), fast_key_hash_()
             {}
+
+            /* data set version to use in new write sets: VER2 only if
+             * compression is enabled */
+            DataSet::Version data_set_version() const
+            {
+                return (gu::Compression::NONE != compression_ ?
+                        data_set_ver_ : DataSet::VER1);
+            }
+
+            /* key set version to use in new write sets: key_format_
+             * with the key hash function allowed by protocol */
+            KeySet::Version key_set_version() const
+            {
+                return KeySet::version(key_format_, fast_key_hash_);
+            }
+
+            void set_compression(WriteSetOut& ws) const
+            {
+                if (data_set_version() >= DataSet::VER2)
+                {
+                    ws.set_compression(compression_, compression_threshold_);
+                }
+            }
         };
 
         static const Params Defaults;
@@ -1055,16 +1133,19 @@ namespace galera
             assert(params_.version_ >= 0 &&
                    params_.version_ <= WriteSetNG::MAX_VERSION);
 
-            new (wso) WriteSetOut (params_.working_dir_,
-                                   trx_id(), params_.key_format_,
-                                   store,
-                                   wso_buf_size_ - sizeof(WriteSetOut),
-                                   0,
-                                   params_.record_set_ver_,
-                                   WriteSetNG::Version(params_.version_),
-                                   DataSet::MAX_VERSION,
-                                   DataSet::MAX_VERSION,
-                                   params_.max_write_set_size_);
+            WriteSetOut* const ws
+                (new (wso) WriteSetOut (params_.working_dir_,
+                                        trx_id(), params_.key_set_version(),
+                                        store,
+                                        wso_buf_size_ - sizeof(WriteSetOut),
+                                        0,
+                                        params_.record_set_ver_,
+                                        WriteSetNG::Version(params_.version_),
+                                        params_.data_set_version(),
+                                        params_.data_set_version(),
+                                        params_.max_write_set_size_));
+
+            params_.set_compression(*ws);
 
             wso_ = true;
         }
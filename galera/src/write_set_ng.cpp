@@ -198,6 +198,8 @@ const char WriteSetOut::data_suffix[] = "_data";
 const char WriteSetOut::unrd_suffix[] = "_unrd";
 const char WriteSetOut::annt_suffix[] = "_annt";
 
+std::atomic<ChecksumPool*> WriteSetIn::check_pool_(NULL);
+
 
 void
 WriteSetIn::init (ssize_t const st)
@@ -218,6 +220,15 @@ WriteSetIn::init (ssize_t const st)
 
     if (gu_likely(st > 0)) /* checksum enforced */
     {
+        ChecksumPool* const pool(check_pool_);
+
+        if (pool && size_ >= ssize_t(pool->threshold()) &&
+            pool->submit(check_job_, checksum_thread, this))
+        {
+            /* will be verified by the pool, verify_checksum() waits */
+            return;
+        }
+
         if (size_ >= st)
         {
             /* buffer too big, start checksumming in background */
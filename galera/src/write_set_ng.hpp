@@ -17,10 +17,12 @@
 #include "wsrep_api.h"
 #include "key_set.hpp"
 #include "data_set.hpp"
+#include "checksum_pool.hpp"
 
 #include "gu_serialize.hpp"
 #include "gu_vector.hpp"
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <iomanip>
@@ -115,6 +117,7 @@ namespace galera
             /*
              * reserved for provider extension
              */
+            F_COMPRESSED  = 1 << 13, // data set is compressed (DataSet::VER2)
             F_CERTIFIED   = 1 << 14, // needed to correctly interprete pa_range
                                      // field (VER5 and up)
             F_PREORDERED  = 1 << 15  // (VER5 and up)
@@ -528,7 +531,8 @@ namespace galera
             annt_  (NULL),
             left_  (max_size - keys_.size() - data_.size() - unrd_.size()
                     - header_.size()),
-            flags_ (flags)
+            flags_ (flags),
+            dver_  (dver)
         {
             assert ((uintptr_t(reserved) % GU_WORD_BYTES) == 0);
         }
@@ -554,8 +558,8 @@ namespace galera
         {
             if (NULL == annt_)
             {
-                annt_ = new DataSetOut(NULL, 0, abn_, DataSet::MAX_VERSION,
-                                       // use the same version as the dataset
+                /* use the same versions as the dataset */
+                annt_ = new DataSetOut(NULL, 0, abn_, dver_,
                                        data_.gu::RecordSet::version());
                 left_ -= annt_->size();
             }
@@ -563,6 +567,14 @@ namespace galera
             left_ -= annt_->append(data, data_len, store);
         }
 
+        /* compress data set of at least threshold bytes, requires
+         * DataSet::VER2 */
+        void set_compression(gu::Compression::Type const type,
+                             size_t const                threshold)
+        {
+            data_.set_compression(type, threshold);
+        }
+
         void set_flags(uint16_t flags) { flags_  = flags; }
         void add_flags(uint16_t flags) { flags_ |= flags; }
         void mark_toi()                { flags_ |= WriteSetNG::F_TOI; }
@@ -588,11 +600,14 @@ namespace galera
                           + unrd_.page_count() + 1 /* global header */);
 
 
+            uint16_t const flags(data_.compress() ?
+                                 flags_ | WriteSetNG::F_COMPRESSED : flags_);
+
             size_t out_size (header_.gather (keys_.version(),
                                              data_.version(),
                                              unrd_.version() != DataSet::EMPTY,
                                              NULL != annt_,
-                                             flags_, source, conn, trx,
+                                             flags, source, conn, trx,
                                              out));
 
             out_size += keys_.gather(out);
@@ -693,6 +708,7 @@ namespace galera
         DataSetOut*         annt_;
         ssize_t             left_;
         uint16_t            flags_;
+        DataSet::Version const dver_;
 
         void check_size()
         {
@@ -718,6 +734,7 @@ namespace galera
               unrd_  (),
               annt_  (NULL),
               check_thr_id_(),
+              check_job_(),
               check_thr_(false),
               check_ (false)
         {
@@ -732,6 +749,7 @@ namespace galera
               unrd_  (),
               annt_  (NULL),
               check_thr_id_(),
+              check_job_(),
               check_thr_(false),
               check_ (false)
         {}
@@ -773,6 +791,11 @@ namespace galera
                 /* checksum was performed in a parallel thread */
                 gu_thread_join (check_thr_id_, NULL);
             }
+            else if (check_job_.pending())
+            {
+                /* checksum was queued to the verifier pool */
+                ChecksumPool::wait(check_job_);
+            }
 
             delete annt_;
         }
@@ -818,6 +841,11 @@ namespace galera
                 check_thr_ = false;
                 gu_trace(checksum_fin());
             }
+            else if (check_job_.pending())
+            {
+                ChecksumPool::wait(check_job_);
+                gu_trace(checksum_fin());
+            }
         }
 
         uint64_t get_checksum() const
@@ -846,6 +874,13 @@ namespace galera
         size_t gather(GatherVector& out,
                       bool include_keys, bool include_unrd) const;
 
+        /* Installs pool for background checksumming of write sets
+         * constructed after this call (NULL to uninstall). Write sets
+         * not accepted by the pool fall back to a dedicated thread above
+         * size threshold and to foreground checksumming below it. */
+        static void set_check_pool(ChecksumPool* pool) { check_pool_ = pool; }
+        static ChecksumPool* check_pool() { return check_pool_; }
+
     private:
 
         WriteSetNG::Header header_;
@@ -855,11 +890,14 @@ namespace galera
         DataSetIn          unrd_;
         DataSetIn*         annt_;
         gu_thread_t        check_thr_id_;
+        ChecksumPool::Job mutable check_job_;
         bool mutable       check_thr_;
         bool               check_;
 
         static size_t const SIZE_THRESHOLD = 1 << 22; /* 4Mb */
 
+        static std::atomic<ChecksumPool*> check_pool_;
+
         void checksum (); /* checksums writeset, stores result in check_ */
 
         void checksum_fin() const
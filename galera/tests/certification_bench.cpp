@@ -0,0 +1,191 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+/**
+ * This is to benchmark certification throughput depending on the number
+ * of certification index shards and the number of keys per write set.
+ *
+ * Write sets are certified in order by the main thread while a number of
+ * committer threads mark them committed and periodically purge the index,
+ * like applier threads and commit cut processing do in the replicator.
+ *
+ * Usage: certification_bench [total_keys] [committers]
+ */
+
+#include "replicator_smm.hpp" // ReplicatorSMM::InitConfig
+#include "certification.hpp"
+#include "trx_handle.hpp"
+
+#include "galera_test_env.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+namespace
+{
+    typedef std::vector<gu::byte_t> Buffer;
+
+    /* Serializes nws write sets with nkeys keys each from keyspace. */
+    void
+    make_write_sets(std::vector<Buffer>& wss, size_t const nws,
+                    size_t const nkeys, uint64_t const keyspace)
+    {
+        static int const version(galera::WriteSetNG::VER6);
+
+        galera::TrxHandleMaster::Pool mp(
+            sizeof(galera::TrxHandleMaster) + sizeof(galera::WriteSetOut),
+            16, "cert_bench_mp");
+        galera::TrxHandleMaster::Params const trx_params(
+            "", version, galera::KeySet::MAX_VERSION);
+
+        wsrep_uuid_t const source = { { 1, } };
+        std::mt19937_64 rng(nkeys);
+
+        wss.resize(nws);
+
+        for (size_t i(0); i < nws; ++i)
+        {
+            galera::TrxHandleMasterPtr trx(
+                galera::TrxHandleMaster::New(mp, trx_params, source, 1, i + 1),
+                galera::TrxHandleMasterDeleter());
+            trx->set_flags(galera::TrxHandle::F_BEGIN |
+                           galera::TrxHandle::F_COMMIT);
+
+            for (size_t k(0); k < nkeys; ++k)
+            {
+                uint64_t const row(rng() % keyspace);
+                wsrep_buf_t const parts[2] = {
+                    { "bench", 5 }, { &row, sizeof(row) } };
+                /* every 4th key is exclusive to generate dependencies */
+                wsrep_key_type_t const type(
+                    (row & 3) ? WSREP_KEY_REFERENCE : WSREP_KEY_EXCLUSIVE);
+                trx->append_key(galera::KeyData(version, parts, 2, type,
+                                                true));
+            }
+            trx->append_key(galera::KeyData(version));
+
+            galera::WriteSetNG::GatherVector out;
+            size_t const size(trx->write_set_out().gather(trx->source_id(),
+                                                          trx->conn_id(),
+                                                          trx->trx_id(),
+                                                          out));
+            trx->finalize(i); // everything before this trx is seen
+
+            wss[i].resize(size);
+            out.serialize(wss[i].data(), size);
+        }
+    }
+
+    double
+    run_bench(TestEnv& env, const std::vector<Buffer>& wss,
+              size_t const shards, size_t const ncommitters)
+    {
+        static size_t const purge_interval(256);
+
+        galera::TrxHandleSlave::Pool sp(
+            sizeof(galera::TrxHandleSlave), 1024, "cert_bench_sp");
+
+        env.conf().set(galera::Certification::PARAM_INDEX_SHARDS, shards);
+        galera::Certification cert(env.conf(), env.gcache(), 0);
+        cert.assign_initial_position(gu::GTID(), galera::WriteSetNG::VER6);
+
+        size_t const nws(wss.size());
+        std::vector<galera::TrxHandleSlavePtr> tss(nws);
+
+        for (size_t i(0); i < nws; ++i)
+        {
+            gcs_action const act = { wsrep_seqno_t(i + 1), wsrep_seqno_t(i + 1),
+                                     wss[i].data(),
+                                     static_cast<int32_t>(wss[i].size()),
+                                     GCS_ACT_WRITESET };
+            tss[i] = galera::TrxHandleSlavePtr(
+                galera::TrxHandleSlave::New(false, sp),
+                galera::TrxHandleSlaveDeleter());
+            tss[i]->unserialize<true, false>(env.gcache(), act);
+            cert.prepare_keys(*tss[i]); // done by receiving threads
+        }
+
+        std::atomic<size_t> certified(0);
+        std::atomic<size_t> next(0);
+
+        auto committer([&]()
+        {
+            for (size_t i(next++); i < nws; i = next++)
+            {
+                while (certified.load(std::memory_order_acquire) <= i)
+                    std::this_thread::yield();
+
+                cert.set_trx_committed(*tss[i]);
+
+                if (0 == (i % purge_interval))
+                {
+                    cert.purge_trxs_upto(cert.get_safe_to_discard_seqno(),
+                                         false);
+                }
+            }
+        });
+
+        auto const start(std::chrono::steady_clock::now());
+
+        std::vector<std::thread> committers;
+        for (size_t c(0); c < ncommitters; ++c)
+            committers.push_back(std::thread(committer));
+
+        for (size_t i(0); i < nws; ++i)
+        {
+            cert.append_trx(tss[i]);
+            certified.store(i + 1, std::memory_order_release);
+        }
+
+        for (auto& t : committers) t.join();
+
+        auto const stop(std::chrono::steady_clock::now());
+
+        cert.purge_trxs_upto(nws, false);
+
+        return std::chrono::duration<double>(stop - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    /* total number of keys certified in each run */
+    size_t const total_keys(argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 20);
+    size_t const committers(argc > 2 ? strtoul(argv[2], NULL, 10) : 4);
+
+    static size_t const keys[]   = { 1, 10, 100, 1000 };
+    static size_t const shards[] = { 1, 4, 16, 64 };
+
+    TestEnv env("cert_bench", false);
+
+    for (size_t k(0); k < sizeof(keys)/sizeof(keys[0]); ++k)
+    {
+        size_t const nws(std::max<size_t>(total_keys / keys[k], 1));
+        std::vector<Buffer> wss;
+        make_write_sets(wss, nws, keys[k], total_keys * 4);
+
+        for (size_t s(0); s < sizeof(shards)/sizeof(shards[0]); ++s)
+        {
+            double const duration(run_bench(env, wss, shards[s], committers));
+
+            std::cout << "keys/trx: "   << std::setw(4) << keys[k]
+                      << ", shards: "   << std::setw(2) << shards[s]
+                      << ", trxs: "     << nws
+                      << ", time: "     << duration << " s, "
+                      << std::fixed << std::setprecision(0)
+                      << nws/duration << " trx/s, "
+                      << nws*keys[k]/duration << " keys/s"
+                      << std::defaultfloat << std::setprecision(6)
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
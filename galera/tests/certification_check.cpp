@@ -14,6 +14,8 @@
 
 #include <check.h>
 
+#include <set>
+
 namespace
 {
     struct WSInfo
@@ -36,9 +38,11 @@ namespace
     };
 }
 
+/* write sets starting from fast_from use fast key hash, like after protocol
+ * upgrade */
 static
 void run_wsinfo(const WSInfo* const wsi, size_t const nws, int const version,
-                bool const enc)
+                bool const enc, size_t const fast_from = size_t(-1))
 {
     galera::TrxHandleMaster::Pool mp(
         sizeof(galera::TrxHandleMaster) + sizeof(galera::WriteSetOut),
@@ -54,6 +58,8 @@ void run_wsinfo(const WSInfo* const wsi, size_t const nws, int const version,
         cert.assign_initial_position(gu::GTID(), version);
         galera::TrxHandleMaster::Params const trx_params(
             "", version, galera::KeySet::MAX_VERSION);
+        galera::TrxHandleMaster::Params trx_params_fast(trx_params);
+        trx_params_fast.fast_key_hash_ = true;
 
         mark_point();
 
@@ -69,7 +75,8 @@ void run_wsinfo(const WSInfo* const wsi, size_t const nws, int const version,
 
             galera::TrxHandleMasterPtr trx(galera::TrxHandleMaster::New(
                                                mp,
-                                               trx_params,
+                                               i < fast_from ?
+                                               trx_params : trx_params_fast,
                                                wsi[i].uuid,
                                                wsi[i].conn_id,
                                                wsi[i].trx_id),
@@ -677,7 +684,293 @@ START_TEST(test_certification_zero_levelE)
 }
 END_TEST
 
+/* Keys hashed by different functions can't conflict in the index, so a write
+ * set must not overlap with write sets of the other hash family */
+static void
+certification_fast_key_hash(bool const enc)
+{
+    const int version(6);
+    using galera::Certification;
+    using galera::TrxHandle;
+    using galera::void_cast;
+
+    WSInfo wsi[] = {
+        // 1: MMH3 keys
+        { { {1, } }, 1, 1,
+          { {void_cast("1"), 1}, {void_cast("1"), 1}, {void_cast("1"), 1} }, 3, false,
+          1, 1, 0, 0, TrxHandle::F_BEGIN | TrxHandle::F_COMMIT,
+          galera::KeyData::BRANCH_KEY_TYPE,
+          Certification::TEST_OK, {0}, 0},
+        // 2: fast hash keys, did not see 1
+        { { {2, } }, 1, 2,
+          { {void_cast("1"), 1}, {void_cast("1"), 1}, {void_cast("1"), 1} }, 3, false,
+          2, 2, 0, -1, TrxHandle::F_BEGIN | TrxHandle::F_COMMIT,
+          galera::KeyData::BRANCH_KEY_TYPE,
+          Certification::TEST_FAILED, {0}, 0},
+        // 3: fast hash keys, saw 1
+        { { {2, } }, 1, 3,
+          { {void_cast("1"), 1}, {void_cast("1"), 1}, {void_cast("1"), 1} }, 3, false,
+          3, 3, 1, 1, TrxHandle::F_BEGIN | TrxHandle::F_COMMIT,
+          galera::KeyData::BRANCH_KEY_TYPE,
+          Certification::TEST_OK, {0}, 0},
+        // 4: fast hash keys, conflicts with 3
+        { { {1, } }, 1, 4,
+          { {void_cast("1"), 1}, {void_cast("1"), 1}, {void_cast("1"), 1} }, 3, false,
+          4, 4, 2, 3, TrxHandle::F_BEGIN | TrxHandle::F_COMMIT,
+          galera::KeyData::BRANCH_KEY_TYPE,
+          Certification::TEST_FAILED, {0}, 0},
+        // 5: fast hash keys, depends on 3
+        { { {1, } }, 1, 5,
+          { {void_cast("1"), 1}, {void_cast("1"), 1}, {void_cast("1"), 1} }, 3, true,
+          5, 5, 3, 3, TrxHandle::F_BEGIN | TrxHandle::F_COMMIT,
+          galera::KeyData::BRANCH_KEY_TYPE,
+          Certification::TEST_OK, {0}, 0},
+    };
+
+    size_t nws(sizeof(wsi)/sizeof(wsi[0]));
+
+    run_wsinfo(wsi, nws, version, enc, 1);
+}
+
+START_TEST(test_certification_fast_key_hash)
+{
+    certification_fast_key_hash(false);
+}
+END_TEST
+
+START_TEST(test_certification_fast_key_hashE)
+{
+    certification_fast_key_hash(true);
+}
+END_TEST
+
 using CertResult = galera::Certification::TestResult;
+/* Purge scheduled with service thread must be completed incrementally
+ * by the time service thread queue is flushed. */
+START_TEST(test_certification_incremental_purge)
+{
+    static int const version(galera::WriteSetNG::VER6);
+    static wsrep_seqno_t const nws(100);
+
+    galera::TrxHandleMaster::Pool mp(
+        sizeof(galera::TrxHandleMaster) + sizeof(galera::WriteSetOut),
+        16, "certification_mp");
+    galera::TrxHandleSlave::Pool sp(
+        sizeof(galera::TrxHandleSlave), 16, "certification_sp");
+    TestEnv env("cert", false);
+    galera::ServiceThd thd(env.gcs(), env.gcache());
+
+    {
+        /* single trx per purge step */
+        env.conf().set(galera::Certification::PARAM_PURGE_STEP_KEYS, "1");
+        galera::Certification cert(env.conf(), env.gcache(), &thd);
+
+        cert.assign_initial_position(gu::GTID(), version);
+        galera::TrxHandleMaster::Params const trx_params(
+            "", version, galera::KeySet::MAX_VERSION);
+        wsrep_uuid_t const source = { { 1, } };
+
+        for (wsrep_seqno_t seqno(1); seqno <= nws; ++seqno)
+        {
+            galera::TrxHandleMasterPtr trx(
+                galera::TrxHandleMaster::New(mp, trx_params, source, 1, seqno),
+                galera::TrxHandleMasterDeleter());
+            trx->set_flags(galera::TrxHandle::F_BEGIN |
+                           galera::TrxHandle::F_COMMIT);
+
+            wsrep_buf_t const key[1] = { { &seqno, sizeof(seqno) } };
+            trx->append_key(galera::KeyData(version, key, 1,
+                                            WSREP_KEY_EXCLUSIVE, true));
+            trx->append_key(galera::KeyData(version));
+
+            galera::WriteSetNG::GatherVector out;
+            size_t const size(trx->write_set_out().gather(trx->source_id(),
+                                                          trx->conn_id(),
+                                                          trx->trx_id(),
+                                                          out));
+            trx->finalize(seqno - 1);
+
+            void* ptx;
+            void* buf(env.gcache().malloc(size, ptx));
+            ck_assert(out.serialize(ptx, size) == size);
+            env.gcache().drop_plaintext(buf);
+
+            gcs_action const act = { seqno, seqno, buf,
+                                     static_cast<int32_t>(size),
+                                     GCS_ACT_WRITESET };
+            galera::TrxHandleSlavePtr ts(galera::TrxHandleSlave::New(false, sp),
+                                         galera::TrxHandleSlaveDeleter());
+            ck_assert(ts->unserialize<true>(env.gcache(), act) == size);
+
+            ck_assert(cert.append_trx(ts) ==
+                      galera::Certification::TEST_OK);
+            cert.set_trx_committed(*ts);
+
+            env.gcache().seqno_assign(buf, seqno, GCS_ACT_WRITESET, false);
+        }
+
+        wsrep_seqno_t const stds(cert.get_safe_to_discard_seqno());
+        ck_assert_int_eq(stds, nws - 1);
+
+        cert.purge_trxs_upto(stds, true);
+        thd.flush(gu::UUID());
+        ck_assert_int_eq(cert.lowest_trx_seqno(), nws);
+
+        gu::Status status;
+        cert.get_status(status);
+        ck_assert_int_eq(status.size(), 2);
+    }
+
+    env.gcache().seqno_release(nws);
+}
+END_TEST
+
+/* Certifies and commits a write set with a key unique to its seqno and
+ * assigns its buffer to gcache seqno. */
+static void
+append_committed_trx(galera::Certification&         cert,
+                     TestEnv&                       env,
+                     galera::TrxHandleMaster::Pool& mp,
+                     galera::TrxHandleSlave::Pool&  sp,
+                     int                      const version,
+                     wsrep_seqno_t                  seqno)
+{
+    galera::TrxHandleMaster::Params const trx_params(
+        "", version, galera::KeySet::MAX_VERSION);
+    wsrep_uuid_t const source = { { 1, } };
+
+    galera::TrxHandleMasterPtr trx(
+        galera::TrxHandleMaster::New(mp, trx_params, source, 1, seqno),
+        galera::TrxHandleMasterDeleter());
+    trx->set_flags(galera::TrxHandle::F_BEGIN | galera::TrxHandle::F_COMMIT);
+
+    wsrep_buf_t const key[1] = { { &seqno, sizeof(seqno) } };
+    trx->append_key(galera::KeyData(version, key, 1, WSREP_KEY_EXCLUSIVE,
+                                    true));
+
+    galera::WriteSetNG::GatherVector out;
+    size_t const size(trx->write_set_out().gather(trx->source_id(),
+                                                  trx->conn_id(),
+                                                  trx->trx_id(),
+                                                  out));
+    trx->finalize(seqno - 1);
+
+    void* ptx;
+    void* buf(env.gcache().malloc(size, ptx));
+    ck_assert(out.serialize(ptx, size) == size);
+    env.gcache().drop_plaintext(buf);
+
+    gcs_action const act = { seqno, seqno, buf, static_cast<int32_t>(size),
+                             GCS_ACT_WRITESET };
+    galera::TrxHandleSlavePtr ts(galera::TrxHandleSlave::New(false, sp),
+                                 galera::TrxHandleSlaveDeleter());
+    ck_assert(ts->unserialize<true>(env.gcache(), act) == size);
+
+    ck_assert(cert.append_trx(ts) == galera::Certification::TEST_OK);
+    cert.set_trx_committed(*ts);
+
+    env.gcache().seqno_assign(buf, seqno, GCS_ACT_WRITESET, false);
+}
+
+static size_t
+cert_index_size(galera::Certification& cert)
+{
+    double avg_cert_interval, avg_deps_dist;
+    size_t index_size;
+    cert.stats_get(avg_cert_interval, avg_deps_dist, index_size);
+    return index_size;
+}
+
+/* Purge steps remove index entries of the trxs they take off the trx map,
+ * several trxs per step, and leave the entries of the trxs above purge
+ * seqno. */
+START_TEST(test_certification_purge_step_index)
+{
+    static int const version(galera::WriteSetNG::VER6);
+    static wsrep_seqno_t const nws(100);
+
+    galera::TrxHandleMaster::Pool mp(
+        sizeof(galera::TrxHandleMaster) + sizeof(galera::WriteSetOut),
+        16, "certification_mp");
+    galera::TrxHandleSlave::Pool sp(
+        sizeof(galera::TrxHandleSlave), 16, "certification_sp");
+    TestEnv env("cert", false);
+    galera::ServiceThd thd(env.gcs(), env.gcache());
+
+    {
+        env.conf().set(galera::Certification::PARAM_PURGE_STEP_KEYS, "5");
+        galera::Certification cert(env.conf(), env.gcache(), &thd);
+        cert.assign_initial_position(gu::GTID(), version);
+
+        append_committed_trx(cert, env, mp, sp, version, 1);
+        size_t const trx_index_size(cert_index_size(cert));
+        ck_assert(trx_index_size > 0);
+
+        for (wsrep_seqno_t seqno(2); seqno <= nws; ++seqno)
+        {
+            append_committed_trx(cert, env, mp, sp, version, seqno);
+        }
+        ck_assert(cert_index_size(cert) > trx_index_size);
+
+        cert.purge_trxs_upto(nws - 1, true);
+        thd.flush(gu::UUID());
+        ck_assert_int_eq(cert.lowest_trx_seqno(), nws);
+
+        /* index size is sampled on certification */
+        append_committed_trx(cert, env, mp, sp, version, nws + 1);
+        ck_assert_int_eq(cert_index_size(cert), 2 * trx_index_size);
+    }
+
+    env.gcache().seqno_release(nws + 1);
+}
+END_TEST
+
+/* Synchronous purge requested while a purge is scheduled waits for the
+ * step in progress and purges the rest of the range itself. */
+START_TEST(test_certification_purge_step_sync)
+{
+    static int const version(galera::WriteSetNG::VER6);
+    static wsrep_seqno_t const nws(100);
+
+    galera::TrxHandleMaster::Pool mp(
+        sizeof(galera::TrxHandleMaster) + sizeof(galera::WriteSetOut),
+        16, "certification_mp");
+    galera::TrxHandleSlave::Pool sp(
+        sizeof(galera::TrxHandleSlave), 16, "certification_sp");
+    TestEnv env("cert", false);
+    galera::ServiceThd thd(env.gcs(), env.gcache());
+
+    {
+        /* single trx per purge step */
+        env.conf().set(galera::Certification::PARAM_PURGE_STEP_KEYS, "1");
+        galera::Certification cert(env.conf(), env.gcache(), &thd);
+        cert.assign_initial_position(gu::GTID(), version);
+
+        append_committed_trx(cert, env, mp, sp, version, 1);
+        size_t const trx_index_size(cert_index_size(cert));
+
+        for (wsrep_seqno_t seqno(2); seqno <= nws; ++seqno)
+        {
+            append_committed_trx(cert, env, mp, sp, version, seqno);
+        }
+
+        cert.purge_trxs_upto(nws/2, true);
+        cert.purge_trxs_upto(nws - 1, false);
+        ck_assert_int_eq(cert.lowest_trx_seqno(), nws);
+
+        /* scheduled purge finds nothing left to do */
+        thd.flush(gu::UUID());
+        ck_assert_int_eq(cert.lowest_trx_seqno(), nws);
+
+        /* index size is sampled on certification */
+        append_committed_trx(cert, env, mp, sp, version, nws + 1);
+        ck_assert_int_eq(cert_index_size(cert), 2 * trx_index_size);
+    }
+
+    env.gcache().seqno_release(nws + 1);
+}
+END_TEST
+
 struct CertFixture
 {
     gu::Config conf{};
@@ -720,11 +1013,27 @@ struct CertFixture
         galera::TrxHandleSlavePtr ts;
     };
 
-    CfCertResult append(const wsrep_uuid_t& node, wsrep_conn_id_t conn,
-                        wsrep_seqno_t last_seen,
-                        const std::vector<const char*>& key,
-                        wsrep_key_type_t type, int flags,
-                        const gu::byte_t* data_buf, size_t data_buf_len)
+    /* Create next ordered write set without certifying it. */
+    galera::TrxHandleSlavePtr make_ts(const wsrep_uuid_t& node,
+                                      wsrep_conn_id_t conn,
+                                      wsrep_seqno_t last_seen,
+                                      const std::vector<const char*>& key,
+                                      wsrep_key_type_t type, int flags,
+                                      const gu::byte_t* data_buf,
+                                      size_t data_buf_len)
+    {
+        std::vector<TestKey> keys{ TestKey{ version, type, key } };
+        return make_ts(node, conn, last_seen, keys, flags, data_buf,
+                       data_buf_len);
+    }
+
+    /* Same as above, with several keys. */
+    galera::TrxHandleSlavePtr make_ts(const wsrep_uuid_t& node,
+                                      wsrep_conn_id_t conn,
+                                      wsrep_seqno_t last_seen,
+                                      std::vector<TestKey>& keys, int flags,
+                                      const gu::byte_t* data_buf,
+                                      size_t data_buf_len)
     {
         galera::TrxHandleMasterPtr txm{ galera::TrxHandleMaster::New(
                                             mp,
@@ -734,8 +1043,7 @@ struct CertFixture
                                             node, conn, cur_trx_id),
                                         galera::TrxHandleMasterDeleter{} };
         txm->set_flags(flags);
-        TestKey tkey{ txm->version(), type, key };
-        txm->append_key(tkey());
+        for (auto& tkey : keys) txm->append_key(tkey());
         if (data_buf)
         {
             txm->append_data(data_buf, data_buf_len, WSREP_DATA_ORDERED, false);
@@ -754,6 +1062,19 @@ struct CertFixture
         galera::TrxHandleSlavePtr ts(galera::TrxHandleSlave::New(false, sp),
                                      galera::TrxHandleSlaveDeleter{});
         ck_assert(ts->unserialize<true>(gcache, act) == size);
+        return ts;
+    }
+
+    CfCertResult append(const wsrep_uuid_t& node, wsrep_conn_id_t conn,
+                        wsrep_seqno_t last_seen,
+                        const std::vector<const char*>& key,
+                        wsrep_key_type_t type, int flags,
+                        const gu::byte_t* data_buf, size_t data_buf_len,
+                        bool prepare = false)
+    {
+        galera::TrxHandleSlavePtr ts(make_ts(node, conn, last_seen, key, type,
+                                             flags, data_buf, data_buf_len));
+        if (prepare) cert.prepare_keys(*ts);
         auto result = cert.append_trx(ts);
         /* Mark committed here to avoid doing it in every test case. If the
          * ts is not marked as committed, the certification destructor will
@@ -772,6 +1093,18 @@ struct CertFixture
                       nullptr, 0);
     }
 
+    /* Like append_trx(), but keys are prepared before certification. */
+    CfCertResult append_trx_prepared(const wsrep_uuid_t& node,
+                                     wsrep_conn_id_t conn,
+                                     wsrep_seqno_t last_seen,
+                                     const std::vector<const char*>& key,
+                                     wsrep_key_type_t type)
+    {
+        return append(node, conn, last_seen, key, type,
+                      galera::TrxHandle::F_BEGIN | galera::TrxHandle::F_COMMIT,
+                      nullptr, 0, true);
+    }
+
     CfCertResult append_toi(const wsrep_uuid_t& node, wsrep_conn_id_t conn,
                             wsrep_seqno_t last_seen,
                             const std::vector<const char*>& key,
@@ -1535,6 +1868,186 @@ START_TEST(cert_certify_no_match)
 }
 END_TEST
 
+START_TEST(cert_certify_exact_deps)
+{
+    CertFixture f;
+    int const flags(galera::TrxHandle::F_BEGIN | galera::TrxHandle::F_COMMIT);
+    galera::TrxHandleSlavePtr const ts[] = {
+        f.make_ts(f.node1, f.conn1, 0, {"b", "l"}, WSREP_KEY_EXCLUSIVE,
+                  flags, nullptr, 0),
+        f.make_ts(f.node1, f.conn1, 0, {"b", "m"}, WSREP_KEY_EXCLUSIVE,
+                  flags, nullptr, 0),
+        f.make_ts(f.node2, f.conn2, 2, {"b", "m"}, WSREP_KEY_EXCLUSIVE,
+                  flags, nullptr, 0),
+        f.make_ts(f.node2, f.conn2, 3, {"b", "l"}, WSREP_KEY_SHARED,
+                  flags, nullptr, 0) };
+    size_t const n(sizeof(ts)/sizeof(ts[0]));
+    CertResult res[n];
+
+    res[0] = f.cert.append_trx(ts[0]);
+    ck_assert(!ts[0]->exact_deps()); // disabled by default
+
+    f.cert.param_set(galera::Certification::PARAM_EXACT_DEPS, "yes");
+    for (size_t i(1); i < n; ++i) res[i] = f.cert.append_trx(ts[i]);
+
+    for (size_t i(1); i < n; ++i) ck_assert_int_eq(res[i], CertResult::TEST_OK);
+
+    /* no conflicting predecessors */
+    ck_assert(ts[1]->exact_deps());
+    ck_assert_int_eq(ts[1]->deps_base(), 0);
+    ck_assert(ts[1]->deps().empty());
+
+    /* 3 depends on 2 only, but would wait for 1 too by depends_seqno */
+    ck_assert(ts[2]->exact_deps());
+    ck_assert_int_eq(ts[2]->depends_seqno(), 2);
+    ck_assert_int_eq(ts[2]->deps_base(), 0);
+    ck_assert_int_eq(ts[2]->deps().size(), 1);
+    ck_assert_int_eq(ts[2]->deps()[0], 2);
+
+    ck_assert(ts[3]->exact_deps());
+    ck_assert_int_eq(ts[3]->depends_seqno(), 1);
+    ck_assert_int_eq(ts[3]->deps().size(), 1);
+    ck_assert_int_eq(ts[3]->deps()[0], 1);
+
+    for (size_t i(0); i < n; ++i) ts[i]->mark_committed();
+}
+END_TEST
+
+/* Shared key holders don't depend on each other and only the latest one is
+ * referenced by the index, so exclusive key holder must wait for all of them
+ * by depends_seqno. */
+START_TEST(cert_certify_exact_deps_shared)
+{
+    CertFixture f;
+    f.cert.param_set(galera::Certification::PARAM_EXACT_DEPS, "yes");
+
+    int const flags(galera::TrxHandle::F_BEGIN | galera::TrxHandle::F_COMMIT);
+    galera::TrxHandleSlavePtr const ts[] = {
+        f.make_ts(f.node1, f.conn1, 0, {"b", "l"}, WSREP_KEY_SHARED,
+                  flags, nullptr, 0),
+        f.make_ts(f.node2, f.conn2, 0, {"b", "l"}, WSREP_KEY_SHARED,
+                  flags, nullptr, 0),
+        f.make_ts(f.node1, f.conn1, 2, {"b", "l"}, WSREP_KEY_EXCLUSIVE,
+                  flags, nullptr, 0) };
+    size_t const n(sizeof(ts)/sizeof(ts[0]));
+    CertResult res[n];
+
+    for (size_t i(0); i < n; ++i) res[i] = f.cert.append_trx(ts[i]);
+
+    for (size_t i(0); i < n; ++i) ck_assert_int_eq(res[i], CertResult::TEST_OK);
+
+    ck_assert(ts[0]->exact_deps());
+    ck_assert(ts[0]->deps().empty());
+    ck_assert(ts[1]->exact_deps());
+    ck_assert(ts[1]->deps().empty());
+
+    /* depends on both 1 and 2 */
+    ck_assert(!ts[2]->exact_deps());
+    ck_assert(ts[2]->deps().empty());
+    ck_assert_int_eq(ts[2]->depends_seqno(), 2);
+
+    for (size_t i(0); i < n; ++i) ts[i]->mark_committed();
+}
+END_TEST
+
+START_TEST(cert_certify_exclusive_exclusive_prepared)
+{
+    CertFixture f;
+    auto res = f.append_trx_prepared(f.node1, f.conn1, 0, {"b", "l"},
+                                     WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(res.result, CertResult::TEST_OK);
+    ck_assert_int_eq(res.ts->cert_keys().size(),
+                     res.ts->write_set().keyset().count());
+    res = f.append_trx_prepared(f.node2, f.conn2, 0, {"b", "l"},
+                                WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(res.result, CertResult::TEST_FAILED);
+    ck_assert_int_eq(res.ts->depends_seqno(), 1);
+    res = f.append_trx_prepared(f.node2, f.conn2, 2, {"b", "l"},
+                                WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(res.result, CertResult::TEST_OK);
+    ck_assert_int_eq(res.ts->depends_seqno(), 1);
+}
+END_TEST
+
+/* Keys of a write set are spread over several index shards, conflicts and
+ * dependencies must be found in any of them. */
+START_TEST(cert_certify_sharded)
+{
+    static int const nkeys(16);
+
+    CertFixture f;
+    f.conf.set(galera::Certification::PARAM_INDEX_SHARDS, "4");
+    galera::Certification cert(f.conf, f.gcache, 0);
+    cert.assign_initial_position(gu::GTID(), f.version);
+    int const flags(galera::TrxHandle::F_BEGIN | galera::TrxHandle::F_COMMIT);
+
+    std::vector<std::string> rows;
+    for (int i(0); i < nkeys; ++i) rows.push_back(std::to_string(i));
+
+    /* seqnos 1 - 16, one key each */
+    for (int i(0); i < nkeys; ++i)
+    {
+        galera::TrxHandleSlavePtr const ts(
+            f.make_ts(f.node1, f.conn1, 0, { "t", rows[i].c_str() },
+                      WSREP_KEY_EXCLUSIVE, flags, nullptr, 0));
+        ck_assert_int_eq(cert.append_trx(ts), CertResult::TEST_OK);
+        ts->mark_committed();
+    }
+
+    /* includes entries for the common key prefix */
+    double avg_cert_interval, avg_deps_dist;
+    size_t index_size;
+    cert.stats_get(avg_cert_interval, avg_deps_dist, index_size);
+    size_t const prev_index_size(index_size);
+    ck_assert(prev_index_size > size_t(nkeys));
+
+    /* depends on all of the above, the latest one determines depends_seqno */
+    std::vector<TestKey> keys;
+    for (int i(0); i < nkeys; ++i)
+    {
+        keys.push_back(TestKey(f.version, WSREP_KEY_REFERENCE,
+                               { "t", rows[i].c_str() }));
+    }
+    galera::TrxHandleSlavePtr ts(f.make_ts(f.node2, f.conn2, nkeys, keys,
+                                           flags, nullptr, 0));
+    ck_assert_int_eq(cert.append_trx(ts), CertResult::TEST_OK);
+    ck_assert_int_eq(ts->depends_seqno(), nkeys);
+    ts->mark_committed();
+
+    std::set<size_t> shards;
+    for (const auto& kp : ts->cert_keys()) shards.insert(kp.hash() & 3);
+    ck_assert(shards.size() > 1);
+
+    /* non-conflicting keys in all shards and a conflicting one in the middle
+     * of the range */
+    keys.clear();
+    for (int i(0); i < nkeys; ++i)
+    {
+        keys.push_back(TestKey(f.version, WSREP_KEY_EXCLUSIVE,
+                               { "u", rows[i].c_str() }));
+    }
+    keys.push_back(TestKey(f.version, WSREP_KEY_EXCLUSIVE,
+                           { "t", rows[nkeys/2].c_str() }));
+    ts = f.make_ts(f.node2, f.conn2, 0, keys, flags, nullptr, 0);
+    ck_assert_int_eq(cert.append_trx(ts), CertResult::TEST_FAILED);
+    ck_assert(ts->depends_seqno() >= nkeys/2 + 1);
+    ts->mark_committed();
+
+    /* failed certification leaves no keys in any shard */
+    cert.stats_get(avg_cert_interval, avg_deps_dist, index_size);
+    ck_assert_int_eq(index_size, prev_index_size);
+
+    /* same keys certify after the conflicting write set was seen,
+     * exclusive key depends on the reference one */
+    ts = f.make_ts(f.node2, f.conn2, nkeys + 1, keys, flags, nullptr, 0);
+    ck_assert_int_eq(cert.append_trx(ts), CertResult::TEST_OK);
+    ck_assert_int_eq(ts->depends_seqno(), nkeys + 1);
+    ts->mark_committed();
+
+    cert.stats_get(avg_cert_interval, avg_deps_dist, index_size);
+    ck_assert(index_size > prev_index_size + nkeys);
+}
+END_TEST
 
 Suite* certification_suite()
 {
@@ -1571,6 +2084,17 @@ Suite* certification_suite()
     tcase_add_test(t, test_certification_zero_levelE);
     suite_add_tcase(s, t);
 
+    t = tcase_create("certification_fast_key_hash");
+    tcase_add_test(t, test_certification_fast_key_hash);
+    tcase_add_test(t, test_certification_fast_key_hashE);
+    suite_add_tcase(s, t);
+
+    t = tcase_create("certification_purge");
+    tcase_add_test(t, test_certification_incremental_purge);
+    tcase_add_test(t, test_certification_purge_step_index);
+    tcase_add_test(t, test_certification_purge_step_sync);
+    suite_add_tcase(s, t);
+
     t = tcase_create("certification_rules");
     tcase_add_test(t, cert_append_trx);
     tcase_add_test(t, cert_certify_shared_shared);
@@ -1624,6 +2148,10 @@ Suite* certification_suite()
     tcase_add_test(t, cert_certify_shared_shared_pa_unsafe);
     tcase_add_test(t, cert_certify_no_match_pa_unsafe);
     tcase_add_test(t, cert_certify_no_match);
+    tcase_add_test(t, cert_certify_exclusive_exclusive_prepared);
+    tcase_add_test(t, cert_certify_exact_deps);
+    tcase_add_test(t, cert_certify_exact_deps_shared);
+    tcase_add_test(t, cert_certify_sharded);
 
     suite_add_tcase(s, t);
 
@@ -1,4 +1,4 @@
-/* Copyright (C) 2013-2023 Codership Oy <info@codership.com>
+/* Copyright (C) 2013-2026 Codership Oy <info@codership.com>
  *
  * $Id$
  */
@@ -242,6 +242,107 @@ static void test_ver(gu::RecordSet::Version const rsv)
     }
 }
 
+/* serializes dset_out and returns the data read back from it */
+static std::vector<gu::byte_t>
+test_ver2_read(DataSetOut& dset_out, std::vector<gu::byte_t>& in_buf)
+{
+    DataSetOut::GatherVector out_bufs;
+    size_t const out_size(dset_out.gather(out_bufs));
+
+    in_buf.clear();
+    for (size_t i = 0; i < out_bufs->size(); ++i)
+    {
+        const gu::byte_t* ptr
+            (reinterpret_cast<const gu::byte_t*>(out_bufs[i].ptr));
+        in_buf.insert (in_buf.end(), ptr, ptr + out_bufs[i].size);
+    }
+    ck_assert(in_buf.size() == out_size);
+
+    ck_assert(DataSet::VER2 == dset_out.version());
+    galera::DataSetIn const dset_in(dset_out.version(),
+                                    in_buf.data(), in_buf.size());
+    ck_assert(1 == dset_in.count());
+    try { dset_in.checksum(); }
+    catch(gu::Exception& e) { ck_abort_msg("%s", e.what()); }
+
+    gu::Buf const data(dset_in.next());
+    const gu::byte_t* const ptr(static_cast<const gu::byte_t*>(data.ptr));
+
+    /* decompressed data must stay put on repeated reads */
+    dset_in.rewind();
+    ck_assert(dset_in.next().ptr == data.ptr);
+
+    return std::vector<gu::byte_t>(ptr, ptr + data.size);
+}
+
+static void test_ver2(gu::RecordSet::Version const rsv)
+{
+    /* compressible records: 2 stored and 1 referenced */
+    TestRecord rout0(4096,   "row image 0");
+    TestRecord rout1(100000, "row image 1");
+    TestRecord rout2(300,    "row image 2");
+
+    std::vector<gu::byte_t> expected;
+    const TestRecord* const records[] = { &rout0, &rout1, &rout2 };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const gu::byte_t* const ptr
+            (static_cast<const gu::byte_t*>(records[i]->buf()));
+        expected.insert(expected.end(), ptr, ptr + records[i]->serial_size());
+    }
+
+    union { gu::byte_t buf[1024]; gu_word_t align; } reserved;
+    TestBaseName str("data_set_test");
+    std::vector<gu::byte_t> in_buf;
+
+    {
+        DataSetOut dset_out(reserved.buf, sizeof(reserved.buf), str,
+                            DataSet::VER2, rsv);
+        dset_out.set_compression(gu::Compression::LZ4, 1024);
+
+        size_t offset(dset_out.size());
+        offset += dset_out.append(rout0.buf(), rout0.serial_size(), true);
+        offset += dset_out.append(rout1.buf(), rout1.serial_size(), false);
+        offset += dset_out.append(rout2.buf(), rout2.serial_size(), true);
+        ck_assert(dset_out.size() == offset);
+
+        ck_assert(dset_out.compress());
+        ck_assert(test_ver2_read(dset_out, in_buf) == expected);
+        ck_assert_msg(in_buf.size() < expected.size()/4,
+                      "compressed size %zu, raw size %zu",
+                      in_buf.size(), expected.size());
+    }
+
+    /* below threshold: VER2 data set is sent as is */
+    {
+        DataSetOut dset_out(reserved.buf, sizeof(reserved.buf), str,
+                            DataSet::VER2, rsv);
+        dset_out.set_compression(gu::Compression::LZ4, 2 * expected.size());
+
+        dset_out.append(rout0.buf(), rout0.serial_size(), true);
+        dset_out.append(rout1.buf(), rout1.serial_size(), false);
+        dset_out.append(rout2.buf(), rout2.serial_size(), true);
+
+        ck_assert(!dset_out.compress());
+        ck_assert(test_ver2_read(dset_out, in_buf) == expected);
+        ck_assert(in_buf.size() > expected.size());
+    }
+
+    /* incompressible data is sent as is */
+    {
+        std::vector<gu::byte_t> noise(8192);
+        for (size_t i = 0; i < noise.size(); ++i) noise[i] = ::rand();
+
+        DataSetOut dset_out(reserved.buf, sizeof(reserved.buf), str,
+                            DataSet::VER2, rsv);
+        dset_out.set_compression(gu::Compression::LZ4, 0);
+        dset_out.append(noise.data(), noise.size(), false);
+
+        ck_assert(!dset_out.compress());
+        ck_assert(test_ver2_read(dset_out, in_buf) == noise);
+    }
+}
+
 #ifndef GALERA_ONLY_ALIGNED
 START_TEST (ver1)
 {
@@ -256,6 +357,33 @@ START_TEST (ver2)
 }
 END_TEST
 
+START_TEST (ver2_compressed)
+{
+    test_ver2(gu::RecordSet::VER2);
+}
+END_TEST
+
+/* only compression supported by every node is accepted for data sets */
+START_TEST (ver2_compression_types)
+{
+    ck_assert(DataSet::compression("none") == gu::Compression::NONE);
+    if (gu::Compression::supported(gu::Compression::LZ4))
+    {
+        ck_assert(DataSet::compression("lz4") == gu::Compression::LZ4);
+    }
+
+    try
+    {
+        DataSet::compression("zstd");
+        ck_abort_msg("zstd data set compression accepted");
+    }
+    catch (gu::Exception& e)
+    {
+        ck_assert(EINVAL == e.get_errno());
+    }
+}
+END_TEST
+
 Suite* data_set_suite ()
 {
     TCase* t = tcase_create ("DataSet");
@@ -263,6 +391,11 @@ Suite* data_set_suite ()
     tcase_add_test (t, ver1);
 #endif
     tcase_add_test (t, ver2);
+    if (gu::Compression::supported(gu::Compression::LZ4))
+    {
+        tcase_add_test (t, ver2_compressed);
+    }
+    tcase_add_test (t, ver2_compression_types);
     tcase_set_timeout(t, 60);
 
     Suite* s = suite_create ("DataSet");
@@ -30,8 +30,11 @@ static const char* Defaults[] =
 {
     "base_dir",                    ".",
     "base_port",                   "4567",
+    "cert.exact_deps",             "no",
+    "cert.index_shards",           "16",
     "cert.log_conflicts",          "no",
     "cert.optimistic_pa",          "yes",
+    "cert.purge_step_keys",        "10000",
     "debug",                       "no",
 #ifdef GU_DBUG_ON
     "dbug",                        "",
@@ -55,6 +58,12 @@ static const char* Defaults[] =
     "evs.user_send_window",        "2",
     "evs.version",                 "1",
     "evs.view_forget_timeout",     "P1D",
+#ifdef GALERA_HAVE_LZ4
+    "gcache.cold_compression",     "lz4",
+#else
+    "gcache.cold_compression",     "none",
+#endif
+    "gcache.cold_size",            "0",
 #ifndef NDEBUG
     "gcache.debug",                "0",
 #endif
@@ -64,6 +73,7 @@ static const char* Defaults[] =
     "gcache.mem_size",             "0",
     "gcache.name",                 "galera.cache",
     "gcache.page_size",            "128M",
+    "gcache.prealloc_pages",       "0",
     "gcache.recover",              "yes",
     "gcache.size",                 "128M",
     "gcomm.thread_prio",           "",
@@ -102,10 +112,18 @@ static const char* Defaults[] =
     "pc.weight",                   "1",
     "protonet.version",            "0",
     "repl.causal_read_timeout",    "PT30S",
+    "repl.checksum_queue",         "128",
+    "repl.checksum_threads",       "2",
+    "repl.checksum_threshold",     "65536",
     "repl.commit_order",           "3",
+    "repl.data_compression",       "none",
+    "repl.data_compression_threshold", "4096",
     "repl.key_format",             "FLAT8",
     "repl.max_ws_size",            "2147483647",
-    "repl.proto_max",              "11",
+    "repl.monitor_window",         "65536",
+    "repl.page_pool_huge",         "no",
+    "repl.page_pool_size",         "16M",
+    "repl.proto_max",              "14",
 #ifdef GU_DBUG_ON
     "signal",                      "",
 #endif
@@ -156,6 +174,35 @@ fill_in_real(DefaultsMap& map, wsrep_t& provider)
     }
 }
 
+/* status variables added to the fixed list go after the existing ones */
+static void
+check_stats(wsrep_t& provider)
+{
+    struct wsrep_stats_var* const stats(provider.stats_get(&provider));
+    ck_assert(NULL != stats);
+
+    int incoming(-1), fragments(-1), fragment_bytes(-1);
+    for (int i(0); stats[i].name != NULL; ++i)
+    {
+        std::string const name(stats[i].name);
+
+        if      (name == "incoming_addresses")  incoming       = i;
+        else if (name == "repl_fragments")      fragments      = i;
+        else if (name == "repl_fragment_bytes") fragment_bytes = i;
+    }
+
+    ck_assert_msg(incoming > 0, "incoming_addresses not found");
+    ck_assert_int_eq(fragments, incoming + 1);
+    ck_assert_int_eq(fragment_bytes, incoming + 2);
+
+    ck_assert(WSREP_VAR_INT64 == stats[fragments].type);
+    ck_assert_int_eq(stats[fragments].value._int64, 0);
+    ck_assert(WSREP_VAR_INT64 == stats[fragment_bytes].type);
+    ck_assert_int_eq(stats[fragment_bytes].value._int64, 0);
+
+    provider.stats_free(&provider, stats);
+}
+
 static void
 log_cb(wsrep_log_level_t l, const char* c)
 {
@@ -295,6 +342,9 @@ defaults(bool const enc)
     fill_in_real(real_defaults, provider);
     mark_point();
 
+    check_stats(provider);
+    mark_point();
+
     if (WSREP_OK == ret) /* if connect() was a success, need to disconnect() */
     {
         /* some configuration change events need to be received */
@@ -0,0 +1,104 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+/**
+ * This is to benchmark galera::DepsSet against std::multiset it replaced
+ * in certification.
+ *
+ * The workload follows certification: every write set inserts its last seen
+ * seqno, which lags behind the write set seqno by a random distance, the
+ * minimum is queried, and a random one of the write sets in flight commits
+ * and erases its last seen seqno.
+ *
+ * Usage: deps_set_bench [operations] [in_flight]
+ */
+
+#include "deps_set.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    /* the way Certification used std::multiset */
+    class MultisetDepsSet
+    {
+    public:
+        MultisetDepsSet() : set_() {}
+
+        void insert(wsrep_seqno_t const s) { set_.insert(set_.end(), s); }
+        void erase(wsrep_seqno_t const s)  { set_.erase(set_.find(s)); }
+        wsrep_seqno_t min() const          { return *set_.begin(); }
+
+    private:
+        std::multiset<wsrep_seqno_t> set_;
+    };
+
+    template <class Set>
+    double
+    run_bench(size_t const ops, size_t const in_flight, wsrep_seqno_t& sum)
+    {
+        Set set;
+        std::vector<wsrep_seqno_t> last_seen;
+        std::mt19937_64 rng(in_flight);
+
+        last_seen.reserve(in_flight + 1);
+
+        auto const start(std::chrono::steady_clock::now());
+
+        for (size_t i(0); i < ops; ++i)
+        {
+            wsrep_seqno_t const seqno(i + 1);
+            wsrep_seqno_t const ls(
+                std::max<wsrep_seqno_t>(seqno - 1 -
+                                        wsrep_seqno_t(rng() % (in_flight + 1)),
+                                        0));
+
+            set.insert(ls);
+            last_seen.push_back(ls);
+
+            sum += set.min();
+
+            if (last_seen.size() > in_flight)
+            {
+                size_t const c(rng() % last_seen.size());
+                set.erase(last_seen[c]);
+                last_seen[c] = last_seen.back();
+                last_seen.pop_back();
+            }
+        }
+
+        auto const stop(std::chrono::steady_clock::now());
+
+        for (size_t i(0); i < last_seen.size(); ++i) set.erase(last_seen[i]);
+
+        return std::chrono::duration<double>(stop - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t const ops(argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 24);
+    size_t const in_flight_max(argc > 2 ? strtoul(argv[2], NULL, 10) : 1024);
+
+    wsrep_seqno_t sum(0); // to prevent optimizing out
+
+    for (size_t in_flight(4); in_flight <= in_flight_max; in_flight *= 4)
+    {
+        double const ms(run_bench<MultisetDepsSet>(ops, in_flight, sum));
+        double const ds(run_bench<galera::DepsSet>(ops, in_flight, sum));
+
+        std::cout << "in flight: " << in_flight
+                  << ", std::multiset: " << ops/ms << " ops/s"
+                  << ", DepsSet: "       << ops/ds << " ops/s"
+                  << ", speedup: "       << ms/ds << std::endl;
+    }
+
+    return (sum == 0); // never true, only to keep the minimum queries
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "../src/deps_set.hpp"
+
+#include <check.h>
+
+using namespace galera;
+
+START_TEST(deps_set_insert_erase)
+{
+    DepsSet ds;
+    ck_assert(ds.empty());
+
+    ds.insert(5);
+    ds.insert(5);
+    ds.insert(7);
+    ds.insert(3); // below current minimum
+    ck_assert_int_eq(ds.size(), 4);
+    ck_assert_int_eq(ds.min(), 3);
+
+    ds.erase(5); // one of two
+    ck_assert_int_eq(ds.size(), 3);
+    ck_assert_int_eq(ds.min(), 3);
+
+    ds.erase(3);
+    ck_assert_int_eq(ds.min(), 5);
+
+    ds.erase(5); // leaves a hole at 6 in front
+    ck_assert_int_eq(ds.min(), 7);
+
+    ds.insert(6); // fills a hole
+    ck_assert_int_eq(ds.min(), 6);
+
+    ds.erase(7);
+    ds.erase(6);
+    ck_assert(ds.empty());
+
+    ds.insert(100); // far away from the previous window
+    ck_assert_int_eq(ds.min(), 100);
+    ck_assert_int_eq(ds.size(), 1);
+}
+END_TEST
+
+/* Seqnos committed out of order must not affect the minimum until
+ * the lowest one is erased. */
+START_TEST(deps_set_out_of_order)
+{
+    static wsrep_seqno_t const n(1000);
+
+    DepsSet ds;
+
+    for (wsrep_seqno_t i(0); i < n; ++i) ds.insert(i / 2);
+
+    for (wsrep_seqno_t i(n - 1); i >= 2; --i)
+    {
+        ds.erase(i / 2);
+        ck_assert_int_eq(ds.min(), 0);
+    }
+
+    ds.erase(0);
+    ck_assert_int_eq(ds.min(), 0);
+    ds.erase(0);
+    ck_assert(ds.empty());
+}
+END_TEST
+
+Suite* deps_set_suite()
+{
+    TCase* t = tcase_create ("DepsSet");
+    tcase_add_test (t, deps_set_insert_erase);
+    tcase_add_test (t, deps_set_out_of_order);
+
+    Suite* s = suite_create ("DepsSet");
+    suite_add_tcase (s, t);
+
+    return s;
+}
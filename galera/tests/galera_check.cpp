@@ -14,6 +14,8 @@ typedef Suite* (*suite_creator_t) (void);
 
 extern Suite* data_set_suite();
 extern Suite* key_set_suite();
+extern Suite* key_entry_table_suite();
+extern Suite* deps_set_suite();
 extern Suite* write_set_ng_suite();
 extern Suite* certification_suite();
 //extern Suite* write_set_suite();
@@ -23,11 +25,14 @@ extern Suite* ist_suite();
 extern Suite* saved_state_suite();
 extern Suite* defaults_suite();
 extern Suite* progress_suite();
+extern Suite* monitor_suite();
 
 static suite_creator_t suites[] =
 {
     data_set_suite,
     key_set_suite,
+    key_entry_table_suite,
+    deps_set_suite,
     write_set_ng_suite,
     certification_suite,
     trx_handle_suite,
@@ -36,6 +41,7 @@ static suite_creator_t suites[] =
     saved_state_suite,
     defaults_suite,
     progress_suite,
+    monitor_suite,
     0
 };
 
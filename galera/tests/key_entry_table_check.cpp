@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "../src/key_entry_table.hpp"
+
+#include <check.h>
+
+#include <vector>
+
+using namespace galera;
+
+namespace
+{
+    /* Storage for serialized FLAT16 key part made of given hash words.
+     * Lower bits of the first word are overwritten by key part header. */
+    class RawKey
+    {
+    public:
+        RawKey(uint64_t const w0, uint64_t const w1) : data_()
+        {
+            uint64_t const w[2] =
+                { gu::htog((w0 << 5) | (KeySet::FLAT16 << 2)),
+                  gu::htog(w1) };
+            ::memcpy(data_.buf, w, sizeof(w));
+        }
+
+        KeySet::KeyPart key() const { return KeySet::KeyPart(data_.buf); }
+
+    private:
+        KeySet::KeyPart::HashData data_;
+    };
+}
+
+START_TEST(ket_insert_find_erase)
+{
+    KeyEntryTable table;
+    RawKey const k1(1, 1), k2(2, 2), k1b(1, 2) /* same first word as k1 */;
+
+    ck_assert(table.empty());
+    ck_assert(table.find(k1.key()) == NULL);
+
+    std::pair<KeyEntryNG*, bool> ret(table.insert(k1.key()));
+    ck_assert(ret.second);
+    ck_assert(ret.first->matches(k1.key()));
+    ck_assert_int_eq(table.size(), 1);
+
+    ret = table.insert(k1.key());
+    ck_assert(!ret.second);
+    ck_assert_int_eq(table.size(), 1);
+
+    ck_assert(table.find(k2.key()) == NULL);
+    ck_assert(table.find(k1b.key()) == NULL);
+
+    ret = table.insert(k1b.key());
+    ck_assert(ret.second);
+    ck_assert_int_eq(table.size(), 2);
+    ck_assert(table.find(k1b.key()) == ret.first);
+    ck_assert(table.find(k1.key()) != ret.first);
+
+    table.erase(table.find(k1.key()));
+    ck_assert_int_eq(table.size(), 1);
+    ck_assert(table.find(k1.key()) == NULL);
+    ck_assert(table.find(k1b.key()) != NULL);
+
+    table.clear();
+    ck_assert(table.empty());
+    ck_assert(table.find(k1b.key()) == NULL);
+}
+END_TEST
+
+/* Keys which differ only in upper bits, like keys of the same index shard,
+ * with interleaved erasures to exercise deleted slot reuse and rehash. */
+START_TEST(ket_grow_and_purge)
+{
+    static size_t const n(10000);
+
+    KeyEntryTable table;
+    std::vector<RawKey> keys;
+    keys.reserve(n);
+
+    for (size_t i(0); i < n; ++i)
+    {
+        keys.push_back(RawKey(i << 16, i));
+        ck_assert(table.insert(keys[i].key()).second);
+
+        /* purge entries lagging behind by 100 */
+        if (i >= 100 && i % 3)
+        {
+            KeyEntryNG* const ke(table.find(keys[i - 100].key()));
+            ck_assert(ke != NULL);
+            table.erase(ke);
+        }
+    }
+
+    size_t found(0);
+    for (size_t i(0); i < n; ++i)
+    {
+        KeyEntryNG* const ke(table.find(keys[i].key()));
+        bool const erased(i < n - 100 && (i + 100) % 3);
+        ck_assert_msg(erased == (ke == NULL), "key %zu", i);
+        if (ke)
+        {
+            ck_assert(ke->matches(keys[i].key()));
+            ++found;
+        }
+    }
+
+    ck_assert_int_eq(found, table.size());
+
+    size_t counted(0);
+    table.for_each([&counted](const KeyEntryNG&) { ++counted; });
+    ck_assert_int_eq(counted, table.size());
+
+    /* table grows only with the number of live entries */
+    ck_assert(table.capacity() < n);
+}
+END_TEST
+
+/* After a burst of keys is purged, the table shrinks back and remaining
+ * entries stay reachable. */
+START_TEST(ket_shrink)
+{
+    static size_t const n(10000);
+    static size_t const left(10);
+
+    KeyEntryTable table;
+    std::vector<RawKey> keys;
+    keys.reserve(n);
+
+    for (size_t i(0); i < n; ++i)
+    {
+        keys.push_back(RawKey(i << 16, i));
+        ck_assert(table.insert(keys[i].key()).second);
+    }
+
+    size_t const peak(table.capacity());
+    ck_assert(peak >= n);
+
+    for (size_t i(0); i < n - left; ++i)
+    {
+        KeyEntryNG* const ke(table.find(keys[i].key()));
+        ck_assert(ke != NULL);
+        table.erase(ke);
+    }
+
+    ck_assert_int_eq(table.size(), left);
+    ck_assert_msg(table.capacity() <= 8 * left, "capacity %zu",
+                  table.capacity());
+
+    for (size_t i(0); i < n; ++i)
+    {
+        ck_assert((table.find(keys[i].key()) != NULL) == (i >= n - left));
+    }
+
+    /* steady insert/erase churn does not let deleted slots pile up */
+    for (size_t i(0); i < n - left; ++i)
+    {
+        ck_assert(table.insert(keys[i].key()).second);
+        table.erase(table.find(keys[i].key()));
+    }
+
+    ck_assert_int_eq(table.size(), left);
+    ck_assert(table.capacity() <= 8 * left);
+}
+END_TEST
+
+Suite* key_entry_table_suite()
+{
+    TCase* t = tcase_create ("KeyEntryTable");
+    tcase_add_test (t, ket_insert_find_erase);
+    tcase_add_test (t, ket_grow_and_purge);
+    tcase_add_test (t, ket_shrink);
+
+    Suite* s = suite_create ("KeyEntryTable");
+    suite_add_tcase (s, t);
+
+    return s;
+}
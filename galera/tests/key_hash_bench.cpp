@@ -0,0 +1,127 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+/**
+ * This is to benchmark KeySetOut key hash policies: MMH3 (KeySet versions
+ * FLAT8 - FLAT16A) against XXH3-128 (versions FLAT8X and up).
+ *
+ * The workload mimics point updates: keys of 3 parts (schema, table, primary
+ * key) where only the last part varies. It is measured twice: hashing alone
+ * and complete KeySetOut::append() of a small write set.
+ *
+ * Usage: key_hash_bench [keys] [pk_size]
+ */
+
+#include "key_set.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using galera::KeySet;
+using galera::KeySetOut;
+
+namespace
+{
+    class BenchBaseName : public gu::Allocator::BaseName
+    {
+    public:
+        void print(std::ostream& os) const { os << "key_hash_bench"; }
+    };
+
+    const char schema[] = "sbtest";
+    const char table[]  = "sbtest1";
+
+    template <class H>
+    double
+    run_hash(size_t const keys, std::vector<gu::byte_t>& pk, uint64_t& sum)
+    {
+        auto const start(std::chrono::steady_clock::now());
+
+        for (size_t i(0); i < keys; ++i)
+        {
+            ::memcpy(pk.data(), &i, std::min(sizeof(i), pk.size()));
+
+            KeySetOut::KeyHash h;
+            KeySet::KeyPart::HashData hd;
+
+            H::init(h);
+            H::append(h, schema, sizeof(schema) - 1);
+            H::gather(h, hd);
+            sum += hd.buf[1];
+            H::append(h, table, sizeof(table) - 1);
+            H::gather(h, hd);
+            sum += hd.buf[1];
+            H::append(h, pk.data(), pk.size());
+            H::gather(h, hd);
+            sum += hd.buf[1];
+        }
+
+        auto const stop(std::chrono::steady_clock::now());
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+    /* KeySetOut::append() for write sets of 8 keys */
+    double
+    run_append(KeySet::Version const ver, size_t const keys,
+               std::vector<gu::byte_t>& pk, uint64_t& sum)
+    {
+        static size_t const ws_keys(8);
+        BenchBaseName const base_name;
+
+        auto const start(std::chrono::steady_clock::now());
+
+        for (size_t i(0); i < keys; i += ws_keys)
+        {
+            union { gu::byte_t buf[4096]; gu_word_t align; } reserved;
+            KeySetOut kso(reserved.buf, sizeof(reserved.buf), base_name, ver,
+                          gu::RecordSet::VER2, KeySet::WS_VER_MAX);
+
+            for (size_t k(i); k < i + ws_keys; ++k)
+            {
+                ::memcpy(pk.data(), &k, std::min(sizeof(k), pk.size()));
+
+                wsrep_buf_t const parts[3] =
+                {
+                    { schema,    sizeof(schema) - 1 },
+                    { table,     sizeof(table)  - 1 },
+                    { pk.data(), pk.size() }
+                };
+
+                galera::KeyData const kd(KeySet::WS_VER_MAX, parts, 3,
+                                         WSREP_KEY_EXCLUSIVE, true);
+                sum += kso.append(kd);
+            }
+        }
+
+        auto const stop(std::chrono::steady_clock::now());
+        return std::chrono::duration<double>(stop - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t const keys(argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 22);
+    size_t const pk_size(argc > 2 ? strtoul(argv[2], NULL, 10) : 8);
+
+    std::vector<gu::byte_t> pk(pk_size, 0);
+    uint64_t sum(0); // to prevent optimizing out
+
+    double const hm(run_hash<KeySetOut::KeyHashMMH>(keys, pk, sum));
+    double const hf(run_hash<KeySetOut::KeyHashXXH>(keys, pk, sum));
+
+    std::cout << "hash:   MMH3: " << keys/hm << " keys/s"
+              << ", XXH3: "       << keys/hf << " keys/s"
+              << ", speedup: "    << hm/hf << std::endl;
+
+    double const am(run_append(KeySet::FLAT16A,  keys, pk, sum));
+    double const af(run_append(KeySet::FLAT16XA, keys, pk, sum));
+
+    std::cout << "append: FLAT16A: " << keys/am << " keys/s"
+              << ", FLAT16XA: "      << keys/af << " keys/s"
+              << ", speedup: "       << am/af << std::endl;
+
+    return (sum == 0); // never true, only to keep the results
+}
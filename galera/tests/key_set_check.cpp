@@ -11,6 +11,7 @@
 
 #include "gu_logger.hpp"
 #include "gu_hexdump.hpp"
+#include "gu_crc32c.h"
 
 #include <check.h>
 
@@ -34,17 +35,18 @@ static size_t version_to_hash_size (KeySet::Version const ver)
     case KeySet::FLAT16A: return 16;
     case KeySet::FLAT8:   ck_abort_msg( "FLAT8 is not supported by test");
     case KeySet::FLAT8A:  return 8;
+    case KeySet::FLAT16XA: return 16;
     default:              ck_abort_msg("Unsupported KeySet verison: %d", ver);
     }
 
     abort();
 }
 
-static void test_ver(gu::RecordSet::Version const rsv, int const ws_ver)
+static void test_ver(gu::RecordSet::Version const rsv, int const ws_ver,
+                     KeySet::Version const tk_ver = KeySet::FLAT16A)
 {
     int const alignment
         (rsv >= gu::RecordSet::VER2 ? gu::RecordSet::VER2_ALIGNMENT : 1);
-    KeySet::Version const tk_ver(KeySet::FLAT16A);
     size_t const base_size(version_to_hash_size(tk_ver));
 
     union { gu::byte_t buf[1024]; gu_word_t align; } reserved;
@@ -420,6 +422,74 @@ START_TEST (ver2_5)
 }
 END_TEST
 
+START_TEST (ver3_6_fast)
+{
+    test_ver(gu::RecordSet::VER3, 6, KeySet::FLAT16XA);
+}
+END_TEST
+
+/* serializes a single key in a key set of a given version and returns
+ * its leaf part */
+static KeySet::KeyPart
+leaf_part(KeySet::Version const ver, std::vector<gu::byte_t>& in)
+{
+    union { gu::byte_t buf[1024]; gu_word_t align; } reserved;
+    TestBaseName const str("key_hash_test");
+    KeySetOut kso(reserved.buf, sizeof(reserved.buf), str, ver,
+                  gu::RecordSet::VER2, 6);
+
+    TestKey tk(ver, WSREP_KEY_EXCLUSIVE, false, "a0", "a1");
+    kso.append(tk());
+    ck_assert(kso.count() == 2);
+
+    KeySetOut::GatherVector out;
+    size_t const out_size(kso.gather(out));
+
+    in.clear();
+    for (size_t i(0); i < out->size(); ++i)
+    {
+        const gu::byte_t* ptr(reinterpret_cast<const gu::byte_t*>(out[i].ptr));
+        in.insert (in.end(), ptr, ptr + out[i].size);
+    }
+    ck_assert(in.size() == out_size);
+
+    KeySetIn ksi(kso.version(), in.data(), in.size());
+    ck_assert(ksi.version() == ver);
+    ksi.next();
+    return ksi.next();
+}
+
+START_TEST (fast_key_hash)
+{
+    ck_assert(KeySet::version(KeySet::FLAT8,    true)  == KeySet::FLAT8X);
+    ck_assert(KeySet::version(KeySet::FLAT8A,   true)  == KeySet::FLAT16XA);
+    ck_assert(KeySet::version(KeySet::FLAT16,   true)  == KeySet::FLAT16X);
+    ck_assert(KeySet::version(KeySet::FLAT16A,  true)  == KeySet::FLAT16XA);
+    ck_assert(KeySet::version(KeySet::FLAT16XA, true)  == KeySet::FLAT16XA);
+    ck_assert(KeySet::version(KeySet::FLAT16XA, false) == KeySet::FLAT16A);
+    ck_assert(KeySet::version(KeySet::FLAT8X,   false) == KeySet::FLAT8);
+    ck_assert(KeySet::version(KeySet::FLAT16A,  false) == KeySet::FLAT16A);
+    ck_assert(KeySet::version(std::string("flat16xa")) == KeySet::FLAT16XA);
+
+    std::vector<gu::byte_t> b1, b2, b3, b4;
+    KeySet::KeyPart const mmh(leaf_part(KeySet::FLAT16A,  b1));
+    KeySet::KeyPart const fast1(leaf_part(KeySet::FLAT16XA, b2));
+    KeySet::KeyPart const fast2(leaf_part(KeySet::FLAT16XA, b3));
+    KeySet::KeyPart const fast8(leaf_part(KeySet::FLAT8X,   b4));
+
+    ck_assert(fast1.version() == KeySet::FLAT16XA);
+    ck_assert(fast1.matches(fast2));
+    ck_assert(fast1.hash() == fast2.hash());
+    /* 8-byte hash is a prefix of 16-byte hash within a family */
+    ck_assert(fast1.matches(fast8));
+    ck_assert(fast8.matches(fast1));
+    /* different hash families never match */
+    ck_assert(!fast1.matches(mmh));
+    ck_assert(!mmh.matches(fast1));
+    ck_assert(fast1.hash() != mmh.hash());
+}
+END_TEST
+
 struct KsoFixture
 {
     union Res
@@ -816,8 +886,61 @@ START_TEST(kso_append_exclusive_leaf_over_branch)
 }
 END_TEST
 
+/*
+ * Keys interleaving between tables reuse prefixes of earlier keys
+ */
+
+START_TEST(kso_append_interleaved_tables)
+{
+    KsoFixture f;
+    f.append({"s", "t1", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 3);
+    f.append({"s", "t2", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 5);
+    f.append({"s", "t1", "2"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 6);
+    f.append({"s", "t2", "2"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 7);
+    f.append({"s", "t3", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 9);
+    /* duplicates */
+    f.append({"s", "t1", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 9);
+    f.append({"s", "t2", "1"}, WSREP_KEY_REFERENCE);
+    ck_assert_int_eq(f.kso.count(), 9);
+    f.append({"s", "t1", "3"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 10);
+    /* more tables than cached prefixes */
+    f.append({"s", "t4", "1"}, WSREP_KEY_EXCLUSIVE);
+    f.append({"s", "t5", "1"}, WSREP_KEY_EXCLUSIVE);
+    f.append({"s", "t6", "1"}, WSREP_KEY_EXCLUSIVE);
+    f.append({"s", "t7", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 18);
+    f.append({"s", "t1", "1"}, WSREP_KEY_EXCLUSIVE);
+    f.append({"s", "t2", "2"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 18);
+}
+END_TEST
+
+START_TEST(kso_append_interleaved_stronger_leaf)
+{
+    KsoFixture f;
+    f.append({"s", "t1", "1"}, WSREP_KEY_REFERENCE);
+    f.append({"s", "t2", "1"}, WSREP_KEY_REFERENCE);
+    ck_assert_int_eq(f.kso.count(), 5);
+    /* stronger copy of t1 leaf */
+    f.append({"s", "t1", "1"}, WSREP_KEY_EXCLUSIVE);
+    ck_assert_int_eq(f.kso.count(), 6);
+    f.append({"s", "t2", "1"}, WSREP_KEY_REFERENCE);
+    f.append({"s", "t1", "1"}, WSREP_KEY_UPDATE);
+    ck_assert_int_eq(f.kso.count(), 6);
+}
+END_TEST
+
 Suite* key_set_suite ()
 {
+    gu_crc32c_configure(); /* RecordSet::CHECK_CRC32C4 */
+
     TCase* t = tcase_create ("KeySet");
 #ifndef GALERA_ONLY_ALIGNED
     tcase_add_test (t, ver1_3);
@@ -825,6 +948,8 @@ Suite* key_set_suite ()
     tcase_add_test (t, ver2_3);
     tcase_add_test (t, ver2_4);
     tcase_add_test (t, ver2_5);
+    tcase_add_test (t, ver3_6_fast);
+    tcase_add_test (t, fast_key_hash);
     tcase_set_timeout(t, 60);
 
 
@@ -872,6 +997,9 @@ Suite* key_set_suite ()
     tcase_add_test(t, kso_append_exclusive_branch_over_exclusive_leaf);
     tcase_add_test(t, kso_append_exclusive_leaf_over_branch);
 
+    tcase_add_test(t, kso_append_interleaved_tables);
+    tcase_add_test(t, kso_append_interleaved_stronger_leaf);
+
     Suite* s = suite_create ("KeySet");
     suite_add_tcase (s, t);
 
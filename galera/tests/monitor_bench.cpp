@@ -0,0 +1,190 @@
+//
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+//
+
+/**
+ * This is to benchmark galera::Monitor enter/leave throughput depending on
+ * the number of applier threads.
+ *
+ * Every thread takes the next seqno, like appliers take the next ordered
+ * write set, enters the monitor with a dependency on a random one of the
+ * preceding max_dist seqnos and leaves it right away. With max_dist 1 all
+ * write sets are applied in order.
+ *
+ * Then the same number of write sets is applied in order by a single thread
+ * while parked threads wait in the monitor for the last of them, like
+ * appliers waiting behind a long running write set.
+ *
+ * Usage: monitor_bench [trxs] [max_dist] [parked]
+ */
+
+#include "monitor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /* like ApplyOrder for a remote write set */
+    class BenchOrder
+    {
+    public:
+
+        BenchOrder(wsrep_seqno_t const seqno, wsrep_seqno_t const depends,
+                   gu::Cond* const cond)
+            : seqno_(seqno), depends_(depends), cond_(cond)
+        {}
+
+        BenchOrder() : seqno_(-1), depends_(-1), cond_(NULL) {}
+
+        wsrep_seqno_t seqno() const { return seqno_; }
+
+        gu::Cond* cond() { return cond_; }
+
+        bool condition(wsrep_seqno_t, wsrep_seqno_t const last_left) const
+        {
+            return (last_left >= depends_);
+        }
+
+        wsrep_seqno_t wait_seqno() const { return depends_; }
+
+        const galera::TrxHandleSlave::Deps* deps() const { return NULL; }
+
+#ifdef GU_DBUG_ON
+        void debug_sync(gu::Mutex&) {}
+#endif // GU_DBUG_ON
+
+    private:
+
+        wsrep_seqno_t seqno_;
+        wsrep_seqno_t depends_;
+        gu::Cond*     cond_;
+    };
+
+    double
+    run_bench(size_t const trxs, size_t const nthreads, size_t const max_dist)
+    {
+        galera::Monitor<BenchOrder> mon(gu::GU_MUTEX_KEY_APPLY_MONITOR,
+                                        gu::GU_COND_KEY_APPLY_MONITOR);
+        mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+
+        std::atomic<size_t> next(1);
+
+        auto applier([&](size_t const id)
+        {
+            gu::Cond cond(gu::get_cond_key(gu::GU_COND_KEY_APPLY_MONITOR));
+            std::mt19937_64 rng(id);
+
+            for (size_t i(next++); i <= trxs; i = next++)
+            {
+                wsrep_seqno_t const seqno(i);
+                wsrep_seqno_t const depends(
+                    std::max<wsrep_seqno_t>(seqno - 1 - rng() % max_dist, 0));
+                BenchOrder obj(seqno, depends, &cond);
+
+                mon.enter(obj);
+                mon.leave(obj);
+            }
+        });
+
+        auto const start(std::chrono::steady_clock::now());
+
+        std::vector<std::thread> appliers;
+        for (size_t t(0); t < nthreads; ++t)
+            appliers.push_back(std::thread(applier, t));
+
+        for (auto& t : appliers) t.join();
+
+        auto const stop(std::chrono::steady_clock::now());
+
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+    double
+    run_parked(size_t const trxs, size_t const nparked)
+    {
+        galera::Monitor<BenchOrder> mon(gu::GU_MUTEX_KEY_APPLY_MONITOR,
+                                        gu::GU_COND_KEY_APPLY_MONITOR);
+        mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+
+        auto parked_applier([&](size_t const id)
+        {
+            gu::Cond cond(gu::get_cond_key(gu::GU_COND_KEY_APPLY_MONITOR));
+            BenchOrder obj(trxs + 1 + id, trxs, &cond);
+
+            mon.enter(obj);
+            mon.leave(obj);
+        });
+
+        std::vector<std::thread> parked;
+        for (size_t t(0); t < nparked; ++t)
+            parked.push_back(std::thread(parked_applier, t));
+
+        /* let them all park */
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        gu::Cond cond(gu::get_cond_key(gu::GU_COND_KEY_APPLY_MONITOR));
+
+        auto const start(std::chrono::steady_clock::now());
+
+        for (size_t i(1); i <= trxs; ++i)
+        {
+            wsrep_seqno_t const seqno(i);
+            BenchOrder obj(seqno, seqno - 1, &cond);
+
+            mon.enter(obj);
+            mon.leave(obj);
+        }
+
+        auto const stop(std::chrono::steady_clock::now());
+
+        for (auto& t : parked) t.join();
+
+        return std::chrono::duration<double>(stop - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t const trxs(argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 20);
+    size_t const max_dist(argc > 2 ? strtoul(argv[2], NULL, 10) : 1);
+    size_t const parked(argc > 3 ? strtoul(argv[3], NULL, 10) : 256);
+
+    static size_t const threads[] = { 1, 4, 16, 64, 256 };
+
+    for (size_t t(0); t < sizeof(threads)/sizeof(threads[0]); ++t)
+    {
+        double const duration(run_bench(trxs, threads[t],
+                                        std::max<size_t>(max_dist, 1)));
+
+        std::cout << "threads: "   << std::setw(3) << threads[t]
+                  << ", max_dist: " << max_dist
+                  << ", trxs: "     << trxs
+                  << ", time: "     << duration << " s, "
+                  << std::fixed << std::setprecision(0)
+                  << trxs/duration << " trx/s"
+                  << std::defaultfloat << std::setprecision(6)
+                  << std::endl;
+    }
+
+    /* parked threads must fit in the monitor window with the write sets */
+    size_t const parked_trxs(std::min<size_t>(
+        trxs, galera::Monitor<BenchOrder>::default_size - parked - 1));
+    double const duration(run_parked(parked_trxs, parked));
+
+    std::cout << "parked: "   << parked
+              << ", trxs: "   << parked_trxs
+              << ", time: "   << duration << " s, "
+              << std::fixed << std::setprecision(0)
+              << parked_trxs/duration << " trx/s"
+              << std::defaultfloat << std::setprecision(6)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "../src/monitor.hpp"
+
+#include <check.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace galera;
+
+namespace
+{
+    /* Like ApplyOrder for a remote write set: may enter when everything up
+     * to depends_seqno has left, and with exact dependencies also when
+     * everything up to the base and the write sets in deps have left. */
+    class TestOrder
+    {
+    public:
+
+        TestOrder(wsrep_seqno_t const seqno, wsrep_seqno_t const depends,
+                  const TrxHandleSlave::Deps* const deps = NULL)
+            :
+            seqno_  (seqno),
+            depends_(depends),
+            deps_   (deps),
+            cond_   (new gu::Cond(
+                         gu::get_cond_key(gu::GU_COND_KEY_APPLY_MONITOR)))
+        {}
+
+        TestOrder() : seqno_(-1), depends_(-1), deps_(NULL), cond_() {}
+
+        TestOrder(const TestOrder& o)
+            : seqno_(o.seqno_), depends_(o.depends_), deps_(o.deps_),
+              cond_(o.cond_)
+        {}
+
+        wsrep_seqno_t seqno() const { return seqno_; }
+
+        gu::Cond* cond() { return cond_.get(); }
+
+        bool condition(wsrep_seqno_t, wsrep_seqno_t const last_left) const
+        {
+            return (last_left >= depends_);
+        }
+
+        wsrep_seqno_t wait_seqno() const { return depends_; }
+
+        const TrxHandleSlave::Deps* deps() const { return deps_; }
+
+#ifdef GU_DBUG_ON
+        void debug_sync(gu::Mutex&) {}
+#endif // GU_DBUG_ON
+
+    private:
+
+        TestOrder& operator=(const TestOrder&);
+
+        wsrep_seqno_t               seqno_;
+        wsrep_seqno_t               depends_;
+        const TrxHandleSlave::Deps* deps_;
+        std::shared_ptr<gu::Cond>   cond_;
+    };
+
+    typedef Monitor<TestOrder> TestMonitor;
+
+    /* enters the monitor in a separate thread */
+    class Enter
+    {
+    public:
+
+        Enter(TestMonitor& mon, TestOrder& obj)
+            : entered_(false),
+              thd_([&mon, &obj, this]()
+                   {
+                       mon.enter(obj);
+                       entered_ = true;
+                   })
+        {}
+
+        ~Enter() { if (thd_.joinable()) thd_.join(); }
+
+        /* checks that enter() blocks */
+        bool blocked() const
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return !entered_;
+        }
+
+        void join() { thd_.join(); }
+
+    private:
+
+        std::atomic<bool> entered_;
+        std::thread       thd_;
+    };
+}
+
+START_TEST(monitor_exact_deps)
+{
+    TestMonitor mon(gu::GU_MUTEX_KEY_APPLY_MONITOR,
+                    gu::GU_COND_KEY_APPLY_MONITOR);
+    mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+
+    TestOrder o1(1, 0);
+    TestOrder o2(2, 0);
+    mon.enter(o1);
+    mon.enter(o2);
+
+    /* 3 conflicts only with 1, but depends_seqno 2 would make it wait for 2,
+     * with exact dependencies it waits for its base 0 and for 1 */
+    TrxHandleSlave::Deps const deps3(1, 1);
+    TestOrder o3(3, 0, &deps3);
+    {
+        Enter e3(mon, o3);
+        ck_assert(e3.blocked()); // 1 is still applying
+
+        mon.leave(o1);
+        e3.join(); // enters ahead of 2, which is still applying
+    }
+    ck_assert(mon.entered(o3));
+    ck_assert(mon.entered(o2));
+    ck_assert_int_eq(mon.last_left(), 1);
+
+    /* 4 depends on nothing, 5 only on 4 which leaves out of order */
+    TestOrder o4(4, 0);
+    mon.enter(o4);
+
+    TrxHandleSlave::Deps const deps5(1, 4);
+    TestOrder o5(5, 0, &deps5);
+    {
+        Enter e5(mon, o5);
+        ck_assert(e5.blocked()); // 4 is still applying
+
+        mon.leave(o4);
+        e5.join(); // woken up by out of order leave
+    }
+    ck_assert(mon.finished(o4));
+    ck_assert(mon.entered(o5));
+    ck_assert_int_eq(mon.last_left(), 1);
+
+    /* plain depends_seqno ordering still waits for everything below */
+    TestOrder o6(6, 5);
+    {
+        Enter e6(mon, o6);
+
+        mon.leave(o3);
+        mon.leave(o5);
+        ck_assert(e6.blocked()); // 2 is still applying
+
+        mon.leave(o2);
+        e6.join();
+    }
+    ck_assert_int_eq(mon.last_left(), 5);
+
+    mon.leave(o6);
+    ck_assert_int_eq(mon.last_left(), 6);
+}
+END_TEST
+
+/* group size metric is collected only when requested */
+static void
+test_group_stats(bool const group_stats)
+{
+    TestMonitor mon(gu::GU_MUTEX_KEY_COMMIT_MONITOR,
+                    gu::GU_COND_KEY_COMMIT_MONITOR,
+                    TestMonitor::default_size, group_stats);
+    mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+
+    TestOrder o1(1, 0);
+    mon.enter(o1);
+
+    /* 2 and 3 wait in order behind 1 */
+    TestOrder o2(2, 1);
+    TestOrder o3(3, 2);
+    {
+        Enter e2(mon, o2);
+        Enter e3(mon, o3);
+        ck_assert(e2.blocked());
+        ck_assert(e3.blocked());
+
+        mon.leave(o1);  // 2 and 3 make a group
+        e2.join();
+        mon.leave(o2);
+        e3.join();
+        mon.leave(o3);
+    }
+    ck_assert_int_eq(mon.last_left(), 3);
+
+    ck_assert(mon.group_size() == (group_stats ? 2.0 : 0.0));
+}
+
+START_TEST(monitor_group_stats)
+{
+    test_group_stats(true);
+    test_group_stats(false);
+}
+END_TEST
+
+START_TEST(monitor_resize)
+{
+    TestMonitor mon(gu::GU_MUTEX_KEY_APPLY_MONITOR,
+                    gu::GU_COND_KEY_APPLY_MONITOR, 4);
+    mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+    ck_assert_int_eq(mon.size(), 4);
+
+    std::vector<TestOrder> objs;
+    for (wsrep_seqno_t i(1); i <= 16; ++i) objs.push_back(TestOrder(i, 0));
+
+    /* grows to fit seqnos instead of blocking */
+    for (auto& o : objs) mon.enter(o);
+    ck_assert_int_eq(mon.size(), 32);
+
+    /* canceled seqno which has not entered yet keeps its slot */
+    TestOrder o40(40, 0);
+    ck_assert(mon.interrupt(o40));
+    ck_assert_int_eq(mon.size(), 64);
+
+    /* seqnos beyond the current window don't overflow it until max_size */
+    ck_assert(!mon.would_overflow(64));
+    ck_assert(!mon.would_overflow(TestMonitor::max_size - 1));
+    ck_assert(mon.would_overflow(TestMonitor::max_size));
+
+    for (auto& o : objs) mon.leave(o);
+    ck_assert_int_eq(mon.last_left(), 16);
+    ck_assert_int_eq(mon.size(), 64);
+
+    for (wsrep_seqno_t i(17); i < 40; ++i)
+    {
+        TestOrder o(i, 0);
+        mon.self_cancel(o);
+    }
+    mon.self_cancel(o40);
+    ck_assert_int_eq(mon.last_left(), 40);
+
+    /* shrinks back once it is not occupied */
+    ck_assert_int_eq(mon.size(), 4);
+
+    TestOrder o41(41, 40);
+    mon.enter(o41);
+    mon.leave(o41);
+    ck_assert_int_eq(mon.last_left(), 41);
+
+    /* reset forgets canceled seqnos above the position, so the window
+     * shrinks back as soon as it is not occupied */
+    TestOrder o80(80, 0);
+    ck_assert(mon.interrupt(o80));
+    ck_assert_int_eq(mon.size(), 64);
+    mon.set_initial_position(WSREP_UUID_UNDEFINED, -1);
+    mon.set_initial_position(WSREP_UUID_UNDEFINED, 0);
+
+    for (wsrep_seqno_t i(1); i <= 4; ++i)
+    {
+        TestOrder o(i, 0);
+        mon.enter(o);
+        mon.leave(o);
+    }
+    ck_assert_int_eq(mon.last_left(), 4);
+    ck_assert_int_eq(mon.size(), 4);
+
+    /* configured size above the limit is rejected */
+    try
+    {
+        TestMonitor big(gu::GU_MUTEX_KEY_APPLY_MONITOR,
+                        gu::GU_COND_KEY_APPLY_MONITOR,
+                        TestMonitor::max_size + 1);
+        ck_abort_msg("window size above max_size accepted");
+    }
+    catch (gu::Exception& e)
+    {
+        ck_assert_int_eq(e.get_errno(), EINVAL);
+    }
+}
+END_TEST
+
+Suite* monitor_suite()
+{
+    Suite* s(suite_create("monitor"));
+    TCase* t;
+
+    t = tcase_create("monitor");
+    tcase_add_test(t, monitor_exact_deps);
+    tcase_add_test(t, monitor_group_stats);
+    tcase_add_test(t, monitor_resize);
+    tcase_set_timeout(t, 60);
+    suite_add_tcase(s, t);
+
+    return s;
+}
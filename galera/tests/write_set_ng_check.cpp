@@ -1,4 +1,4 @@
-/* Copyright (C) 2013-2024 Codership Oy <info@codership.com>
+/* Copyright (C) 2013-2026 Codership Oy <info@codership.com>
  *
  * $Id$
  */
@@ -9,12 +9,17 @@
 #include "../src/write_set_ng.hpp"
 
 #include "gu_uuid.h"
+#include "gu_crc32c.h"
 #include "gu_logger.hpp"
 #include "gu_hexdump.hpp"
 #include "gu_inttypes.hpp"
 
 #include <check.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 using namespace galera;
 
 static void ver3_basic(gu::RecordSet::Version const rsv,
@@ -298,6 +303,12 @@ START_TEST (ver3_basic_rsv2_wsv4)
 }
 END_TEST
 
+START_TEST (ver3_basic_rsv3_wsv4)
+{
+    ver3_basic(gu::RecordSet::VER3, WriteSetNG::VER4);
+}
+END_TEST
+
 static void ver3_annotation(gu::RecordSet::Version const rsv)
 {
     int const alignment(rsv >= gu::RecordSet::VER2 ? GU_MIN_ALIGNMENT : 1);
@@ -393,8 +404,180 @@ START_TEST (ver3_annotation_rsv2)
 }
 END_TEST
 
+START_TEST (ver3_compressed)
+{
+    wsrep_uuid_t source;
+    gu_uuid_generate (reinterpret_cast<gu_uuid_t*>(&source), NULL, 0);
+    wsrep_conn_id_t const conn(652653);
+    wsrep_trx_id_t const  trx(99994952);
+
+    std::string const dir(".");
+    wsrep_trx_id_t trx_id(1);
+
+    WriteSetOut wso (dir, trx_id, KeySet::FLAT16, 0, 0, 0,
+                     gu::RecordSet::VER2, WriteSetNG::VER6,
+                     DataSet::VER2, DataSet::VER2);
+    wso.set_compression(gu::Compression::LZ4, 1024);
+
+    TestKey tk0(KeySet::MAX_VERSION, WSREP_KEY_EXCLUSIVE, true, "key0");
+    wso.append_key(tk0());
+
+    std::string data;
+    for (int i(0); i < 1000; ++i) data += "{\"id\": 1, \"name\": \"row\"} ";
+    std::string const annotation("INSERT INTO t1 VALUES (...)");
+
+    wso.append_data (data.data(), data.size(), false);
+    wso.append_annotation (annotation.c_str(), annotation.size(), true);
+
+    WriteSetNG::GatherVector out;
+    size_t const out_size(wso.gather(source, conn, trx, out));
+    ck_assert_msg(out_size < data.size()/4, "Gather size: %zu, data size: %zu",
+                  out_size, data.size());
+
+    wso.finalize(1, 0);
+
+    std::vector<gu::byte_t> in;
+    in.reserve(out_size);
+    for (size_t i(0); i < out->size(); ++i)
+    {
+        const gu::byte_t* ptr(static_cast<const gu::byte_t*>(out[i].ptr));
+        in.insert (in.end(), ptr, ptr + out[i].size);
+    }
+
+    gu::Buf const in_buf = { in.data(), static_cast<ssize_t>(in.size()) };
+
+    WriteSetIn wsi(in_buf);
+    wsi.verify_checksum();
+    ck_assert(wsi.flags() & WriteSetNG::F_COMPRESSED);
+    ck_assert(wsi.keyset().count() == 1);
+
+    const DataSetIn& dsi(wsi.dataset());
+    ck_assert(dsi.count() == 1);
+    ck_assert(size_t(dsi.size()) < data.size()/4);
+
+    gu::Buf const res(dsi.next());
+    ck_assert(std::string(static_cast<const char*>(res.ptr), res.size)==data);
+
+    std::ostringstream os;
+    wsi.write_annotation(os);
+    ck_assert(os.str() == annotation);
+}
+END_TEST
+
+START_TEST (ver3_checksum_pool)
+{
+    ChecksumPool pool(2, 4, 0);
+    ck_assert(pool.enabled());
+    WriteSetIn::set_check_pool(&pool);
+
+    /* same as above, but checksumming goes through the pool */
+    ver3_basic(gu::RecordSet::VER2, WriteSetNG::VER4);
+
+    wsrep_uuid_t source;
+    gu_uuid_generate (reinterpret_cast<gu_uuid_t*>(&source), NULL, 0);
+
+    std::string const dir(".");
+    wsrep_trx_id_t trx_id(1);
+
+    WriteSetOut wso (dir, trx_id, KeySet::FLAT16, 0, 0, 0,
+                     gu::RecordSet::VER2, WriteSetNG::VER4);
+
+    TestKey tk0(KeySet::MAX_VERSION, WSREP_KEY_EXCLUSIVE, true, "key0");
+    wso.append_key(tk0());
+    std::vector<char> const data(1 << 16, 'x');
+    wso.append_data (data.data(), data.size(), false);
+
+    WriteSetNG::GatherVector out;
+    size_t const out_size(wso.gather(source, 1, 1, out));
+    wso.finalize(1, 0);
+
+    std::vector<gu::byte_t> in;
+    in.reserve(out_size);
+    for (size_t i(0); i < out->size(); ++i)
+    {
+        const gu::byte_t* ptr(static_cast<const gu::byte_t*>(out[i].ptr));
+        in.insert (in.end(), ptr, ptr + out[i].size);
+    }
+
+    gu::Buf const in_buf = { in.data(), static_cast<ssize_t>(in.size()) };
+
+    {
+        /* more write sets than the queue can hold, the rest are checksummed
+         * in the foreground */
+        WriteSetIn wsi[16];
+        for (size_t i(0); i < sizeof(wsi)/sizeof(wsi[0]); ++i)
+        {
+            wsi[i].read_buf(in_buf);
+        }
+
+        /* leave some unverified to check that destructor waits for them */
+        for (size_t i(0); i < sizeof(wsi)/sizeof(wsi[0]); i += 2)
+        {
+            wsi[i].verify_checksum();
+            ck_assert(wsi[i].dataset().count() == 1);
+        }
+    }
+
+    long long queue;
+    double    latency;
+    pool.get_stats(queue, latency);
+    ck_assert_msg(0 == queue, "queue: %lld", queue);
+    ck_assert(latency > 0);
+
+    pool.flush_stats();
+    pool.get_stats(queue, latency);
+    ck_assert(0 == latency);
+
+    in[in.size() - 1] ^= 1; // corrupt payload
+
+    try
+    {
+        WriteSetIn wsi(in_buf);
+        wsi.verify_checksum();
+        ck_abort_msg("payload corruption slipped through the pool");
+    }
+    catch (gu::Exception& e)
+    {
+        ck_assert(e.get_errno() == EINVAL);
+    }
+
+    WriteSetIn::set_check_pool(NULL);
+}
+END_TEST
+
+static void* checksum_pool_job(void*) { return NULL; }
+
+/* pool destructor waits for the accepted jobs to be waited for */
+START_TEST (checksum_pool_destroy)
+{
+    ChecksumPool::Job job;
+    std::thread thd;
+    std::atomic<bool> waited(false);
+
+    {
+        ChecksumPool pool(1, 4, 0);
+        ck_assert(pool.submit(job, checksum_pool_job, NULL));
+        ck_assert(job.pending());
+
+        thd = std::thread([&job, &waited]()
+                          {
+                              std::this_thread::sleep_for(
+                                  std::chrono::milliseconds(100));
+                              waited = true;
+                              ChecksumPool::wait(job);
+                          });
+    }
+
+    ck_assert(waited);
+    thd.join();
+    ck_assert(!job.pending());
+}
+END_TEST
+
 Suite* write_set_ng_suite ()
 {
+    gu_crc32c_configure(); /* RecordSet::CHECK_CRC32C4 */
+
     Suite* s = suite_create ("WriteSet");
 
     TCase* t = tcase_create ("WriteSet basic");
@@ -403,6 +586,7 @@ Suite* write_set_ng_suite ()
 #endif
     tcase_add_test (t, ver3_basic_rsv2_wsv3);
     tcase_add_test (t, ver3_basic_rsv2_wsv4);
+    tcase_add_test (t, ver3_basic_rsv3_wsv4);
     tcase_set_timeout(t, 60);
     suite_add_tcase (s, t);
 
@@ -414,5 +598,19 @@ Suite* write_set_ng_suite ()
     tcase_set_timeout(t, 60);
     suite_add_tcase (s, t);
 
+    t = tcase_create ("WriteSet compression");
+    if (gu::Compression::supported(gu::Compression::LZ4))
+    {
+        tcase_add_test (t, ver3_compressed);
+    }
+    tcase_set_timeout(t, 60);
+    suite_add_tcase (s, t);
+
+    t = tcase_create ("WriteSet checksum pool");
+    tcase_add_test (t, ver3_checksum_pool);
+    tcase_add_test (t, checksum_pool_destroy);
+    tcase_set_timeout(t, 60);
+    suite_add_tcase (s, t);
+
     return s;
 }
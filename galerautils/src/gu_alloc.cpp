@@ -10,13 +10,174 @@
 #include "gu_assert.hpp"
 #include "gu_arch.h"
 #include "gu_limits.h"
+#include "gu_lock.hpp"
+#include "gu_logger.hpp"
+#include "gu_thread_keys.hpp"
+
+#include <sys/mman.h>
 
 #include <sstream>
 #include <iomanip> // for std::setfill() and std::setw()
 
+/* to avoid too frequent allocation, make heap pages (at least) 64K */
+gu::Allocator::page_size_type
+gu::Allocator::PagePool::page_size()
+{
+    static page_size_type const PAGE_SIZE(gu_page_size_multiple(1 << 16));
+    return PAGE_SIZE;
+}
+
+/* chunk size matches the most common huge page size */
+static size_t
+page_pool_chunk_size()
+{
+    static size_t const CHUNK_SIZE
+        (std::max<size_t>(1 << 21, gu::Allocator::PagePool::page_size()));
+    return CHUNK_SIZE;
+}
+
+gu::Allocator::PagePool::PagePool (size_t const max_size,
+                                   bool   const huge_pages)
+    :
+    free_      (),
+    chunks_    (),
+    mtx_       (gu::get_mutex_key(gu::GU_MUTEX_KEY_ALLOC_PAGE_POOL)),
+    cond_      (gu::get_cond_key(gu::GU_COND_KEY_ALLOC_PAGE_POOL)),
+    max_chunks_(max_size / page_pool_chunk_size()),
+    used_      (0),
+    huge_      (huge_pages)
+{}
+
+gu::Allocator::PagePool::~PagePool ()
+{
+    assert(page_pool() != this);
+
+    {
+        /* allocators of objects being destroyed in other threads */
+        gu::Lock lock(mtx_);
+        gu::datetime::Date const until(gu::datetime::Date::calendar()
+                                       + 10 * gu::datetime::Sec);
+        while (used_ > 0)
+        {
+            try { lock.wait(cond_, until); }
+            catch (gu::Exception&) { break; } /* timed out */
+        }
+    }
+
+    if (used_ > 0)
+    {
+        /* pages still referenced, can't unmap */
+        log_warn << "Allocator page pool destroyed with " << used_
+                 << " pages in use, leaking " << size() << " bytes";
+        return;
+    }
+
+    for (size_t i(0); i < chunks_.size(); ++i)
+    {
+        ::munmap(chunks_[i], page_pool_chunk_size());
+    }
+}
+
+bool
+gu::Allocator::PagePool::add_chunk()
+{
+    if (chunks_.size() >= max_chunks_) return false;
+
+    size_t const chunk_size(page_pool_chunk_size());
+    void* ptr(MAP_FAILED);
+
+#ifdef MAP_HUGETLB
+    if (huge_)
+    {
+        ptr = ::mmap(NULL, chunk_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif /* MAP_HUGETLB */
+
+    if (MAP_FAILED == ptr)
+    {
+        /* no reserved huge pages: map twice the size to trim the chunk to
+         * huge page boundary, so that it is eligible for THP */
+        size_t const map_size(huge_ ? 2 * chunk_size : chunk_size);
+
+        ptr = ::mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (MAP_FAILED == ptr) return false;
+
+        if (huge_)
+        {
+            uintptr_t const start(reinterpret_cast<uintptr_t>(ptr));
+            uintptr_t const chunk(GU_ALIGN(start, chunk_size));
+            size_t    const tail(start + map_size - chunk - chunk_size);
+
+            if (chunk > start) ::munmap(ptr, chunk - start);
+            if (tail > 0) ::munmap(reinterpret_cast<void*>(chunk + chunk_size),
+                                   tail);
+
+            ptr = reinterpret_cast<void*>(chunk);
+#ifdef MADV_HUGEPAGE
+            (void)::madvise(ptr, chunk_size, MADV_HUGEPAGE); // best effort
+#endif /* MADV_HUGEPAGE */
+        }
+    }
+
+    chunks_.push_back(ptr);
+
+    /* push in reverse so that pages are given out in address order */
+    for (size_t off(chunk_size); off >= page_size(); off -= page_size())
+    {
+        free_.push_back(static_cast<byte_t*>(ptr) + off - page_size());
+    }
+
+    return true;
+}
+
+void*
+gu::Allocator::PagePool::get()
+{
+    gu::Lock lock(mtx_);
+
+    if (free_.empty() && !add_chunk()) return NULL;
+
+    void* const ret(free_.back());
+    free_.pop_back();
+    ++used_;
+
+    return ret;
+}
+
+void
+gu::Allocator::PagePool::put(void* const page)
+{
+    gu::Lock lock(mtx_);
+
+    assert(used_ > 0);
+    --used_;
+    free_.push_back(page); /* LIFO: the next get() gets a warm page */
+
+    if (0 == used_) cond_.broadcast();
+}
+
+size_t
+gu::Allocator::PagePool::size() const
+{
+    gu::Lock lock(mtx_);
+    return chunks_.size() * page_pool_chunk_size();
+}
+
+size_t
+gu::Allocator::PagePool::used() const
+{
+    gu::Lock lock(mtx_);
+    return used_;
+}
+
+std::atomic<gu::Allocator::PagePool*> gu::Allocator::page_pool_(NULL);
 
 gu::Allocator::HeapPage::HeapPage (page_size_type const size) :
-    Page (static_cast<byte_t*>(::malloc(size)), size)
+    Page (static_cast<byte_t*>(::malloc(size)), size),
+    pool_(NULL)
 {
     assert(0 == (uintptr_t(base_ptr_) % GU_WORD_BYTES));
     if (0 == base_ptr_) gu_throw_error (ENOMEM);
@@ -28,13 +189,24 @@ gu::Allocator::HeapStore::my_new_page (page_size_type const size)
 {
     if (gu_likely(size <= left_))
     {
-        /* to avoid too frequent allocation, make it (at least) 64K */
-        static page_size_type const PAGE_SIZE(gu_page_size_multiple(1 << 16));
-
         page_size_type const page_size
-            (std::min(std::max(size, PAGE_SIZE), left_));
+            (std::min(std::max(size, PagePool::page_size()), left_));
+
+        PagePool* const pool(page_pool_);
+        Page* ret = NULL;
+
+        if (pool && page_size == PagePool::page_size())
+        {
+            void* const ptr(pool->get());
+
+            if (ptr)
+            {
+                try { ret = new HeapPage (ptr, page_size, pool); }
+                catch (...) { pool->put(ptr); throw; }
+            }
+        }
 
-        Page* ret = new HeapPage (page_size);
+        if (!ret) ret = new HeapPage (page_size);
 
         assert (ret != 0);
 
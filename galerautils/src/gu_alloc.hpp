@@ -13,11 +13,15 @@
 #include "gu_mmap.hpp"
 #include "gu_buf.hpp"
 #include "gu_vector.hpp"
+#include "gu_mutex.hpp"
+#include "gu_cond.hpp"
 
 #include "gu_macros.h" // gu_likely()
 
+#include <atomic>
 #include <cstdlib>     // realloc(), free()
 #include <string>
+#include <vector>
 #include <iostream>
 
 namespace gu
@@ -68,6 +72,63 @@ public:
      * be an issue. */
     static size_t const INITIAL_VECTOR_SIZE = 4;
 
+    /*!
+     * Bounded pool of standard size heap pages shared by all allocators.
+     * Pages released by destroyed allocators are kept for reuse instead of
+     * going back to malloc(). Pages are carved from 2M chunks which can be
+     * backed by huge pages to reduce TLB pressure of write set buffers.
+     */
+    class PagePool
+    {
+    public:
+
+        /*!
+         * @param max_size   maximum amount of memory held by the pool
+         * @param huge_pages back chunks by huge pages: try MAP_HUGETLB first,
+         *                   then fall back to transparent huge pages */
+        PagePool (size_t max_size, bool huge_pages);
+
+        /*! waits for a while for the pages still given out to be returned,
+         *  the pool must be uninstalled by now */
+        ~PagePool ();
+
+        bool enabled() const { return max_chunks_ > 0; }
+
+        /*! @return free page or NULL if the pool is exhausted */
+        void* get ();
+
+        void  put (void* page);
+
+        /*! size of pages served by the pool */
+        static page_size_type page_size();
+
+        /*! memory currently mapped by the pool */
+        size_t size() const;
+
+        /*! pages currently given out */
+        size_t used() const;
+
+    private:
+
+        std::vector<void*> free_;
+        std::vector<void*> chunks_;
+        gu::Mutex mutable  mtx_;
+        gu::Cond           cond_; // all pages returned
+        size_t const       max_chunks_;
+        size_t             used_;
+        bool const         huge_;
+
+        bool add_chunk(); /* must be called under mtx_ */
+
+        PagePool (const PagePool&);
+        PagePool& operator= (const PagePool&);
+    };
+
+    /*! Installs process-wide page pool for heap pages, NULL to uninstall.
+     *  Allocators which got a page from the pool return it there. */
+    static void      set_page_pool (PagePool* pool) { page_pool_ = pool; }
+    static PagePool* page_pool () { return page_pool_; }
+
 private:
 
     class Page /* base class for memory and file pages */
@@ -115,7 +176,19 @@ private:
 
         HeapPage (page_size_type max_size);
 
-        ~HeapPage () { free (base_ptr_); }
+        /* page obtained from the pool */
+        HeapPage (void* ptr, page_size_type size, PagePool* pool)
+            : Page(ptr, size), pool_(pool)
+        {}
+
+        ~HeapPage ()
+        {
+            if (pool_) pool_->put(base_ptr_); else free (base_ptr_);
+        }
+
+    private:
+
+        PagePool* const pool_;
     };
 
     class FilePage : public Page
@@ -220,6 +293,8 @@ private:
 
     static BaseNameDefault const BASE_NAME_DEFAULT;
 
+    static std::atomic<PagePool*> page_pool_;
+
 }; /* class Allocator */
 
 inline
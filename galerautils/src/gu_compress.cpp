@@ -0,0 +1,224 @@
+/* Copyright (C) 2026 Codership Oy <info@codership.com> */
+/*!
+ * @file block compression of serialized buffers: implementation
+ */
+
+#include "gu_compress.hpp"
+
+#include "gu_throw.hpp"
+#include "gu_macros.h"
+
+#ifdef GALERA_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef GALERA_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+namespace gu
+{
+
+#ifdef GALERA_HAVE_LZ4
+
+namespace lz4
+{
+    static size_t
+    compress(const byte_t* const src, size_t const src_size,
+             byte_t*       const dst, size_t const dst_size)
+    {
+        if (src_size > size_t(LZ4_MAX_INPUT_SIZE)) return 0;
+
+        int const ret(LZ4_compress_default(
+                          reinterpret_cast<const char*>(src),
+                          reinterpret_cast<char*>(dst), int(src_size),
+                          int(std::min<size_t>(dst_size, INT_MAX))));
+        return (ret > 0 ? ret : 0);
+    }
+
+    static void
+    decompress(const byte_t* const src, size_t const src_size,
+               byte_t*       const dst, size_t const dst_size)
+    {
+        if (gu_unlikely(src_size > size_t(INT_MAX) ||
+                        dst_size > size_t(INT_MAX)))
+        {
+            gu_throw_error(EINVAL) << "LZ4: block too big: " << src_size
+                                   << " -> " << dst_size;
+        }
+
+        int const ret(LZ4_decompress_safe(reinterpret_cast<const char*>(src),
+                                          reinterpret_cast<char*>(dst),
+                                          int(src_size), int(dst_size)));
+        if (gu_unlikely(ret < 0))
+        {
+            gu_throw_error(EINVAL) << "LZ4: malformed block";
+        }
+
+        if (gu_unlikely(size_t(ret) != dst_size))
+        {
+            gu_throw_error(EINVAL) << "LZ4: decompressed " << ret
+                                   << " bytes, expected " << dst_size;
+        }
+    }
+} /* namespace lz4 */
+
+#endif /* GALERA_HAVE_LZ4 */
+
+Compression::Type
+Compression::type(const std::string& name)
+{
+    for (int t(NONE); t <= MAX_TYPE; ++t)
+    {
+        if (name == Compression::name(Type(t)))
+        {
+            if (!supported(Type(t)))
+            {
+                gu_throw_error(EINVAL) << "Compression '" << name
+                                       << "' is not supported by this build";
+            }
+
+            return Type(t);
+        }
+    }
+
+    gu_throw_error(EINVAL) << "Unrecognized compression: '" << name
+                           << "', expected one of: none, lz4, zstd";
+    return NONE; // keep compiler happy
+}
+
+Compression::Type
+Compression::type(int const t)
+{
+    if (gu_likely(t >= NONE && t <= MAX_TYPE)) return Type(t);
+
+    gu_throw_error(EINVAL) << "Unrecognized compression type: " << t;
+    return NONE; // keep compiler happy
+}
+
+const char*
+Compression::name(Type const t)
+{
+    switch (t)
+    {
+    case NONE: return "none";
+    case LZ4:  return "lz4";
+    case ZSTD: return "zstd";
+    }
+
+    return "unknown";
+}
+
+bool
+Compression::supported(Type const t)
+{
+    switch (t)
+    {
+    case NONE:
+        return true;
+    case LZ4:
+#ifdef GALERA_HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case ZSTD:
+#ifdef GALERA_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+size_t
+Compression::compress(Type const        t,
+                      const void* const src,
+                      size_t const      src_size,
+                      void* const       dst,
+                      size_t const      dst_size)
+{
+    switch (t)
+    {
+    case NONE:
+        if (src_size > dst_size) return 0;
+        ::memcpy(dst, src, src_size);
+        return src_size;
+    case LZ4:
+#ifdef GALERA_HAVE_LZ4
+        return lz4::compress(static_cast<const byte_t*>(src), src_size,
+                             static_cast<byte_t*>(dst), dst_size);
+#else
+        break;
+#endif
+    case ZSTD:
+#ifdef GALERA_HAVE_ZSTD
+    {
+        size_t const ret(ZSTD_compress(dst, dst_size, src, src_size,
+                                       ZSTD_CLEVEL_DEFAULT));
+        return (ZSTD_isError(ret) ? 0 : ret);
+    }
+#else
+        break;
+#endif
+    }
+
+    gu_throw_error(EINVAL) << "Compression '" << t << "' is not supported";
+    return 0; // keep compiler happy
+}
+
+void
+Compression::decompress(Type const        t,
+                        const void* const src,
+                        size_t const      src_size,
+                        void* const       dst,
+                        size_t const      dst_size)
+{
+    switch (t)
+    {
+    case NONE:
+        if (src_size != dst_size)
+        {
+            gu_throw_error(EINVAL) << "Uncompressed size " << src_size
+                                   << " does not match expected " << dst_size;
+        }
+        ::memcpy(dst, src, src_size);
+        return;
+    case LZ4:
+#ifdef GALERA_HAVE_LZ4
+        lz4::decompress(static_cast<const byte_t*>(src), src_size,
+                        static_cast<byte_t*>(dst), dst_size);
+        return;
+#else
+        break;
+#endif
+    case ZSTD:
+#ifdef GALERA_HAVE_ZSTD
+    {
+        size_t const ret(ZSTD_decompress(dst, dst_size, src, src_size));
+        if (ZSTD_isError(ret))
+        {
+            gu_throw_error(EINVAL) << "zstd: " << ZSTD_getErrorName(ret);
+        }
+        if (ret != dst_size)
+        {
+            gu_throw_error(EINVAL) << "zstd: decompressed " << ret
+                                   << " bytes, expected " << dst_size;
+        }
+        return;
+    }
+#else
+        break;
+#endif
+    }
+
+    gu_throw_error(EINVAL) << "Compression '" << t << "' is not supported";
+}
+
+} /* namespace gu */
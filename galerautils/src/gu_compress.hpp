@@ -0,0 +1,75 @@
+/* Copyright (C) 2026 Codership Oy <info@codership.com> */
+/*!
+ * @file block compression of serialized buffers
+ *
+ * LZ4 block format is available when write set compression is compiled in
+ * with the system library (GALERA_HAVE_LZ4). zstd is available only when
+ * the library was found at build time (GALERA_HAVE_ZSTD).
+ */
+
+#ifndef _GU_COMPRESS_HPP_
+#define _GU_COMPRESS_HPP_
+
+#include "gu_types.hpp"
+
+#include <string>
+#include <ostream>
+
+namespace gu
+{
+    class Compression
+    {
+    public:
+
+        /* values are serialized, never change them */
+        enum Type
+        {
+            NONE = 0,
+            LZ4,
+            ZSTD
+        };
+
+        static Type const MAX_TYPE = ZSTD;
+
+        /*! parses configuration value ("none", "lz4", "zstd"),
+         *  throws EINVAL for unknown or unsupported by this build types */
+        static Type type(const std::string& name);
+
+        /*! converts serialized value, throws EINVAL for unknown types */
+        static Type type(int t);
+
+        static const char* name(Type t);
+
+        /*! whether this build can compress and decompress given type */
+        static bool supported(Type t);
+
+        /*!
+         * Compresses src into dst.
+         *
+         * @return compressed size or 0 if the result does not fit in dst
+         */
+        static size_t compress(Type          t,
+                               const void*   src,
+                               size_t        src_size,
+                               void*         dst,
+                               size_t        dst_size);
+
+        /*!
+         * Decompresses src into dst, dst_size must be exactly the size of
+         * decompressed data. Throws EINVAL if src is malformed.
+         */
+        static void   decompress(Type        t,
+                                 const void* src,
+                                 size_t      src_size,
+                                 void*       dst,
+                                 size_t      dst_size);
+    }; /* class Compression */
+
+    inline std::ostream&
+    operator<< (std::ostream& os, Compression::Type const t)
+    {
+        return (os << Compression::name(t));
+    }
+} /* namespace gu */
+
+#endif /* _GU_COMPRESS_HPP_ */
@@ -40,6 +40,29 @@ private:
 
 }; /* class CRC32C */
 
+/* 128-bit checksum of 4 interleaved CRC-32C lanes, see gu_crc32c.h */
+class CRC32C4
+{
+public:
+
+    static size_t const SIZE = GU_CRC32C4_SIZE;
+
+    CRC32C4() : ctx_() { gu_crc32c4_init(&ctx_); }
+
+    void append(const void* const data, size_t const size)
+    {
+        gu_crc32c4_append(&ctx_, data, size);
+    }
+
+    /* writes SIZE bytes to buf */
+    void gather16(void* const buf) const { gu_crc32c4_get(&ctx_, buf); }
+
+private:
+
+    gu_crc32c4_ctx_t ctx_;
+
+}; /* class CRC32C4 */
+
 } /* namespace gu */
 
 #endif /* GU_CRC_HPP */
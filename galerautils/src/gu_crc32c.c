@@ -13,6 +13,8 @@
 #include "gu_arch.h"     // GU_ASSERT_ALIGNMENT()
 #include "gu_byteswap.h" // gu_le32()
 
+#include <string.h>      // memcpy()
+
 static uint32_t crc32c_lut[8][256]; /* CRC32C lookup tables */
 
 static void
@@ -183,6 +185,147 @@ gu_crc32c_slicing_by_8(gu_crc32c_t state, const void* data, size_t len)
     return crc32c_3bytes(state, ptr, len);
 }
 
+/** Slicing-by-8 step over a single (possibly unaligned) 8-byte word */
+static inline gu_crc32c_t
+crc32c_word(gu_crc32c_t state, const uint8_t* const ptr)
+{
+    uint32_t slices[2];
+    memcpy(slices, ptr, sizeof(slices));
+
+    gu_crc32c_t state0 = gu_le32(slices[0]) ^ state;
+    GU_CRC32C_4BYTE_BLOCK(state0, 4);
+
+    gu_crc32c_t state1 = gu_le32(slices[1]);
+    GU_CRC32C_4BYTE_BLOCK(state1, 0);
+
+    return state0 ^ state1;
+}
+
+void
+gu_crc32c4_slicing_by_8(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                        const void* data, size_t stripes)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+
+    gu_crc32c_t l0 = lanes[0];
+    gu_crc32c_t l1 = lanes[1];
+    gu_crc32c_t l2 = lanes[2];
+    gu_crc32c_t l3 = lanes[3];
+
+    for (; stripes > 0; stripes--, ptr += GU_CRC32C4_STRIPE)
+    {
+        l0 = crc32c_word(l0, ptr);
+        l1 = crc32c_word(l1, ptr + 8);
+        l2 = crc32c_word(l2, ptr + 16);
+        l3 = crc32c_word(l3, ptr + 24);
+    }
+
+    lanes[0] = l0;
+    lanes[1] = l1;
+    lanes[2] = l2;
+    lanes[3] = l3;
+}
+
+gu_crc32c4_func_t gu_crc32c4_func = NULL;
+
+void
+gu_crc32c4_init(gu_crc32c4_ctx_t* const ctx)
+{
+    int i;
+    for (i = 0; i < GU_CRC32C4_LANES; i++) ctx->lanes[i] = GU_CRC32C_INIT;
+    ctx->tail_len = 0;
+}
+
+void
+gu_crc32c4_append(gu_crc32c4_ctx_t* const ctx, const void* const data,
+                  size_t size)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+
+    if (ctx->tail_len > 0)
+    {
+        size_t to_copy = GU_CRC32C4_STRIPE - ctx->tail_len;
+        if (to_copy > size) to_copy = size;
+
+        memcpy(ctx->tail + ctx->tail_len, ptr, to_copy);
+        ctx->tail_len += to_copy;
+        ptr  += to_copy;
+        size -= to_copy;
+
+        if (ctx->tail_len < GU_CRC32C4_STRIPE) return;
+
+        gu_crc32c4_func(ctx->lanes, ctx->tail, 1);
+        ctx->tail_len = 0;
+    }
+
+    size_t const stripes = size / GU_CRC32C4_STRIPE;
+
+    if (stripes > 0)
+    {
+        gu_crc32c4_func(ctx->lanes, ptr, stripes);
+        ptr  += stripes * GU_CRC32C4_STRIPE;
+        size -= stripes * GU_CRC32C4_STRIPE;
+    }
+
+    assert(size < GU_CRC32C4_STRIPE);
+
+    memcpy(ctx->tail, ptr, size);
+    ctx->tail_len = size;
+}
+
+void
+gu_crc32c4_get(const gu_crc32c4_ctx_t* const ctx, void* const res)
+{
+    gu_crc32c_t lanes[GU_CRC32C4_LANES];
+    memcpy(lanes, ctx->lanes, sizeof(lanes));
+
+    /* whole words of the incomplete stripe go to their lanes,
+     * the remaining bytes - to the next lane */
+    size_t const words = ctx->tail_len / sizeof(uint64_t);
+    size_t const rest  = ctx->tail_len % sizeof(uint64_t);
+    size_t i;
+
+    assert(words < GU_CRC32C4_LANES);
+
+    for (i = 0; i < words; i++)
+    {
+        lanes[i] = crc32c_word(lanes[i], ctx->tail + i*sizeof(uint64_t));
+    }
+
+    if (rest > 0)
+    {
+        lanes[words] = gu_crc32c_func(lanes[words],
+                                      ctx->tail + words*sizeof(uint64_t),
+                                      rest);
+    }
+
+    uint8_t* const out = (uint8_t*)res;
+
+    for (i = 0; i < GU_CRC32C4_LANES; i++)
+    {
+        uint32_t const val = gu_le32(gu_crc32c_get(lanes[i]));
+        memcpy(out + i*sizeof(val), &val, sizeof(val));
+    }
+}
+
+static gu_crc32c4_func_t
+crc32c4_best_algorithm()
+{
+    gu_crc32c4_func_t ret = NULL;
+
+#if !defined(GU_CRC32C_NO_HARDWARE)
+    ret = gu_crc32c4_hardware();
+#endif
+
+    if (!ret)
+    {
+        gu_info ("CRC-32C 4-lane: using \"slicing-by-8\" algorithm.");
+        ret = gu_crc32c4_slicing_by_8;
+    }
+
+    return ret;
+}
+
 static gu_crc32c_func_t
 crc32c_best_algorithm()
 {
@@ -216,4 +359,5 @@ gu_crc32c_configure()
 {
     crc32c_compute_lut();
     gu_crc32c_func = crc32c_best_algorithm();
+    gu_crc32c4_func = crc32c4_best_algorithm();
 }
@@ -64,6 +64,46 @@ gu_crc32c_slicing_by_4(gu_crc32c_t state, const void* data, size_t length);
 extern gu_crc32c_t
 gu_crc32c_slicing_by_8(gu_crc32c_t state, const void* data, size_t length);
 
+/*
+ * 128-bit checksum made of 4 independent CRC-32C lanes: 8-byte word i of
+ * the stream goes to lane i % 4, trailing bytes that don't make a whole word
+ * go to the next lane in turn. Independent lanes let CPU pipeline crc32
+ * instructions, so it is ~3x faster than a single CRC-32C stream.
+ */
+#define GU_CRC32C4_LANES  4
+#define GU_CRC32C4_STRIPE (GU_CRC32C4_LANES * sizeof(uint64_t))
+#define GU_CRC32C4_SIZE   (GU_CRC32C4_LANES * sizeof(gu_crc32c_t))
+
+/*! processes given number of whole stripes (GU_CRC32C4_STRIPE bytes) */
+typedef void (*gu_crc32c4_func_t) (gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                                   const void* data,
+                                   size_t      stripes);
+
+extern gu_crc32c4_func_t gu_crc32c4_func;
+
+/* Portable software-only implementation for gu_crc32c4_func */
+extern void
+gu_crc32c4_slicing_by_8(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                        const void* data, size_t stripes);
+
+typedef struct gu_crc32c4_ctx
+{
+    gu_crc32c_t lanes[GU_CRC32C4_LANES];
+    uint8_t     tail[GU_CRC32C4_STRIPE]; /* incomplete stripe */
+    size_t      tail_len;
+}
+gu_crc32c4_ctx_t;
+
+extern void
+gu_crc32c4_init  (gu_crc32c4_ctx_t* ctx);
+
+extern void
+gu_crc32c4_append(gu_crc32c4_ctx_t* ctx, const void* data, size_t size);
+
+/*! writes GU_CRC32C4_SIZE bytes of little-endian lane values to res */
+extern void
+gu_crc32c4_get   (const gu_crc32c4_ctx_t* ctx, void* res);
+
 #if !defined(GU_CRC32C_NO_HARDWARE)
 
 #if defined(__x86_64) || defined(_M_AMD64) || defined(_M_X64)
@@ -81,6 +121,9 @@ gu_crc32c_x86(gu_crc32c_t state, const void* data, size_t length);
 #if defined(GU_CRC32C_X86_64)
 extern gu_crc32c_t
 gu_crc32c_x86_64(gu_crc32c_t state, const void* data, size_t length);
+extern void
+gu_crc32c4_x86_64(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                  const void* data, size_t stripes);
 #endif /* GU_CRC32C_X86_64 */
 #endif /* GU_CRC32C_X86 */
 
@@ -88,11 +131,16 @@ gu_crc32c_x86_64(gu_crc32c_t state, const void* data, size_t length);
 #define GU_CRC32C_ARM64
 extern gu_crc32c_t
 gu_crc32c_arm64(gu_crc32c_t state, const void* data, size_t length);
+extern void
+gu_crc32c4_arm64(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                 const void* data, size_t stripes);
 #endif /* __aarch64__ || __AARCH64__ */
 
 #if defined(GU_CRC32C_X86) || defined(GU_CRC32C_ARM64)
 /** Returns hardware-accelerated CRC32C implementation */
 extern gu_crc32c_func_t gu_crc32c_hardware();
+/** Returns hardware-accelerated 4-lane CRC32C implementation */
+extern gu_crc32c4_func_t gu_crc32c4_hardware();
 #else
 #define GU_CRC32C_NO_HARDWARE 1
 #endif
@@ -18,6 +18,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <string.h> // memcpy()
 
 #include <arm_acle.h>
 
@@ -68,6 +69,35 @@ gu_crc32c_arm64(gu_crc32c_t state, const void* data, size_t len)
     return crc32c_arm64_tail7(state, ptr, len);
 }
 
+void
+gu_crc32c4_arm64(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                 const void* data, size_t stripes)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+
+    /* 4 independent dependency chains hide crc32 instruction latency */
+    gu_crc32c_t l0 = lanes[0];
+    gu_crc32c_t l1 = lanes[1];
+    gu_crc32c_t l2 = lanes[2];
+    gu_crc32c_t l3 = lanes[3];
+
+    for (; stripes > 0; stripes--, ptr += GU_CRC32C4_STRIPE)
+    {
+        uint64_t w[GU_CRC32C4_LANES];
+        memcpy(w, ptr, sizeof(w));
+
+        l0 = __crc32cd(l0, w[0]);
+        l1 = __crc32cd(l1, w[1]);
+        l2 = __crc32cd(l2, w[2]);
+        l3 = __crc32cd(l3, w[3]);
+    }
+
+    lanes[0] = l0;
+    lanes[1] = l1;
+    lanes[2] = l2;
+    lanes[3] = l3;
+}
+
 #include <sys/auxv.h>
 
 #if defined(__FreeBSD__)
@@ -110,4 +140,19 @@ gu_crc32c_hardware()
 #endif /* GU_AT_HWCAP */
 }
 
+gu_crc32c4_func_t
+gu_crc32c4_hardware()
+{
+#if defined(GU_AT_HWCAP)
+    unsigned long int const hwcaps = getauxval(GU_AT_HWCAP);
+    if (hwcaps & GU_HWCAP_CRC32)
+    {
+        gu_info ("CRC-32C 4-lane: using hardware acceleration.");
+        return gu_crc32c4_arm64;
+    }
+#endif /* GU_AT_HWCAP */
+
+    return NULL;
+}
+
 #endif /* GU_CRC32C_ARM64 */
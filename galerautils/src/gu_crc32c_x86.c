@@ -18,6 +18,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <string.h> // memcpy()
 
 /* process data preceding the first 4-aligned byte */
 static inline gu_crc32c_t
@@ -143,6 +144,47 @@ gu_crc32c_x86_64(gu_crc32c_t state, const void* data, size_t len)
 
     return crc32c_x86(state, ptr, len);
 }
+
+void
+gu_crc32c4_x86_64(gu_crc32c_t lanes[GU_CRC32C4_LANES],
+                  const void* data, size_t stripes)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+
+#ifdef __LP64__
+    /* 4 independent dependency chains hide crc32 instruction latency */
+    uint64_t l0 = lanes[0];
+    uint64_t l1 = lanes[1];
+    uint64_t l2 = lanes[2];
+    uint64_t l3 = lanes[3];
+
+    for (; stripes > 0; stripes--, ptr += GU_CRC32C4_STRIPE)
+    {
+        uint64_t w[GU_CRC32C4_LANES];
+        memcpy(w, ptr, sizeof(w)); /* unaligned access is fine on x86 */
+
+        l0 = __builtin_ia32_crc32di(l0, w[0]);
+        l1 = __builtin_ia32_crc32di(l1, w[1]);
+        l2 = __builtin_ia32_crc32di(l2, w[2]);
+        l3 = __builtin_ia32_crc32di(l3, w[3]);
+    }
+
+    lanes[0] = (uint32_t)l0;
+    lanes[1] = (uint32_t)l1;
+    lanes[2] = (uint32_t)l2;
+    lanes[3] = (uint32_t)l3;
+#else
+    for (; stripes > 0; stripes--, ptr += GU_CRC32C4_STRIPE)
+    {
+        int i;
+        for (i = 0; i < GU_CRC32C4_LANES; i++)
+        {
+            lanes[i] = crc32c_x86(lanes[i], ptr + i*sizeof(uint64_t),
+                                  sizeof(uint64_t));
+        }
+    }
+#endif /* __LP64__ */
+}
 #endif /* GU_CRC32C_X86_64 */
 
 #include <cpuid.h>
@@ -180,4 +222,21 @@ gu_crc32c_hardware()
     }
 }
 
+gu_crc32c4_func_t
+gu_crc32c4_hardware()
+{
+#if defined(GU_CRC32C_X86_64)
+    static uint32_t const SSE42_BIT = 1 << 20;
+    uint32_t const cpuid = x86_cpuid(1);
+
+    if (cpuid & SSE42_BIT)
+    {
+        gu_info ("CRC-32C 4-lane: using 64-bit x86 acceleration.");
+        return gu_crc32c4_x86_64;
+    }
+#endif /* GU_CRC32C_X86_64 */
+
+    return NULL;
+}
+
 #endif /* GU_CRC32C_X86 */
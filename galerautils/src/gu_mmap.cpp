@@ -79,6 +79,24 @@ namespace gu
         }
     }
 
+    void
+    MMap::advise_sequential(bool const sequential) const
+    {
+        int const advice(sequential ? POSIX_MADV_SEQUENTIAL :
+                         POSIX_MADV_NORMAL);
+
+        /* returns error number, errno is not set */
+        int const err(posix_madvise(reinterpret_cast<char*>(ptr), size,
+                                    advice));
+        if (err)
+        {
+            log_warn << "Failed to set "
+                     << (sequential ? "MADV_SEQUENTIAL" : "MADV_NORMAL")
+                     << " on " << ptr << ": " << err << " ("
+                     << strerror(err) << ')';
+        }
+    }
+
     void
     MMap::sync(void* const addr, size_t const length) const
     {
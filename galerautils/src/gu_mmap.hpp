@@ -25,6 +25,8 @@ public:
     ~MMap ();
 
     void dont_need() const;
+    /* MADV_SEQUENTIAL if true, MADV_NORMAL otherwise */
+    void advise_sequential(bool sequential) const;
     void sync(void *addr, size_t length) const;
     void sync() const;
     void unmap();
@@ -22,6 +22,7 @@
 #include "gu_limits.h"
 
 #include <iomanip>
+#include <limits>
 
 namespace gu
 {
@@ -35,6 +36,7 @@ RecordSet::check_size (RecordSet::CheckType const ct)
     case RecordSet::CHECK_MMH32:  return 4;
     case RecordSet::CHECK_MMH64:  return 8;
     case RecordSet::CHECK_MMH128: return 16;
+    case RecordSet::CHECK_CRC32C4: return GU_CRC32C4_SIZE;
 #define MAX_CHECKSUM_SIZE                16
     }
 
@@ -80,6 +82,7 @@ RecordSetOutBase::header_size_max() const
     case VER1:
         return header_size_max_v1();
     case VER2:
+    case VER3:
         return header_size_max_v2();
     }
 
@@ -197,6 +200,7 @@ RecordSetOutBase::header_size() const
     case VER1:
         return header_size_v1(size_, count_);
     case VER2:
+    case VER3:
         return header_size_v2(size_, count_);
     }
 
@@ -232,6 +236,7 @@ RecordSetOutBase::write_header (byte_t* const buf, ssize_t const size)
     switch (version())
     {
     case VER2:
+    case VER3:
         if (VER2_REDUCTION == off) /* 4 byte header version */
         {
             /* comparison above is a valid condition only if VER2_SIZE_MAX is
@@ -295,7 +300,7 @@ RecordSetOutBase::gather (GatherVector& out)
 #endif /* NDEBUG */
         unsigned int pad_size(0);
 
-        if (gu_likely(VER2 == version()))
+        if (gu_likely(version() >= VER2))
         {
             /* make sure size_ is padded to multiple of VER2_ALIGNMENT */
             int const dangling_bytes(size_ % VER2_ALIGNMENT);
@@ -340,6 +345,25 @@ RecordSetOutBase::gather (GatherVector& out)
     }
 }
 
+void
+RecordSetOutBase::payload (GatherVector& out) const
+{
+    if (0 == count_) return;
+
+    /* header space reserved in the first page by constructor */
+    ssize_t const reserved(header_size_max() + check_size(check_type()));
+
+    assert(bufs_->front().size >= reserved);
+
+    Buf const front =
+        { static_cast<const byte_t*>(bufs_->front().ptr) + reserved,
+          bufs_->front().size - reserved };
+
+    if (front.size > 0) out->push_back(front);
+
+    out->insert (out->end(), bufs_->begin() + 1, bufs_->end());
+}
+
 static inline byte_t
 rset_alignment(RecordSet::Version ver)
 {
@@ -377,7 +401,7 @@ RecordSetOutBase::RecordSetOutBase (byte_t*                 reserved,
     max_size_   (max_size),
 #endif
     alloc_      (base_name, reserved, reserved_size, max_heap),
-    check_      (),
+    check_      (ct),
     bufs_       (),
     prev_stored_(true)
 {
@@ -420,16 +444,19 @@ header_check_type(RecordSet::Version const ver,
     case RecordSet::EMPTY: assert(0); return RecordSet::CHECK_NONE;
     case RecordSet::VER1:
     case RecordSet::VER2:
+    case RecordSet::VER3:
     {
         int const ct(ptr[0] & 0x07);
 
         switch (ct)
         {
         case RecordSet::CHECK_NONE:   return RecordSet::CHECK_NONE;
-        case RecordSet::CHECK_MMH32:  if (RecordSet::VER2 == ver) break;
+        case RecordSet::CHECK_MMH32:  if (ver >= RecordSet::VER2) break;
             return RecordSet::CHECK_MMH32;
         case RecordSet::CHECK_MMH64:  return RecordSet::CHECK_MMH64;
         case RecordSet::CHECK_MMH128: return RecordSet::CHECK_MMH128;
+        case RecordSet::CHECK_CRC32C4: if (ver < RecordSet::VER3) break;
+            return RecordSet::CHECK_CRC32C4;
         }
 
         gu_throw_error (EPROTO) << "Unsupported RecordSet checksum type: " << ct;
@@ -460,8 +487,19 @@ static inline size_t
 read_size_count_v1_2(const byte_t* head_, size_t const size, size_t off,
                      ssize_t& size_, int& count_)
 {
-    off += uleb128_decode (head_ + off, size - off, size_);
-    off += uleb128_decode (head_ + off, size - off, count_);
+    uint64_t sc[2];
+    off = uleb128_decode_batch (head_, size, off, sc, 2);
+
+    /* same limits as decoding into ssize_t and int would impose */
+    if (gu_unlikely(sc[0] > uint64_t(std::numeric_limits<ssize_t>::max()) ||
+                    sc[1] > std::numeric_limits<uint32_t>::max()))
+    {
+        gu_throw_error (EOVERFLOW) << "RecordSet size " << sc[0]
+                                   << " or count " << sc[1] << " overflow";
+    }
+
+    size_  = sc[0];
+    count_ = sc[1];
     return off;
 }
 
@@ -485,7 +523,7 @@ RecordSetInBase::parse_header_v1_2 (size_t const size)
 
     size_t off;
 
-    if (VER2 == version() && (head_[0] & VER2_SHORT_FLAG))
+    if (version() >= VER2 && (head_[0] & VER2_SHORT_FLAG))
     {
         off = read_size_count_v2_short(head_, size_, count_);
     }
@@ -538,14 +576,14 @@ RecordSetInBase::checksum() const
 
     if (cs > 0) /* checksum records */
     {
-        Hash check;
+        RecordSetCheck check(check_type());
 
         check.append (head_ + begin_, serial_size() - begin_); /* records */
         check.append (head_, begin_ - cs);                     /* header  */
 
         assert(cs <= MAX_CHECKSUM_SIZE);
         byte_t result[MAX_CHECKSUM_SIZE];
-        check.gather<sizeof(result)>(result);
+        check.gather(result, sizeof(result));
 
         const byte_t* const stored_checksum(head_ + begin_ - cs);
 
@@ -606,6 +644,7 @@ RecordSetInBase::init (const byte_t* const ptr,
     case EMPTY: return;
     case VER1:
     case VER2:
+    case VER3:
         assert(0 != alignment());
         if (alignment() > 1) assert((uintptr_t(head_) % GU_WORD_BYTES) == 0);
         parse_header_v1_2(size); // should set begin_
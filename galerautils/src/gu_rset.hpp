@@ -16,6 +16,7 @@
 #include "gu_vector.hpp"
 #include "gu_alloc.hpp"
 #include "gu_digest.hpp"
+#include "gu_crc.hpp"
 
 #include "gu_limits.h" // GU_MIN_ALIGNMENT
 
@@ -35,10 +36,11 @@ public:
     {
         EMPTY = 0,
         VER1,
-        VER2
+        VER2,
+        VER3  /* VER2 + CHECK_CRC32C4 */
     };
 
-    static Version const MAX_VERSION    = VER2;
+    static Version const MAX_VERSION    = VER3;
     static int     const VER2_ALIGNMENT = GU_MIN_ALIGNMENT;
 
     enum CheckType
@@ -46,7 +48,8 @@ public:
         CHECK_NONE   = 0,
         CHECK_MMH32,
         CHECK_MMH64,
-        CHECK_MMH128
+        CHECK_MMH128,
+        CHECK_CRC32C4  /* requires VER3 */
     };
 
     static int check_size(CheckType ct);
@@ -97,6 +100,43 @@ protected:
     ~RecordSet() {}
 };
 
+/*! payload checksum of a RecordSet, algorithm depends on CheckType */
+class RecordSetCheck
+{
+public:
+
+    explicit
+    RecordSetCheck (RecordSet::CheckType const ct = RecordSet::CHECK_NONE)
+        : mmh_(), crc_(), crc32c4_(RecordSet::CHECK_CRC32C4 == ct)
+    {}
+
+    void append (const void* const buf, size_t const size)
+    {
+        if (crc32c4_) crc_.append(buf, size); else mmh_.append(buf, size);
+    }
+
+    /*! writes at most size bytes of checksum to buf */
+    void gather (void* const buf, size_t const size) const
+    {
+        if (crc32c4_)
+        {
+            byte_t tmp[CRC32C4::SIZE];
+            crc_.gather16(tmp);
+            ::memcpy(buf, tmp, std::min(size, sizeof(tmp)));
+        }
+        else
+        {
+            mmh_.gather(buf, size);
+        }
+    }
+
+private:
+
+    Hash    mmh_;
+    CRC32C4 crc_;
+    bool    crc32c4_;
+};
+
 /*! specialization of Vector::serialize() method */
 template<> inline RecordSet::GatherVector::size_type
 RecordSet::GatherVector::serialize(void*     const buf,
@@ -139,6 +179,10 @@ public:
     /*! return vector of RecordSet fragments in adjusent order */
     ssize_t gather (GatherVector& out);
 
+    /*! return vector of record fragments without header and padding,
+     *  must be called before gather() */
+    void payload (GatherVector& out) const;
+
 protected:
 
     RecordSetOutBase() : RecordSet() {}
@@ -235,7 +279,7 @@ private:
     ssize_t const max_size_;
 #endif
     Allocator     alloc_;
-    Hash          check_;
+    RecordSetCheck check_;
     Vector<Buf, Allocator::INITIAL_VECTOR_SIZE> bufs_;
     bool          prev_stored_;
 
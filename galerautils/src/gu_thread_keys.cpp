@@ -35,6 +35,8 @@ static struct ThreadKeysVecInitializer
             std::make_pair("gcs_recv", (wsrep_thread_key_t*)(0)));
         thread_keys_vec.push_back(
             std::make_pair("gcs_gcomm", (wsrep_thread_key_t*)(0)));
+        thread_keys_vec.push_back(
+            std::make_pair("gcache_cold", (wsrep_thread_key_t*)(0)));
         assert(thread_keys_vec.size() == gu::GU_THREAD_KEY_MAX);
     }
     const char* name;
@@ -52,6 +54,10 @@ public:
             std::make_pair("certification", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("certification_stats", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("certification_order", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("certification_index", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("pending_certification", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
@@ -104,12 +110,20 @@ public:
             std::make_pair("saved_state", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("gcache", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("gcache_page_pool", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("gcache_cold", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("gcs_membership", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("writeset_waiter_map", (wsrep_mutex_key_t*)(0)));
         mutex_keys_vec.push_back(
             std::make_pair("writeset_waiter", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("checksum_pool", (wsrep_mutex_key_t*)(0)));
+        mutex_keys_vec.push_back(
+            std::make_pair("alloc_page_pool", (wsrep_mutex_key_t*)(0)));
         assert(mutex_keys_vec.size() == gu::GU_MUTEX_KEY_MAX);
     }
     const char* name;
@@ -170,8 +184,20 @@ static struct CondKeysVecInitializer
             std::make_pair("gcs_core_caused", (wsrep_cond_key_t*)(0)));
         cond_keys_vec.push_back(
             std::make_pair("gcache", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("gcache_page_pool", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("gcache_cold", (wsrep_cond_key_t*)(0)));
         cond_keys_vec.push_back(
             std::make_pair("write_set_waiter", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("checksum_pool", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("checksum_pool_done", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("alloc_page_pool", (wsrep_cond_key_t*)(0)));
+        cond_keys_vec.push_back(
+            std::make_pair("certification_purge", (wsrep_cond_key_t*)(0)));
         assert(cond_keys_vec.size() == gu::GU_COND_KEY_MAX);
     }
     const char* name;
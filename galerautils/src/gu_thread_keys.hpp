@@ -22,6 +22,7 @@ namespace gu
         GU_THREAD_KEY_WRITE_SET_CHECK,
         GU_THREAD_KEY_GCS_RECV,
         GU_THREAD_KEY_GCS_GCOMM,
+        GU_THREAD_KEY_GCACHE_COLD,
         GU_THREAD_KEY_MAX // must be the last
     };
 
@@ -31,6 +32,8 @@ namespace gu
     {
         GU_MUTEX_KEY_CERTIFICATION,
         GU_MUTEX_KEY_CERTIFICATION_STATS,
+        GU_MUTEX_KEY_CERTIFICATION_ORDER,
+        GU_MUTEX_KEY_CERTIFICATION_INDEX,
         GU_MUTEX_KEY_PENDING_CERTIFICATION,
         GU_MUTEX_KEY_LOCAL_MONITOR,
         GU_MUTEX_KEY_APPLY_MONITOR,
@@ -57,9 +60,13 @@ namespace gu
         GU_MUTEX_KEY_GCS_CORE_CAUSED,
         GU_MUTEX_KEY_SAVED_STATE,
         GU_MUTEX_KEY_GCACHE,
+        GU_MUTEX_KEY_GCACHE_PAGE_POOL,
+        GU_MUTEX_KEY_GCACHE_COLD,
         GU_MUTEX_KEY_GCS_MEMBERSHIP,
         GU_MUTEX_KEY_WRITESET_WAITER_MAP,
         GU_MUTEX_KEY_WRITESET_WAITER,
+        GU_MUTEX_KEY_CHECKSUM_POOL,
+        GU_MUTEX_KEY_ALLOC_PAGE_POOL,
         GU_MUTEX_KEY_MAX /* This must always be the last */
     };
 
@@ -91,7 +98,13 @@ namespace gu
         GU_COND_KEY_GCS_FIFO_LITE_GET,
         GU_COND_KEY_GCS_CORE_CAUSED,
         GU_COND_KEY_GCACHE,
+        GU_COND_KEY_GCACHE_PAGE_POOL,
+        GU_COND_KEY_GCACHE_COLD,
         GU_COND_KEY_WRITESET_WAITER,
+        GU_COND_KEY_CHECKSUM_POOL,
+        GU_COND_KEY_CHECKSUM_POOL_DONE,
+        GU_COND_KEY_ALLOC_PAGE_POOL,
+        GU_COND_KEY_CERTIFICATION_PURGE,
         GU_COND_KEY_MAX /* This must always be the last */
     };
 
@@ -1,5 +1,5 @@
 //
-// Copyright (C) 2013 Codership Oy <info@codership.com>
+// Copyright (C) 2013-2026 Codership Oy <info@codership.com>
 //
 
 //!
@@ -12,9 +12,136 @@
 //
 
 #include "gu_vlq.hpp"
+#include "gu_byteswap.h"
+
+#include <cstring> // memcpy()
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GU_VLQ_BMI2
+#endif
+
+namespace
+{
+    uint64_t const VLQ_STOP(0x8080808080808080ULL); // continuation bits
+    uint64_t const VLQ_DATA(0x7f7f7f7f7f7f7f7fULL); // payload bits
+
+    /* Compacts 7-bit groups of a little-endian word into 56 bit value:
+     * 8 -> 14 -> 28 -> 56 bit lanes. */
+    struct ExtractGeneric
+    {
+        static inline uint64_t extract(uint64_t w)
+        {
+            w &= VLQ_DATA;
+            w = ((w & 0x7f007f007f007f00ULL) >> 1) |
+                 (w & 0x007f007f007f007fULL);
+            w = ((w & 0x3fff00003fff0000ULL) >> 2) |
+                 (w & 0x00003fff00003fffULL);
+            w = ((w & 0x0fffffff00000000ULL) >> 4) |
+                 (w & 0x000000000fffffffULL);
+            return w;
+        }
+    };
+
+#ifdef GU_VLQ_BMI2
+    /* inline assembly does not require the whole function to be compiled
+     * for BMI2 target, the instruction is only used if CPU supports it */
+    struct ExtractBMI2
+    {
+        static inline uint64_t extract(uint64_t const w)
+        {
+            uint64_t ret;
+            __asm__ ("pextq %2, %1, %0" : "=r"(ret) : "r"(w), "r"(VLQ_DATA));
+            return ret;
+        }
+    };
+#endif /* GU_VLQ_BMI2 */
+
+    template <class X>
+    size_t
+    decode_batch(const gu::byte_t* const buf,
+                 size_t            const buflen,
+                 size_t                  offset,
+                 uint64_t*         const values,
+                 size_t            const n)
+    {
+        size_t i(0);
+
+        for (; i < n && offset + sizeof(uint64_t) <= buflen; ++i)
+        {
+            uint64_t w;
+            ::memcpy(&w, buf + offset, sizeof(w));
+            w = gu_le64(w);
+
+            uint64_t const stops(~w & VLQ_STOP);
+
+            if (gu_likely(stops != 0))
+            {
+                /* terminating byte is the lowest without continuation bit,
+                 * mask away the bytes past it */
+                unsigned int const bits(__builtin_ctzll(stops) + 1);
+                uint64_t const mask(bits < 64 ?
+                                    (uint64_t(1) << bits) - 1 : ~uint64_t(0));
+
+                values[i] = X::extract(w & mask);
+                offset += bits >> 3;
+            }
+            else
+            {
+                /* longer than 8 bytes */
+                offset = gu::uleb128_decode(buf, buflen, offset, values[i]);
+            }
+        }
+
+        for (; i < n; ++i) // tail of the buffer
+        {
+            offset = gu::uleb128_decode(buf, buflen, offset, values[i]);
+        }
+
+        return offset;
+    }
+
+    typedef size_t (*decode_batch_t)(const gu::byte_t*, size_t, size_t,
+                                     uint64_t*, size_t);
+
+    decode_batch_t
+    select_decode_batch()
+    {
+#ifdef GU_VLQ_BMI2
+        __builtin_cpu_init();
+
+        /* AMD CPUs before Zen3 implement PEXT in microcode which is much
+         * slower than the generic version */
+        if (__builtin_cpu_supports("bmi2") && __builtin_cpu_is("intel"))
+        {
+            return decode_batch<ExtractBMI2>;
+        }
+#endif /* GU_VLQ_BMI2 */
+
+        return decode_batch<ExtractGeneric>;
+    }
+} /* namespace */
 
 namespace gu
 {
+    size_t uleb128_decode_batch(const byte_t* const buf,
+                                size_t        const buflen,
+                                size_t        const offset,
+                                uint64_t*     const values,
+                                size_t        const n)
+    {
+        static decode_batch_t const func(select_decode_batch());
+        return func(buf, buflen, offset, values, n);
+    }
+
+    size_t uleb128_decode_batch_generic(const byte_t* const buf,
+                                        size_t        const buflen,
+                                        size_t        const offset,
+                                        uint64_t*     const values,
+                                        size_t        const n)
+    {
+        return decode_batch<ExtractGeneric>(buf, buflen, offset, values, n);
+    }
+
     /* checks helper for the uleb128_decode() */
     void uleb128_decode_checks (const byte_t* buf,
                                 size_t        buflen,
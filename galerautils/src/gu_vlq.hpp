@@ -21,6 +21,7 @@
 #include <cassert>
 
 #include <cassert>
+#include <stdint.h>
 
 #define GU_VLQ_CHECKS
 #define GU_VLQ_ALEX
@@ -189,6 +190,36 @@ namespace gu
     {
         return uleb128_decode(buf, buflen, 0, value);
     }
+
+    //!
+    // @brief Decode a sequence of unsigned 64-bit integers from ULEB128
+    //        representation
+    //
+    // Values are decoded a machine word at a time without branching on
+    // every byte, using BMI2 where it is fast. Values longer than 8 bytes
+    // and values close to the end of the buffer go through the scalar
+    // uleb128_decode() above, so the checks are the same.
+    //
+    // @param buf
+    // @param buflen
+    // @param offset offset of the first value
+    // @param values array of at least n elements to store decoded values
+    // @param n      number of values to decode
+    //
+    // @return Offset past the last decoded value
+    //
+    extern size_t uleb128_decode_batch(const byte_t* buf,
+                                       size_t        buflen,
+                                       size_t        offset,
+                                       uint64_t*     values,
+                                       size_t        n);
+
+    /* portable implementation of the above, for testing */
+    extern size_t uleb128_decode_batch_generic(const byte_t* buf,
+                                               size_t        buflen,
+                                               size_t        offset,
+                                               uint64_t*     values,
+                                               size_t        n);
 }
 
 #endif // GU_VLQ_HPP
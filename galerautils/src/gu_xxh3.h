@@ -0,0 +1,59 @@
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+
+/**
+ * @file XXH3 128-bit hash
+ *
+ * Thin wrapper around the reference implementation in xxhash.h (xxHash
+ * 0.8.2), which is compiled inline here, so it does not add any symbols.
+ * XXH3 reads messages up to 16 bytes in one or two loads and needs no
+ * streaming context for them.
+ *
+ * The result words are returned in host byte order, gu_xxh3_128() returns
+ * the canonical (big-endian) representation as defined by xxHash, so it is
+ * globally consistent.
+ */
+
+#ifndef _gu_xxh3_h_
+#define _gu_xxh3_h_
+
+#include "gu_macros.h"
+
+#include <stdint.h>
+#include <string.h> // memcpy()
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @param msg  message to hash
+ * @param len  message length
+ * @param seed 64-bit seed, 0 gives the standard XXH3_128bits() result
+ * @param res  low and high 64-bit words of the result in host byte order
+ */
+static GU_INLINE void
+gu_xxh3_128_seeded (const void* const msg, size_t const len,
+                    uint64_t const seed, uint64_t res[2])
+{
+    XXH128_hash_t const h = XXH3_128bits_withSeed(msg, len, seed);
+    res[0] = h.low64;
+    res[1] = h.high64;
+}
+
+/*! returns hash in the canonical byte order, as a byte array */
+static GU_INLINE void
+gu_xxh3_128 (const void* const msg, size_t const len, void* const out)
+{
+    XXH128_canonical_t c;
+    XXH128_canonicalFromHash(&c, XXH3_128bits(msg, len));
+    memcpy(out, &c, sizeof(c));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _gu_xxh3_h_ */
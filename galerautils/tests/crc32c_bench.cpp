@@ -93,7 +93,55 @@ run_bench_with_impl(gu_crc32c_func_t impl,
               << std::fixed << duration << '\t' << result << '\n';
 }
 
-static gu_crc32c_func_t configured_impl;
+static uint32_t
+run_bench4(size_t const len, size_t const reps)
+{
+    static const size_t align_loop(sizeof(uint64_t));
+    if ((data.size() - len) < align_loop)
+        throw std::out_of_range("Too many reps");
+
+    gu_crc32c4_ctx_t ctx;
+    gu_crc32c4_init(&ctx);
+
+    for (size_t r(0); r < reps; ++r)
+        for (size_t i(0); i < align_loop; ++i)
+        {
+            gu_crc32c4_append(&ctx, &data[i], len);
+        }
+
+    uint32_t result[GU_CRC32C4_LANES];
+    gu_crc32c4_get(&ctx, result);
+
+    return result[0];
+}
+
+static void
+run_bench4_with_impl(gu_crc32c4_func_t impl,
+                     size_t            len,
+                     size_t            reps,
+                     const char*       comment)
+{
+    gu_crc32c4_func = impl;
+
+#if __cplusplus >= 201103L
+    auto const start(std::chrono::steady_clock::now());
+    uint32_t const result(run_bench4(len, reps));
+    auto const stop(std::chrono::steady_clock::now());
+    double const duration(std::chrono::duration<double>(stop - start).count());
+#else
+    struct timeval start, stop;
+    gettimeofday(&start, NULL);
+    uint32_t const result(run_bench4(len, reps));
+    gettimeofday(&stop,  NULL);
+    double const duration(time_diff(stop, start));
+#endif // C++11
+
+    std::cout << comment << '\t' << len << '\t'
+              << std::fixed << duration << '\t' << result << '\n';
+}
+
+static gu_crc32c_func_t  configured_impl;
+static gu_crc32c4_func_t configured_impl4;
 
 static void
 one_length(size_t const len, size_t const reps)
@@ -114,13 +162,21 @@ one_length(size_t const len, size_t const reps)
     if (gu_crc32c_arm64 == configured_impl)
         run_bench_with_impl(gu_crc32c_arm64,    len, reps, "GU arm64   ");
 #endif /* GU_CRC32C_X86 */
+
+    /* 4-lane variants, tail bytes go through the configured implementation */
+    gu_crc32c_func = configured_impl;
+
+    run_bench4_with_impl(gu_crc32c4_slicing_by_8, len, reps, "GU 4xSlice8");
+    if (gu_crc32c4_slicing_by_8 != configured_impl4)
+        run_bench4_with_impl(configured_impl4,    len, reps, "GU 4xHW    ");
 }
 
 int main()
 {
     gu_crc32c_configure(); // compute SW lookup tables
 
-    configured_impl = gu_crc32c_func;
+    configured_impl  = gu_crc32c_func;
+    configured_impl4 = gu_crc32c4_func;
 
     one_length(11,  1<<22 /* 4M   */);
     one_length(31,  1<<21 /* 2M   */);
@@ -6,6 +6,10 @@
 
 #include "gu_alloc_test.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 class TestBaseName : public gu::Allocator::BaseName
 {
     std::string str_;
@@ -82,10 +86,103 @@ START_TEST (basic)
 }
 END_TEST
 
+START_TEST (page_pool)
+{
+    size_t const page_size(gu::Allocator::PagePool::page_size());
+    size_t const pool_size(1 << 21); /* one chunk */
+    size_t const pool_pages(pool_size / page_size);
+
+    gu::Allocator::PagePool pool(pool_size, true);
+    ck_assert(0 == pool.size());
+    ck_assert(NULL == gu::Allocator::page_pool());
+    gu::Allocator::set_page_pool(&pool);
+
+    TestBaseName test_name("gu_alloc_test");
+    bool n;
+    void* first;
+
+    {
+        gu::Allocator a(test_name);
+        first = a.alloc(16, n);
+        ck_assert(NULL != first);
+        ck_assert(n);
+        ck_assert(1 == pool.used());
+        ck_assert(pool_size == pool.size());
+        memset(first, 'a', page_size); /* the whole page must be writable */
+    }
+    ck_assert(0 == pool.used());
+
+    {
+        gu::Allocator a(test_name);
+        void* const p(a.alloc(16, n));
+        ck_assert(first == p); /* page must be reused */
+        ck_assert(1 == pool.used());
+
+        /* oversized pages bypass the pool */
+        ck_assert(NULL != a.alloc(page_size + 1, n));
+        ck_assert(n);
+        ck_assert(1 == pool.used());
+    }
+    ck_assert(0 == pool.used());
+
+    {
+        /* exhaust the pool, allocators must fall back to heap */
+        std::vector<gu::Allocator*> as;
+        for (size_t i(0); i <= pool_pages; ++i)
+        {
+            as.push_back(new gu::Allocator(test_name));
+            ck_assert(NULL != as.back()->alloc(page_size, n));
+            ck_assert(n);
+        }
+        ck_assert(pool_pages == pool.used());
+        ck_assert(pool_size == pool.size());
+
+        for (size_t i(0); i < as.size(); ++i) delete as[i];
+    }
+    ck_assert(0 == pool.used());
+
+    gu::Allocator::set_page_pool(NULL);
+}
+END_TEST
+
+/* pool destructor waits for the pages to be returned */
+START_TEST (page_pool_destroy)
+{
+    TestBaseName test_name("gu_alloc_test");
+    std::thread thd;
+    std::atomic<bool> released(false);
+
+    {
+        gu::Allocator::PagePool pool(1 << 21, false);
+        gu::Allocator::set_page_pool(&pool);
+
+        gu::Allocator* const a(new gu::Allocator(test_name));
+        bool n;
+        ck_assert(NULL != a->alloc(16, n));
+        ck_assert(1 == pool.used());
+
+        gu::Allocator::set_page_pool(NULL);
+
+        thd = std::thread([a, &released]()
+                          {
+                              std::this_thread::sleep_for(
+                                  std::chrono::milliseconds(100));
+                              released = true;
+                              delete a;
+                          });
+    }
+
+    ck_assert(released);
+    thd.join();
+}
+END_TEST
+
 Suite* gu_alloc_suite ()
 {
     TCase* t = tcase_create ("Allocator");
     tcase_add_test (t, basic);
+    tcase_add_test (t, page_pool);
+    tcase_add_test (t, page_pool_destroy);
 
     Suite* s = suite_create ("gu::Allocator");
     suite_add_tcase (s, t);
@@ -0,0 +1,399 @@
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+
+#include "../src/gu_compress.hpp"
+
+#include "gu_compress_test.hpp"
+
+#include "../src/gu_exception.hpp"
+
+#include <cstdlib> // rand()
+#include <cstring>
+#include <string>
+#include <vector>
+
+using gu::Compression;
+
+/* compresses and decompresses src with t, returns compressed size */
+static size_t
+roundtrip(Compression::Type const t, const std::vector<gu::byte_t>& src)
+{
+    std::vector<gu::byte_t> packed(src.size() + src.size()/128 + 128);
+
+    size_t const packed_size(Compression::compress(t, src.data(), src.size(),
+                                                   packed.data(),
+                                                   packed.size()));
+    ck_assert_msg(packed_size > 0 || src.empty(),
+                  "%s failed to compress %zu bytes",
+                  Compression::name(t), src.size());
+
+    std::vector<gu::byte_t> res(src.size());
+    Compression::decompress(t, packed.data(), packed_size,
+                            res.data(), res.size());
+
+    ck_assert_msg(res == src, "%s: decompressed data differs, size %zu",
+                  Compression::name(t), src.size());
+
+    return packed_size;
+}
+
+static void
+test_type(Compression::Type const t)
+{
+    static size_t const sizes[] = { 0, 1, 12, 13, 100, 4096, 70000, 1 << 20 };
+
+    for (size_t i(0); i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+    {
+        std::vector<gu::byte_t> text(sizes[i]);
+        for (size_t j(0); j < text.size(); ++j)
+        {
+            /* repetitive with some noise, like row images */
+            text[j] = "INSERT INTO t1 VALUES "[j % 22] + (0 == j % 97);
+        }
+
+        size_t const packed_size(roundtrip(t, text));
+
+        if (t != Compression::NONE && text.size() >= 4096)
+        {
+            ck_assert_msg(packed_size < text.size()/4,
+                          "%s: poor compression of %zu bytes: %zu",
+                          Compression::name(t), text.size(), packed_size);
+        }
+
+        std::vector<gu::byte_t> noise(sizes[i]);
+        for (size_t j(0); j < noise.size(); ++j) noise[j] = ::rand();
+
+        roundtrip(t, noise);
+
+        /* incompressible data does not fit in a smaller buffer */
+        if (noise.size() >= 4096)
+        {
+            std::vector<gu::byte_t> small(noise.size() - 1);
+            ck_assert(0 == Compression::compress(t, noise.data(), noise.size(),
+                                                 small.data(), small.size()));
+        }
+    }
+}
+
+START_TEST(none)
+{
+    test_type(Compression::NONE);
+}
+END_TEST
+
+START_TEST(lz4)
+{
+    if (Compression::supported(Compression::LZ4))
+    {
+        test_type(Compression::LZ4);
+    }
+}
+END_TEST
+
+START_TEST(zstd)
+{
+    if (Compression::supported(Compression::ZSTD))
+    {
+        test_type(Compression::ZSTD);
+    }
+}
+END_TEST
+
+/* decodes LZ4 block with overlapping match made by hand */
+START_TEST(lz4_format)
+{
+    static gu::byte_t const block[] =
+    {
+        0x3c, 'a', 'b', 'c',           /* 3 literals, match length 4 + 12 */
+        0x03, 0x00,                    /* match offset 3 */
+        0x50, 'a', 'b', 'c', 'a', 'b'  /* 5 last literals */
+    };
+    static const char expected[] = "abc" "abcabcabcabcabca" "abcab";
+
+    std::vector<gu::byte_t> res(sizeof(expected) - 1);
+    Compression::decompress(Compression::LZ4, block, sizeof(block),
+                            res.data(), res.size());
+    ck_assert(0 == ::memcmp(res.data(), expected, res.size()));
+
+    /* wrong expected size */
+    std::vector<gu::byte_t> big(res.size() + 1);
+    try
+    {
+        Compression::decompress(Compression::LZ4, block, sizeof(block),
+                                big.data(), big.size());
+        ck_abort_msg("decompression to wrong size succeeded");
+    }
+    catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+
+    /* truncated block */
+    try
+    {
+        Compression::decompress(Compression::LZ4, block, 5,
+                                res.data(), res.size());
+        ck_abort_msg("decompression of truncated block succeeded");
+    }
+    catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+
+    /* match offset beyond the beginning of output */
+    gu::byte_t bad[sizeof(block)];
+    ::memcpy(bad, block, sizeof(block));
+    bad[4] = 0x04;
+    try
+    {
+        Compression::decompress(Compression::LZ4, bad, sizeof(bad),
+                                res.data(), res.size());
+        ck_abort_msg("decompression with bad offset succeeded");
+    }
+    catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+}
+END_TEST
+
+/* decodes blocks made by reference liblz4 1.9.4 LZ4_compress_default() */
+START_TEST(lz4_reference)
+{
+    /* 8 similar rows: short literals and matches */
+    static gu::byte_t const rows_block[] =
+    {
+        0xff, 0x15, 'I', 'N', 'S', 'E', 'R', 'T', ' ', 'I', 'N', 'T', 'O',
+        ' ', 't', '1', ' ', 'V', 'A', 'L', 'U', 'E', 'S', ' ', '(', '0',
+        ',', ' ', '\'', 'g', 'a', 'l', 'e', 'r', 'a', '\'', ')', ';',
+        0x24, 0x00, 0x04, 0x1f, '1', 0x24, 0x00, 0x10, 0x1f, '2', 0x24,
+        0x00, 0x10, 0x1f, '3', 0x24, 0x00, 0x10, 0x1f, '4', 0x24, 0x00,
+        0x10, 0x1f, '5', 0x24, 0x00, 0x10, 0x1f, '6', 0x24, 0x00, 0x10,
+        0x13, '7', 0x24, 0x00, 0x50, 'r', 'a', '\'', ')', ';'
+    };
+
+    std::string rows;
+    for (int i(0); i < 8; ++i)
+    {
+        rows += "INSERT INTO t1 VALUES (";
+        rows += char('0' + i);
+        rows += ", 'galera');";
+    }
+
+    std::vector<gu::byte_t> res(rows.size());
+    Compression::decompress(Compression::LZ4, rows_block, sizeof(rows_block),
+                            res.data(), res.size());
+    ck_assert(0 == ::memcmp(res.data(), rows.data(), rows.size()));
+
+    /* 256 distinct bytes followed by 1000 'x': length continuation bytes
+     * and long overlapping match */
+    std::vector<gu::byte_t> long_block;
+    long_block.push_back(0xff);
+    long_block.push_back(0xf4);
+    for (int i(0); i < 256; ++i) long_block.push_back(i);
+    long_block.insert(long_block.end(), 3, 'x');
+    static gu::byte_t const match[] = { 0x03, 0x00, 0xff, 0xff, 0xff, 0xd0,
+                                        0x50 };
+    long_block.insert(long_block.end(), match, match + sizeof(match));
+    long_block.insert(long_block.end(), 5, 'x');
+
+    std::vector<gu::byte_t> expected;
+    for (int i(0); i < 256; ++i) expected.push_back(i);
+    expected.insert(expected.end(), 1000, 'x');
+
+    res.resize(expected.size());
+    Compression::decompress(Compression::LZ4, long_block.data(),
+                            long_block.size(), res.data(), res.size());
+    ck_assert(res == expected);
+
+    /* and our own output for the same data is a valid block too */
+    roundtrip(Compression::LZ4, expected);
+}
+END_TEST
+
+/* Malformed input must be rejected with EINVAL without touching memory
+ * outside of the buffers: corrupted and truncated valid blocks and random
+ * garbage. */
+START_TEST(lz4_fuzz)
+{
+    std::vector<gu::byte_t> text(2000);
+    for (size_t j(0); j < text.size(); ++j)
+    {
+        text[j] = "INSERT INTO t1 VALUES "[j % 22] + (0 == j % 97);
+    }
+
+    std::vector<gu::byte_t> packed(text.size() * 2);
+    size_t const packed_size(Compression::compress(Compression::LZ4,
+                                                   text.data(), text.size(),
+                                                   packed.data(),
+                                                   packed.size()));
+    ck_assert(packed_size > 0);
+    packed.resize(packed_size);
+
+    /* deterministic LCG to make failures reproducible */
+    uint32_t seed(12345);
+    auto rnd([&seed]()
+             {
+                 seed = seed * 1103515245 + 12345;
+                 return seed >> 16;
+             });
+
+    size_t rejected(0);
+    static int const iterations(20000);
+
+    for (int i(0); i < iterations; ++i)
+    {
+        std::vector<gu::byte_t> in;
+
+        switch (i % 3)
+        {
+        case 0: /* a few corrupted bytes */
+            in = packed;
+            for (int k(rnd() % 4); k >= 0; --k) in[rnd() % in.size()] = rnd();
+            break;
+        case 1: /* truncated */
+            in.assign(packed.begin(), packed.begin() + rnd() % packed.size());
+            break;
+        case 2: /* garbage */
+            in.resize(rnd() % 64);
+            for (size_t k(0); k < in.size(); ++k) in[k] = rnd();
+            break;
+        }
+
+        /* output size is taken from the header and may be off too */
+        size_t const out_size(0 == rnd() % 4 ? rnd() % (2 * text.size()) :
+                              text.size());
+        std::vector<gu::byte_t> out(out_size);
+
+        try
+        {
+            Compression::decompress(Compression::LZ4, in.data(), in.size(),
+                                    out.data(), out.size());
+        }
+        catch (gu::Exception& e)
+        {
+            ck_assert(EINVAL == e.get_errno());
+            ++rejected;
+        }
+    }
+
+    ck_assert(rejected > iterations / 2);
+}
+END_TEST
+
+/* decodes frame made by reference libzstd 1.5.4 ZSTD_compress() level 3 */
+START_TEST(zstd_reference)
+{
+    static gu::byte_t const frame[] =
+    {
+        0x28, 0xb5, 0x2f, 0xfd, 0x60, 0x20, 0x00, 0x0d, 0x02, 0x00,
+        0xb4, 0x02, 0x49, 0x4e, 0x53, 0x45, 0x52, 0x54, 0x20, 0x49,
+        0x4e, 0x54, 0x4f, 0x20, 0x74, 0x31, 0x20, 0x56, 0x41, 0x4c,
+        0x55, 0x45, 0x53, 0x20, 0x28, 0x30, 0x2c, 0x20, 0x27, 0x67,
+        0x61, 0x6c, 0x65, 0x72, 0x61, 0x27, 0x29, 0x3b, 0x31, 0x32,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x08, 0x00, 0x80, 0x13, 0x80,
+        0x3c, 0x80, 0x64, 0x00, 0x29, 0x00, 0x79, 0x00, 0xc9, 0x00,
+        0x52, 0xf0, 0xd4, 0xea, 0x09
+    };
+
+    std::string rows;
+    for (int i(0); i < 8; ++i)
+    {
+        rows += "INSERT INTO t1 VALUES (";
+        rows += char('0' + i);
+        rows += ", 'galera');";
+    }
+
+    std::vector<gu::byte_t> res(rows.size());
+
+    if (Compression::supported(Compression::ZSTD))
+    {
+        Compression::decompress(Compression::ZSTD, frame, sizeof(frame),
+                                res.data(), res.size());
+        ck_assert(0 == ::memcmp(res.data(), rows.data(), rows.size()));
+
+        /* truncated frame */
+        try
+        {
+            Compression::decompress(Compression::ZSTD, frame,
+                                    sizeof(frame) - 1,
+                                    res.data(), res.size());
+            ck_abort_msg("decompression of truncated frame succeeded");
+        }
+        catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+    }
+    else
+    {
+        /* build without zstd refuses it both ways */
+        try
+        {
+            Compression::decompress(Compression::ZSTD, frame, sizeof(frame),
+                                    res.data(), res.size());
+            ck_abort_msg("zstd decompression without zstd succeeded");
+        }
+        catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+
+        try
+        {
+            Compression::type("zstd");
+            ck_abort_msg("zstd accepted without zstd");
+        }
+        catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+    }
+}
+END_TEST
+
+START_TEST(names)
+{
+    ck_assert(Compression::type("none") == Compression::NONE);
+
+    if (Compression::supported(Compression::LZ4))
+    {
+        ck_assert(Compression::type("lz4") == Compression::LZ4);
+    }
+    else
+    {
+        /* build without write set compression refuses it */
+        try
+        {
+            Compression::type("lz4");
+            ck_abort_msg("lz4 accepted without lz4");
+        }
+        catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+    }
+
+    if (Compression::supported(Compression::ZSTD))
+    {
+        ck_assert(Compression::type("zstd") == Compression::ZSTD);
+    }
+
+    try
+    {
+        Compression::type("lzma");
+        ck_abort_msg("unknown compression accepted");
+    }
+    catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+
+    try
+    {
+        Compression::type(Compression::MAX_TYPE + 1);
+        ck_abort_msg("unknown compression type accepted");
+    }
+    catch (gu::Exception& e) { ck_assert(EINVAL == e.get_errno()); }
+}
+END_TEST
+
+Suite *gu_compress_suite(void)
+{
+    Suite* s = suite_create("gu::Compression");
+
+    TCase* t = tcase_create("roundtrip");
+    tcase_add_test(t, none);
+    tcase_add_test(t, lz4);
+    tcase_add_test(t, zstd);
+    tcase_set_timeout(t, 60);
+    suite_add_tcase(s, t);
+
+    t = tcase_create("format");
+    if (Compression::supported(Compression::LZ4))
+    {
+        tcase_add_test(t, lz4_format);
+        tcase_add_test(t, lz4_reference);
+        tcase_add_test(t, lz4_fuzz);
+    }
+    tcase_add_test(t, zstd_reference);
+    tcase_add_test(t, names);
+    suite_add_tcase(s, t);
+
+    return s;
+}
@@ -0,0 +1,10 @@
+// Copyright (C) 2026 Codership Oy <info@codership.com>
+
+#ifndef __gu_compress_test__
+#define __gu_compress_test__
+
+#include <check.h>
+
+extern Suite *gu_compress_suite(void);
+
+#endif /* __gu_compress_test__ */
@@ -102,6 +102,97 @@ test_function(void)
                   "Generated %#08x, expected %#08x\n", ret, output);
 }
 
+/* computes 4-lane checksum by definition: deinterleaves the words and
+ * checksums each lane separately with plain CRC-32C */
+static void
+crc32c4_reference(const char* const input, size_t const size,
+                  uint32_t res[GU_CRC32C4_LANES])
+{
+    gu_crc32c_t lanes[GU_CRC32C4_LANES];
+    size_t const words = size / sizeof(uint64_t);
+    size_t i;
+
+    for (i = 0; i < GU_CRC32C4_LANES; i++) gu_crc32c_init(&lanes[i]);
+
+    for (i = 0; i < words; i++)
+    {
+        gu_crc32c_append(&lanes[i % GU_CRC32C4_LANES],
+                         input + i*sizeof(uint64_t), sizeof(uint64_t));
+    }
+
+    gu_crc32c_append(&lanes[words % GU_CRC32C4_LANES],
+                     input + words*sizeof(uint64_t),
+                     size % sizeof(uint64_t));
+
+    for (i = 0; i < GU_CRC32C4_LANES; i++) res[i] = gu_crc32c_get(lanes[i]);
+}
+
+static void
+test_function4(void)
+{
+    const char* const input = long_input;
+    size_t const size = strlen(input);
+    size_t len;
+
+    for (len = 0; len <= size; len++)
+    {
+        uint32_t expected[GU_CRC32C4_LANES];
+        crc32c4_reference(input, len, expected);
+
+        /* feed the same input in uneven chunks */
+        size_t const chunks[] = { 1, 3, 5, 7, 13, 15, 0, 27, 43, 64 };
+        size_t offset = 0;
+        size_t i;
+
+        gu_crc32c4_ctx_t ctx;
+        gu_crc32c4_init(&ctx);
+
+        for (i = 0; i < sizeof(chunks)/sizeof(chunks[0]); i++)
+        {
+            size_t chunk = chunks[i];
+            if (chunk > len - offset) chunk = len - offset;
+            gu_crc32c4_append(&ctx, input + offset, chunk);
+            offset += chunk;
+        }
+
+        gu_crc32c4_append(&ctx, input + offset, len - offset);
+
+        uint8_t res[GU_CRC32C4_SIZE];
+        gu_crc32c4_get(&ctx, res);
+
+        for (i = 0; i < GU_CRC32C4_LANES; i++)
+        {
+            uint32_t const ret = (uint32_t)res[i*4]
+                | ((uint32_t)res[i*4 + 1] << 8)
+                | ((uint32_t)res[i*4 + 2] << 16)
+                | ((uint32_t)res[i*4 + 3] << 24);
+
+            ck_assert_msg(ret == expected[i],
+                          "Length %zu lane %zu: generated %#08x, "
+                          "expected %#08x\n", len, i, ret, expected[i]);
+        }
+    }
+}
+
+START_TEST(test_gu_crc32c4_slicing_by_8)
+{
+    gu_crc32c_func  = gu_crc32c_slicing_by_8;
+    gu_crc32c4_func = gu_crc32c4_slicing_by_8;
+    test_function4();
+}
+END_TEST
+
+#if !defined(GU_CRC32C_NO_HARDWARE)
+START_TEST(test_gu_crc32c4_hardware)
+{
+    gu_crc32c_func  = gu_crc32c_slicing_by_8;
+    gu_crc32c4_func = gu_crc32c4_hardware();
+
+    if (NULL != gu_crc32c4_func) test_function4();
+}
+END_TEST
+#endif /* GU_CRC32C_NO_HARDWARE */
+
 START_TEST(test_gu_crc32c_sarwate)
 {
     gu_crc32c_func = gu_crc32c_sarwate;
@@ -167,6 +258,7 @@ Suite *gu_crc32c_suite(void)
     tcase_add_test  (t, test_gu_crc32c_sarwate);
     tcase_add_test  (t, test_gu_crc32c_slicing_by_4);
     tcase_add_test  (t, test_gu_crc32c_slicing_by_8);
+    tcase_add_test  (t, test_gu_crc32c4_slicing_by_8);
 
 #if defined(GU_CRC32C_X86)
     t = tcase_create("gu_crc32c_hw_x86");
@@ -183,5 +275,11 @@ Suite *gu_crc32c_suite(void)
     tcase_add_test  (t, test_gu_crc32c_arm64);
 #endif /* GU_CRC32C_ARM64 */
 
+#if !defined(GU_CRC32C_NO_HARDWARE)
+    t = tcase_create("gu_crc32c4_hw");
+    suite_add_tcase (suite, t);
+    tcase_add_test  (t, test_gu_crc32c4_hardware);
+#endif /* GU_CRC32C_NO_HARDWARE */
+
     return suite;
 }
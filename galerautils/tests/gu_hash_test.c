@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Codership Oy <info@codership.com>
+// Copyright (C) 2012-2026 Codership Oy <info@codership.com>
 
 /*
  * This unit test is mostly to check that Galera hash definitions didn't change:
@@ -14,6 +14,7 @@
 #include "gu_hash_test.h"
 
 #include "../src/gu_hash.h"
+#include "../src/gu_xxh3.h"
 #include "../src/gu_log.h"
 #include "../src/gu_hexdump.h"
 
@@ -177,6 +178,87 @@ START_TEST (gu_fast_hash_test)
 }
 END_TEST
 
+/* Published XXH3_128bits_withSeed() test vectors from xxHash
+ * cli/xsum_sanity_check.c: message is generated by
+ * byte[i] = gen >> 56, gen *= PRIME64, starting with gen = PRIME32 */
+#define XXH3_TEST_PRIME32 2654435761U
+#define XXH3_TEST_PRIME64 11400714785074694797ULL
+#define XXH3_TEST_BUF_SIZE 2367
+
+static const struct
+{
+    size_t   len;
+    uint64_t seed;
+    uint64_t low64;
+    uint64_t high64;
+}
+xxh3_128_check[] =
+{
+    {    0,                 0, 0x6001C324468D497FULL, 0x99AA06D3014798D8ULL },
+    {    0, XXH3_TEST_PRIME32, 0x5444F7869C671AB0ULL, 0x92220AE55E14AB50ULL },
+    {    1,                 0, 0xC44BDFF4074EECDBULL, 0xA6CD5E9392000F6AULL },
+    {    1, XXH3_TEST_PRIME32, 0xB53D5557E7F76F8DULL, 0x89B99554BA22467CULL },
+    {    6,                 0, 0x3E7039BDDA43CFC6ULL, 0x082AFE0B8162D12AULL },
+    {    6, XXH3_TEST_PRIME32, 0x269D8F70BE98856EULL, 0x5A865B5389ABD2B1ULL },
+    {   12,                 0, 0x061A192713F69AD9ULL, 0x6E3EFD8FC7802B18ULL },
+    {   12, XXH3_TEST_PRIME32, 0x9BE9F9A67F3C7DFBULL, 0xD7E09D518A3405D3ULL },
+    {   24,                 0, 0x1E7044D28B1B901DULL, 0x0CE966E4678D3761ULL },
+    {   24, XXH3_TEST_PRIME32, 0xD7304C54EBAD40A9ULL, 0x3162026714A6A243ULL },
+    {   48,                 0, 0xF942219AED80F67BULL, 0xA002AC4E5478227EULL },
+    {   48, XXH3_TEST_PRIME32, 0x7BA3C3E453A1934EULL, 0x163ADDE36C072295ULL },
+    {   80,                 0, 0x454AE6BF7A8A532DULL, 0xFDF2CEFDE9EAAC8AULL },
+    {   80, XXH3_TEST_PRIME32, 0x7ABFEBDF2326DFF0ULL, 0x27F9BE94EF318D63ULL },
+    {  195,                 0, 0x3FB593C086A66075ULL, 0x7729543A26B207EEULL },
+    {  195, XXH3_TEST_PRIME32, 0x6447716EBBD2DA99ULL, 0xC45384C328326617ULL },
+    {  403,                 0, 0xCDEB804D65C6DEA4ULL, 0x1B6DE21E332DD73DULL },
+    {  403, XXH3_TEST_PRIME32, 0x1FEF87BD75DBE404ULL, 0x1EF41459552CB839ULL },
+    {  512,                 0, 0x617E49599013CB6BULL, 0x18D2D110DCC9BCA1ULL },
+    {  512, XXH3_TEST_PRIME32, 0x545F610E9F5A78ECULL, 0x06EEB0D56508040FULL },
+    { 2048,                 0, 0xDD59E2C3A5F038E0ULL, 0xF736557FD47073A5ULL },
+    { 2048, XXH3_TEST_PRIME32, 0x230D43F30206260BULL, 0x7FB03F7E7186C3EAULL },
+    { 2240,                 0, 0x6E73A90539CF2948ULL, 0xCCB134FBFA7CE49DULL },
+    { 2240, XXH3_TEST_PRIME32, 0xED385111126FBA6FULL, 0x50A1FE17B338995FULL },
+    { 2367,                 0, 0xCB37AEB9E5D361EDULL, 0xE89C0F6FF369B427ULL },
+    { 2367, XXH3_TEST_PRIME32, 0x6F5360AE69C2F406ULL, 0xD23AAE4B76C31ECBULL },
+};
+
+/* Tests vendored XXH3-128 */
+START_TEST (gu_xxh3_hash_test)
+{
+    uint8_t  buf[XXH3_TEST_BUF_SIZE];
+    uint64_t gen = XXH3_TEST_PRIME32;
+    uint64_t res[2];
+    uint8_t  canonical[16];
+    size_t   i;
+
+    for (i = 0; i < sizeof(buf); ++i)
+    {
+        buf[i] = (uint8_t)(gen >> 56);
+        gen *= XXH3_TEST_PRIME64;
+    }
+
+    for (i = 0; i < sizeof(xxh3_128_check)/sizeof(xxh3_128_check[0]); ++i)
+    {
+        gu_xxh3_128_seeded (buf, xxh3_128_check[i].len, xxh3_128_check[i].seed,
+                            res);
+        ck_assert_msg(res[0] == xxh3_128_check[i].low64 &&
+                      res[1] == xxh3_128_check[i].high64,
+                      "XXH3-128 failed for length %zu, seed %llu",
+                      xxh3_128_check[i].len,
+                      (unsigned long long)xxh3_128_check[i].seed);
+    }
+
+    /* canonical representation is big-endian, high word first */
+    gu_xxh3_128 (buf, 0, canonical);
+    {
+        static const uint8_t empty[16] =
+            { 0x99,0xAA,0x06,0xD3,0x01,0x47,0x98,0xD8,
+              0x60,0x01,0xC3,0x24,0x46,0x8D,0x49,0x7F };
+        ck_assert(!check(empty, canonical, sizeof(canonical)));
+    }
+}
+END_TEST
+
 /* Tests table hash functions:
  * - for 64-bit platforms table hash should be identical to fast 64-bit hash,
  * - for 32-bit platforms table hash is different.
@@ -245,6 +327,7 @@ Suite *gu_hash_suite(void)
   tcase_add_test  (tc, gu_hash_test);
   tcase_add_test  (tc, gu_fast_hash_test);
   tcase_add_test  (tc, gu_table_hash_test);
+  tcase_add_test  (tc, gu_xxh3_hash_test);
 
   return s;
 }
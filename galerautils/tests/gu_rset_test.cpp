@@ -126,9 +126,10 @@ START_TEST (empty)
 END_TEST
 
 static void
-test_version (gu::RecordSet::Version version)
+test_version (gu::RecordSet::Version version,
+              gu::RecordSet::CheckType const ct = gu::RecordSet::CHECK_MMH64)
 {
-    int const alignment(gu::RecordSet::VER2 == version ?
+    int const alignment(version >= gu::RecordSet::VER2 ?
                         gu::RecordSet::VER2_ALIGNMENT : 1);
     size_t const MB = 1 << 20;
 
@@ -158,7 +159,7 @@ test_version (gu::RecordSet::Version version)
     os << "gu_rset_test_ver" << version;
     TestBaseName str(os.str().c_str());
     gu::RecordSetOut<TestRecord> rset_out(reserved.buf, sizeof(reserved), str,
-                                          gu::RecordSet::CHECK_MMH64, version);
+                                          ct, version);
 
     size_t offset(rset_out.size());
     ck_assert(1 == rset_out.page_count());
@@ -427,9 +428,10 @@ END_TEST
 /* This test is to test how padding mixes with persistent (stored outside)
  * pages. In this case new padding buf needs to be allocated */
 static void
-test_padding(gu::RecordSet::Version rsv)
+test_padding(gu::RecordSet::Version rsv,
+             gu::RecordSet::CheckType const ct = gu::RecordSet::CHECK_MMH64)
 {
-    int const alignment(gu::RecordSet::VER2 == rsv ?
+    int const alignment(rsv >= gu::RecordSet::VER2 ?
                         gu::RecordSet::VER2_ALIGNMENT : 1);
 
     union { gu_word_t align; gu::byte_t buf[1024]; } reserved;
@@ -438,7 +440,7 @@ test_padding(gu::RecordSet::Version rsv)
     os << "gu_rset_padding_test_ver" << rsv;
     TestBaseName str(os.str().c_str());
     gu::RecordSetOut<uint64_t> rso(reserved.buf, sizeof(reserved), str,
-                                   gu::RecordSet::CHECK_MMH64, rsv);
+                                   ct, rsv);
 
     uint64_t const data_out_volatile(0xaabbccdd);
     uint32_t const data_out_persistent(0xffeeddcc);
@@ -494,6 +496,18 @@ START_TEST (ver2_padding)
 }
 END_TEST
 
+START_TEST (ver3)
+{
+    test_version(gu::RecordSet::VER3, gu::RecordSet::CHECK_CRC32C4);
+}
+END_TEST
+
+START_TEST (ver3_padding)
+{
+    test_padding(gu::RecordSet::VER3, gu::RecordSet::CHECK_CRC32C4);
+}
+END_TEST
+
 /* return the total size of serialized record set
  * @param count number of records
  * @param size  record size */
@@ -591,6 +605,8 @@ END_TEST
 
 Suite* gu_rset_suite ()
 {
+    gu_crc32c_configure(); /* RecordSet::CHECK_CRC32C4 */
+
     Suite* s(suite_create("gu::RecordSet"));
 
     TCase* t(tcase_create("RecordSet v1"));
@@ -606,6 +622,11 @@ Suite* gu_rset_suite ()
     tcase_add_test (t, ver2_padding);
     tcase_add_test (t, ver2_sizes);
     suite_add_tcase (s, t);
+
+    t = tcase_create("RecordSet v3");
+    tcase_add_test (t, ver3);
+    tcase_add_test (t, ver3_padding);
+    suite_add_tcase (s, t);
 //    tcase_set_timeout(t, 60);
 
     return s;
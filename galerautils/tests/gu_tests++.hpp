@@ -18,6 +18,7 @@
 #include "gu_mem_pool_test.hpp"
 #include "gu_alloc_test.hpp"
 #include "gu_rset_test.hpp"
+#include "gu_compress_test.hpp"
 #include "gu_string_utils_test.hpp"
 #include "gu_uri_test.hpp"
 #include "gu_gtid_test.hpp"
@@ -43,6 +44,7 @@ static suite_creator_t suites[] =
     gu_mem_pool_suite,
     gu_alloc_suite,
     gu_rset_suite,
+    gu_compress_suite,
     gu_string_utils_suite,
     gu_uri_suite,
     gu_gtid_suite,
@@ -1,5 +1,5 @@
 //
-// Copyright (C) 2011-2020 Codership Oy <info@codership.com>
+// Copyright (C) 2011-2026 Codership Oy <info@codership.com>
 //
 
 #include "gu_vlq.hpp"
@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <vector>
 #include <limits>
+#include <chrono>
 
 static struct valval
 {
@@ -255,6 +256,149 @@ START_TEST(test_uleb128_misc)
 END_TEST
 
 
+/* encodes count values of random lengths, returns size of encoding */
+static size_t
+encode_random(std::vector<gu::byte_t>& buf, std::vector<uint64_t>& vals,
+              size_t const count)
+{
+    vals.resize(count);
+    buf.resize(count * 10);
+
+    size_t offset(0);
+    for (size_t i(0); i < count; ++i)
+    {
+        /* mostly short values, like sizes and counts, some of full width */
+        int const bits(rand() % 8 ? rand() % 32 : rand() % 65);
+        uint64_t const val((static_cast<uint64_t>(rand()) << 33) ^
+                           (static_cast<uint64_t>(rand()) << 2) ^ rand());
+        vals[i] = bits < 64 ? val & ((uint64_t(1) << bits) - 1) : val;
+        offset = gu::uleb128_encode(vals[i], &buf[0], buf.size(), offset);
+    }
+
+    buf.resize(offset);
+    return offset;
+}
+
+START_TEST(test_uleb128_decode_batch)
+{
+    std::vector<gu::byte_t> buf;
+    std::vector<uint64_t>   vals;
+
+    // all sizes from the table, then random values, each up to the buffer end
+    for (size_t i(0); i < SizeOfArray(valarr); ++i)
+    {
+        buf.resize(valarr[i].size);
+        (void)gu::uleb128_encode(valarr[i].val, &buf[0], buf.size(), 0);
+        buf.resize(buf.size() + i); // make some of them fit a machine word
+
+        uint64_t v1(0), v2(0);
+        size_t const off1(gu::uleb128_decode_batch(&buf[0], buf.size(), 0,
+                                                   &v1, 1));
+        size_t const off2(gu::uleb128_decode_batch_generic(&buf[0],
+                                                           buf.size(), 0,
+                                                           &v2, 1));
+        ck_assert_msg(off1 == valarr[i].size && off2 == valarr[i].size,
+                      "got offsets %zu, %zu, expected %zu for value 0x%llx",
+                      off1, off2, valarr[i].size, valarr[i].val);
+        ck_assert_msg(v1 == valarr[i].val && v2 == valarr[i].val,
+                      "got values 0x%llx, 0x%llx, expected 0x%llx",
+                      (unsigned long long)v1, (unsigned long long)v2,
+                      valarr[i].val);
+    }
+
+    size_t const count(1 << 12);
+    size_t const size(encode_random(buf, vals, count));
+    std::vector<uint64_t> out1(count), out2(count);
+
+    size_t const off1(gu::uleb128_decode_batch(&buf[0], buf.size(), 0,
+                                               &out1[0], count));
+    size_t const off2(gu::uleb128_decode_batch_generic(&buf[0], buf.size(), 0,
+                                                       &out2[0], count));
+    ck_assert(off1 == size);
+    ck_assert(off2 == size);
+
+    for (size_t i(0); i < count; ++i)
+    {
+        if (vals[i] != out1[i] || vals[i] != out2[i])
+            ck_abort_msg("value %zu: 0x%llx, 0x%llx != 0x%llx", i,
+                         (unsigned long long)out1[i],
+                         (unsigned long long)out2[i],
+                         (unsigned long long)vals[i]);
+    }
+
+    // missing terminating byte must be detected near the buffer end
+    buf.resize(buf.size() - 1);
+    buf.back() |= 0x80;
+    try
+    {
+        (void)gu::uleb128_decode_batch(&buf[0], buf.size(), 0,
+                                       &out1[0], count);
+        ck_abort_msg("exception was not thrown");
+    }
+    catch (gu::Exception& e)
+    {
+        log_info << "expected exception: " << e.what();
+    }
+}
+END_TEST
+
+START_TEST(test_uleb128_decode_bench)
+{
+    std::vector<gu::byte_t> buf;
+    std::vector<uint64_t>   vals;
+    size_t const count(1 << 16);
+    size_t const size(encode_random(buf, vals, count));
+    std::vector<uint64_t> out(count);
+    int const rounds(64);
+    uint64_t sum(0);
+
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point const t0(Clock::now());
+    for (int r(0); r < rounds; ++r)
+    {
+        size_t off(0);
+        for (size_t i(0); i < count; ++i)
+        {
+            off = gu::uleb128_decode(&buf[0], buf.size(), off, out[i]);
+        }
+        ck_assert(off == size);
+        sum += out[r];
+    }
+
+    Clock::time_point const t1(Clock::now());
+    for (int r(0); r < rounds; ++r)
+    {
+        size_t const off(gu::uleb128_decode_batch_generic(&buf[0], buf.size(),
+                                                          0, &out[0], count));
+        ck_assert(off == size);
+        sum += out[r];
+    }
+
+    Clock::time_point const t2(Clock::now());
+    for (int r(0); r < rounds; ++r)
+    {
+        size_t const off(gu::uleb128_decode_batch(&buf[0], buf.size(), 0,
+                                                  &out[0], count));
+        ck_assert(off == size);
+        sum += out[r];
+    }
+
+    Clock::time_point const t3(Clock::now());
+
+    double const n(double(count) * rounds);
+    double const scalar(std::chrono::duration<double>(t1 - t0).count());
+    double const generic(std::chrono::duration<double>(t2 - t1).count());
+    double const batch(std::chrono::duration<double>(t3 - t2).count());
+
+    log_info << "uleb128 decode: scalar: " << n/scalar << " values/s"
+             << ", generic batch: " << n/generic << " values/s"
+             << ", batch: " << n/batch << " values/s"
+             << " (checksum " << sum << ")";
+}
+END_TEST
+
+
 Suite* gu_vlq_suite()
 {
     Suite* s(suite_create("gu::vlq"));
@@ -276,5 +420,13 @@ Suite* gu_vlq_suite()
     tcase_add_test(tc, test_uleb128_misc);
     suite_add_tcase(s, tc);
 
+    tc = tcase_create("test_uleb128_decode_batch");
+    tcase_add_test(tc, test_uleb128_decode_batch);
+    suite_add_tcase(s, tc);
+
+    tc = tcase_create("test_uleb128_decode_bench");
+    tcase_add_test(tc, test_uleb128_decode_bench);
+    suite_add_tcase(s, tc);
+
     return s;
 }
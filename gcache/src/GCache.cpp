@@ -16,9 +16,13 @@ namespace gcache
     void
     GCache::reset()
     {
+        if (seqno_locked_count > 0) advise_sequential(false);
+
         mem.reset();
         rb.reset();
         ps.reset();
+        cs.reset();
+        cs.set_locked(SEQNO_MAX);
 
         mallocs  = 0;
         reallocs = 0;
@@ -53,6 +57,20 @@ namespace gcache
         }
     }
 
+    static size_t cold_size(bool const encrypt, size_t const size)
+    {
+        if (encrypt && size > 0)
+        {
+            log_warn << "GCache cold store is not supported when encryption "
+                "is enabled. Cold store will be disabled.";
+            return 0;
+        }
+        else
+        {
+            return size;
+        }
+    }
+
     GCache::GCache (ProgressCallback*        pcb,
                     gu::Config&              cfg,
                     const std::string&       data_dir,
@@ -75,7 +93,12 @@ namespace gcache
                    params.keep_plaintext_size(),
                    params.debug(),
                    /* keep last page if PS is the only storage */
-                   !((params.mem_size() + params.rb_size()) > 0)),
+                   !((params.mem_size() + params.rb_size()) > 0),
+                   params.prealloc_pages()),
+        cs        (params.dir_name(),
+                   cold_size(encrypt_cb, params.cold_size()),
+                   params.cold_compression(),
+                   params.debug()),
         mallocs   (0),
         reallocs  (0),
         frees     (0),
@@ -88,7 +111,13 @@ namespace gcache
 #ifndef NDEBUG
         ,buf_tracker()
 #endif
-    {}
+    {
+        if (cs.enabled())
+        {
+            mem.set_cold_store(&cs);
+            rb.set_cold_store(&cs);
+        }
+    }
 
     GCache::~GCache ()
     {
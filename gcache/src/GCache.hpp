@@ -9,6 +9,7 @@
 #include "gcache_mem_store.hpp"
 #include "gcache_rb_store.hpp"
 #include "gcache_page_store.hpp"
+#include "gcache_cold_store.hpp"
 #include "gcache_types.hpp"
 
 #include <gu_types.hpp>
@@ -20,6 +21,7 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #ifndef NDEBUG
 #include <set>
 #endif
@@ -139,12 +141,20 @@ namespace gcache
         void seqno_release (seqno_t seqno);
 
         /*!
-         * Returns smallest seqno present in history
+         * Returns smallest seqno present in history, including cold store.
+         * Cold store history counts only if it continues into the hot one.
+         * It is not persisted, so after restart only the recovered ring
+         * buffer history is reported.
          */
         seqno_t seqno_min() const
         {
             gu::Lock lock(mtx);
-            if (gu_likely(!seqno2ptr.empty()))
+            seqno_t const cold(cs.seqno_min());
+            if (cold != SEQNO_NONE &&
+                (seqno2ptr.empty() ||
+                 cs.seqno_max() + 1 >= seqno2ptr.index_begin()))
+                return cold;
+            else if (gu_likely(!seqno2ptr.empty()))
                 return seqno2ptr.index_begin();
             else
                 return SEQNO_ILL;
@@ -152,6 +162,8 @@ namespace gcache
 
         /*!
          * Move lock to a given seqno.
+         * While the history is locked the cache is hinted for sequential
+         * reading.
          * @throws gu::NotFound if seqno is not in the cache.
          */
         void  seqno_lock (seqno_t const seqno_g);
@@ -168,7 +180,8 @@ namespace gcache
         {
         public:
 
-            Buffer() : seqno_g_(), ptr_(), size_(), skip_(), type_() { }
+            Buffer() : seqno_g_(), ptr_(), size_(), skip_(), type_(),
+                       hold_() { }
 
             Buffer (const Buffer& other)
                 :
@@ -176,7 +189,8 @@ namespace gcache
                 ptr_    (other.ptr_),
                 size_   (other.size_),
                 skip_   (other.skip_),
-                type_   (other.type_)
+                type_   (other.type_),
+                hold_   (other.hold_)
             { }
 
             Buffer& operator= (const Buffer& other)
@@ -186,6 +200,7 @@ namespace gcache
                 size_    = other.size_;
                 skip_    = other.skip_;
                 type_    = other.type_;
+                hold_    = other.hold_;
                 return *this;
             }
 
@@ -197,9 +212,12 @@ namespace gcache
 
         protected:
 
-            void set_ptr   (const void* p)
+            void set_ptr   (const void* p,
+                            const std::shared_ptr<const void>& hold =
+                            std::shared_ptr<const void>())
             {
-                ptr_ = reinterpret_cast<const gu::byte_t*>(p);
+                ptr_  = reinterpret_cast<const gu::byte_t*>(p);
+                hold_ = hold;
             }
 
             void set_other (seqno_t g, ssize_type s, bool skp, uint8_t t)
@@ -215,6 +233,8 @@ namespace gcache
             ssize_type        size_;
             bool              skip_;
             uint8_t           type_;
+            /* keeps buffers decompressed from cold store alive */
+            std::shared_ptr<const void> hold_;
 
             friend class GCache;
         };
@@ -222,12 +242,22 @@ namespace gcache
         /*!
          * Fills a vector with Buffer objects starting with seqno start
          * until either vector length or seqno map is exhausted.
+         * Buffers found in cold store are decompressed, in that case at most
+         * one compressed chunk is returned at a time.
          * Moves seqno lock to start.
          *
          * @retval number of buffers filled (<= v.size())
          */
         size_t seqno_get_buffers (std::vector<Buffer>& v, seqno_t start);
 
+        /*!
+         * Asks the OS to read in the buffers of count seqnos starting with
+         * start in the background, so that seqno_get_buffers() does not
+         * block on page faults later. Does not wait for IO.
+         * The range should be locked with seqno_lock().
+         */
+        void seqno_prefetch (seqno_t start, size_t count);
+
         /*!
          * Releases any seqno locks present.
          */
@@ -247,6 +277,11 @@ namespace gcache
 
         void free_common (BufferHeader*, const void*);
 
+        /* seqno_get_buffers() from cold store chunk, called without lock */
+        size_t cold_get_buffers (std::vector<Buffer>&     v,
+                                 seqno_t                  start,
+                                 const ColdStore::Reader& cold);
+
         gu::Config&     config;
 
         class Params
@@ -265,6 +300,12 @@ namespace gcache
             size_t page_size()           const { return page_size_;       }
             size_t keep_pages_size()     const { return keep_pages_size_; }
             size_t keep_plaintext_size() const { return keep_plaintext_size_;}
+            size_t prealloc_pages()      const { return prealloc_pages_;  }
+            size_t cold_size()           const { return cold_size_;       }
+            gu::Compression::Type cold_compression() const
+            {
+                return cold_compression_;
+            }
             int    debug()               const { return debug_;           }
             bool   recover()             const { return recover_;         }
 
@@ -272,6 +313,7 @@ namespace gcache
             void page_size       (size_t s) { page_size_       = s; }
             void keep_pages_size (size_t s) { keep_pages_size_ = s; }
             void keep_plaintext_size (size_t s) { keep_plaintext_size_ = s; }
+            void prealloc_pages  (size_t n) { prealloc_pages_  = n; }
 #ifndef NDEBUG
             void debug           (int    d) { debug_           = d; }
 #endif
@@ -285,6 +327,9 @@ namespace gcache
             size_t            page_size_;
             size_t            keep_pages_size_;
             size_t            keep_plaintext_size_;
+            size_t            prealloc_pages_;
+            size_t      const cold_size_;
+            gu::Compression::Type const cold_compression_;
             int               debug_;
             bool        const recover_;
         }
@@ -298,6 +343,7 @@ namespace gcache
         MemStore        mem;
         RingBuffer      rb;
         PageStore       ps;
+        ColdStore       cs;
 
         long long       mallocs;
         long long       reallocs;
@@ -309,6 +355,12 @@ namespace gcache
         seqno_t         seqno_locked;
         int             seqno_locked_count;
 
+        void advise_sequential (bool const s)
+        {
+            rb.advise_sequential(s);
+            ps.advise_sequential(s);
+        }
+
         bool const      encrypt_cache;
 
 #ifndef NDEBUG
@@ -50,6 +50,7 @@ namespace gcache
                 assert (bh->seqno_g == seqno2ptr.index_begin());
 
                 cond.update(bh);
+                if (cs.enabled()) cs.append(bh);
                 discard_buffer(bh, ptr);
             }
             else
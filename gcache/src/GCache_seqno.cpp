@@ -5,10 +5,14 @@
 #include "gcache_bh.hpp"
 #include "GCache.hpp"
 
+#include <gu_limits.h> // GU_PAGE_SIZE
+
+#include <algorithm>
 #include <cerrno>
 #include <cassert>
 
 #include <sched.h> // sched_yeild()
+#include <sys/mman.h> // posix_madvise()
 
 namespace gcache
 {
@@ -28,6 +32,8 @@ namespace gcache
         {
             if (seqno_max > s)
             {
+                /* cold store history must be continuous with the hot one */
+                if (!cs.empty() && cs.seqno_max() > s) cs.reset();
                 discard_tail(s);
                 seqno_max = s;
                 seqno_released = s;
@@ -45,6 +51,7 @@ namespace gcache
         /* order is significant here */
         rb.seqno_reset();
         mem.seqno_reset();
+        cs.reset();
 
         seqno2ptr.clear(SEQNO_NONE);
         seqno_max = SEQNO_NONE;
@@ -304,11 +311,16 @@ namespace gcache
         assert(SEQNO_MAX == seqno_locked || seqno_locked_count > 0);
         assert(0   == seqno_locked_count || seqno_locked < SEQNO_MAX);
 
-        seqno2ptr.at(seqno_g); /* check that the element exists */
+        /* check that the element exists */
+        if (!cs.contains(seqno_g)) seqno2ptr.at(seqno_g);
 
-        seqno_locked_count++;
+        if (0 == seqno_locked_count++) advise_sequential(true);
 
-        if (seqno_g < seqno_locked) seqno_locked = seqno_g;
+        if (seqno_g < seqno_locked)
+        {
+            seqno_locked = seqno_g;
+            cs.set_locked(seqno_locked);
+        }
     }
 
     /*!
@@ -362,6 +374,7 @@ namespace gcache
         assert (max > 0);
 
         size_t found(0);
+        ColdStore::Reader cold;
 
         {
             gu::Lock lock(mtx);
@@ -371,7 +384,11 @@ namespace gcache
 
             seqno2ptr_iter_t p = seqno2ptr.find(start);
 
-            if (p != seqno2ptr.end() && *p)
+            if (cs.find(start, cold))
+            {
+                assert(seqno2ptr.empty() || start < seqno2ptr.index_begin());
+            }
+            else if (p != seqno2ptr.end() && *p)
             {
                 do {
                     assert(seqno2ptr.index(p) == seqno_t(start + found));
@@ -383,6 +400,8 @@ namespace gcache
             }
         }
 
+        if (cold.valid()) return cold_get_buffers(v, start, cold);
+
         // the following may cause IO
         for (size_t i(0); i < found; ++i)
         {
@@ -400,6 +419,94 @@ namespace gcache
         return found;
     }
 
+    size_t
+    GCache::cold_get_buffers (std::vector<Buffer>&     v,
+                              seqno_t            const start,
+                              const ColdStore::Reader& cold)
+    {
+        size_t const max(v.size());
+        size_t found(0);
+
+        // the following may cause IO and decompression
+        std::shared_ptr<const ColdStore::Data> const data(cold.read());
+        const ColdStore::Record* r
+            (reinterpret_cast<const ColdStore::Record*>(data->data()));
+        const ColdStore::Record* const end
+            (reinterpret_cast<const ColdStore::Record*>(data->data() +
+                                                        data->size()));
+
+        while (r < end && r->seqno_g < start) r = ColdStore::next(r);
+
+        for (; found < max && r < end; ++found, r = ColdStore::next(r))
+        {
+            assert (r->seqno_g == seqno_t(start + found));
+            Limits::assert_size(r->size);
+
+            v[found].set_ptr(r + 1, data);
+            v[found].set_other(r->seqno_g, r->size, r->skip, r->type);
+        }
+
+        return found;
+    }
+
+    void
+    GCache::seqno_prefetch (seqno_t const start, size_t const count)
+    {
+        /* Buffer sizes are not known without reading their headers, so the
+         * buffers that follow each other closely enough are merged into
+         * a single range. Otherwise only the first MIN bytes are read. */
+        static size_t const MIN(1 << 16);  // 64K
+        static size_t const GAP(1 << 20);  // 1M
+        static size_t const MAX(1 << 27);  // 128M in total
+
+        typedef std::pair<const uint8_t*, const uint8_t*> Range;
+        std::vector<Range> ranges;
+        size_t total(0);
+
+        {
+            gu::Lock lock(mtx);
+
+            assert(seqno_locked <= start);
+
+            seqno2ptr_iter_t p(seqno2ptr.find(start));
+
+            for (size_t i(0); i < count && p != seqno2ptr.end() && *p &&
+                     total < MAX; ++i, ++p)
+            {
+                /* no access to the buffer header here, it may cause IO */
+                const uint8_t* const b(static_cast<const uint8_t*>(*p) -
+                                       sizeof(BufferHeader));
+
+                if (!ranges.empty() && b >= ranges.back().first &&
+                    b <= ranges.back().second + GAP)
+                {
+                    total -= ranges.back().second - ranges.back().first;
+                    ranges.back().second =
+                        std::max(ranges.back().second, b + MIN);
+                }
+                else
+                {
+                    ranges.push_back(Range(b, b + MIN));
+                }
+
+                total += ranges.back().second - ranges.back().first;
+            }
+        }
+
+        static uintptr_t const PAGE_SIZE_MASK(~(GU_PAGE_SIZE - 1));
+
+        for (size_t i(0); i < ranges.size(); ++i)
+        {
+            uint8_t* const addr(reinterpret_cast<uint8_t*>
+                                (uintptr_t(ranges[i].first) & PAGE_SIZE_MASK));
+            size_t   const len(ranges[i].second - addr);
+
+            /* just a hint: the range may extend beyond the mapping or be
+             * unmapped already */
+            (void)posix_madvise(addr, len, POSIX_MADV_WILLNEED);
+        }
+    }
+
     /*!
      * Releases any history locks present.
      */
@@ -411,7 +518,12 @@ namespace gcache
         {
             assert(seqno_locked < SEQNO_MAX);
             seqno_locked_count--;
-            if (0 == seqno_locked_count) seqno_locked = SEQNO_MAX;
+            if (0 == seqno_locked_count)
+            {
+                seqno_locked = SEQNO_MAX;
+                cs.set_locked(seqno_locked);
+                advise_sequential(false);
+            }
         }
         else
         {
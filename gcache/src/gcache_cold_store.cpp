@@ -0,0 +1,481 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+/*! @file compressed cold store class implementation */
+
+#include "gcache_cold_store.hpp"
+
+#include <gu_logger.hpp>
+#include <gu_thread_keys.hpp>
+#include <gu_throw.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
+static const std::string base_name ("gcache.cold.");
+
+static std::string
+make_base_name (const std::string& dir_name)
+{
+    if (dir_name.empty())
+    {
+        return base_name;
+    }
+    else
+    {
+        if (dir_name[dir_name.length() - 1] == '/')
+        {
+            return (dir_name + base_name);
+        }
+        else
+        {
+            return (dir_name + '/' + base_name);
+        }
+    }
+}
+
+static std::string
+make_segment_name (const std::string& base_name, size_t count)
+{
+    std::ostringstream os;
+    os << base_name << std::setfill ('0') << std::setw (6) << count;
+    return os.str();
+}
+
+static size_t
+segment_size (size_t const max_size)
+{
+    static size_t const MIN_SEGMENT_SIZE(1 << 20);  // 1M
+    static size_t const MAX_SEGMENT_SIZE(1 << 26);  // 64M
+
+    return std::max(std::min(max_size / 8, MAX_SEGMENT_SIZE),
+                    MIN_SEGMENT_SIZE);
+}
+
+static void
+write_full (const gu::FileDescriptor& fd, const uint8_t* buf, size_t size,
+            off_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t const ret(::pwrite(fd.get(), buf, size, offset));
+
+        if (gu_unlikely(ret < 0))
+        {
+            if (EINTR == errno) continue;
+            gu_throw_system_error(errno) << "Failed to write " << size
+                                         << " bytes to '" << fd.name()
+                                         << "' at offset " << offset;
+        }
+
+        buf += ret; size -= ret; offset += ret;
+    }
+}
+
+static void
+read_full (const gu::FileDescriptor& fd, uint8_t* buf, size_t size,
+           off_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t const ret(::pread(fd.get(), buf, size, offset));
+
+        if (gu_unlikely(ret <= 0))
+        {
+            if (ret < 0 && EINTR == errno) continue;
+            int const err(ret < 0 ? errno : EIO);
+            gu_throw_system_error(err) << "Failed to read " << size
+                                       << " bytes from '" << fd.name()
+                                       << "' at offset " << offset;
+        }
+
+        buf += ret; size -= ret; offset += ret;
+    }
+}
+
+namespace gcache
+{
+    ColdStore::Segment::Segment(const std::string& name, size_t const size)
+        :
+        fd_  (name, size, false, false),
+        used_(0),
+        last_(SEQNO_NONE)
+    {
+        /* the file is not reused on restart: let it go away with the last
+         * descriptor, even after a crash */
+        fd_.unlink();
+    }
+
+    ColdStore::ColdStore (const std::string&          dir_name,
+                          size_t                const max_size,
+                          gu::Compression::Type const type,
+                          int                   const dbg)
+        :
+        base_name_   (make_base_name(dir_name)),
+        max_size_    (max_size),
+        segment_size_(segment_size(max_size)),
+        type_        (type),
+        segments_    (),
+        chunks_      (),
+        pending_     (),
+        pending_size_(0),
+        batch_       (),
+        cbuf_        (),
+        batch_first_ (SEQNO_NONE),
+        seqno_min_   (SEQNO_NONE),
+        seqno_max_   (SEQNO_NONE),
+        seqno_locked_(SEQNO_MAX),
+        size_        (0),
+        count_       (0),
+        gen_         (0),
+        debug_       (dbg & DEBUG),
+        mtx_         (gu::get_mutex_key(gu::GU_MUTEX_KEY_GCACHE_COLD)),
+        cond_        (gu::get_cond_key(gu::GU_COND_KEY_GCACHE_COLD)),
+        flush_thr_   (),
+        exit_        (false)
+    {
+        if (enabled())
+        {
+            int const err(gu_thread_create(
+                              gu::get_thread_key(gu::GU_THREAD_KEY_GCACHE_COLD),
+                              &flush_thr_, flush_thread, this));
+            if (0 != err)
+            {
+                gu_throw_system_error(err)
+                    << "Failed to create GCache cold store thread";
+            }
+
+            log_info << "GCache cold store enabled: " << max_size_
+                     << " bytes in " << segment_size_ << " byte segments, "
+                     << "compression: " << type_
+                     << ". It is not preserved across restarts.";
+        }
+    }
+
+    ColdStore::~ColdStore ()
+    {
+        if (enabled())
+        {
+            {
+                gu::Lock lock(mtx_);
+                exit_ = true;
+                cond_.broadcast();
+            }
+
+            gu_thread_join(flush_thr_, NULL);
+        }
+    }
+
+    void
+    ColdStore::append (const BufferHeader* const bh)
+    {
+        assert(enabled());
+        assert(bh->seqno_g > 0);
+        assert(BH_is_released(bh));
+
+        seqno_t const seqno(bh->seqno_g);
+
+        gu::Lock lock(mtx_);
+
+        if (gu_unlikely(SEQNO_NONE != seqno_min_ && seqno != seqno_max_ + 1))
+        {
+            /* history in the store must be continuous */
+            log_info << "GCache cold store: discarding history "
+                     << seqno_min_ << '-' << seqno_max_ << " followed by "
+                     << seqno;
+            reset_locked();
+        }
+
+        /* don't let unwritten batches pile up if IO can't keep up */
+        while (gu_unlikely(pending_size_ >= MAX_PENDING)) lock.wait(cond_);
+
+        if (!batch_)
+        {
+            batch_ = std::make_shared<Data>();
+            batch_->reserve(BATCH_SIZE);
+            batch_first_ = seqno;
+        }
+
+        uint32_t const size(bh->size - sizeof(BufferHeader));
+        size_t   const offset(batch_->size());
+
+        batch_->resize(offset + sizeof(Record) +
+                       GU_ALIGN(size, MemOps::ALIGNMENT));
+
+        Record* const r(reinterpret_cast<Record*>(batch_->data() + offset));
+        r->seqno_g = seqno;
+        r->size    = size;
+        r->type    = bh->type;
+        r->skip    = BH_is_skipped(bh);
+        r->pad     = 0;
+        ::memcpy(r + 1, bh + 1, size);
+
+        if (SEQNO_NONE == seqno_min_) seqno_min_ = seqno;
+        seqno_max_ = seqno;
+
+        if (batch_->size() >= BATCH_SIZE) seal();
+    }
+
+    void
+    ColdStore::seal ()
+    {
+        assert(batch_);
+
+        Batch const b = { batch_first_, seqno_max_, batch_ };
+        pending_.push_back(b);
+        pending_size_ += batch_->size();
+        batch_.reset();
+
+        cond_.broadcast();
+    }
+
+    ColdStore::Chunk
+    ColdStore::write_chunk (const Batch& b, SegmentPtr& seg,
+                            off_t const offset, size_t const count)
+    {
+        const Data&  batch(*b.data_);
+        size_t const usize(batch.size());
+        size_t       csize(0);
+
+        if (gu::Compression::NONE != type_)
+        {
+            if (cbuf_.size() < usize) cbuf_.resize(usize);
+
+            /* 0 means it does not compress */
+            csize = gu::Compression::compress(type_, batch.data(), usize,
+                                              cbuf_.data(), usize);
+        }
+
+        Chunk c;
+        c.first_  = b.first_;
+        c.last_   = b.last_;
+        c.usize_  = usize;
+        c.csize_  = csize > 0 ? csize : usize;
+        c.type_   = csize > 0 ? type_ : gu::Compression::NONE;
+        c.offset_ = offset;
+
+        if (!seg || offset + c.csize_ > size_t(seg->fd_.size()))
+        {
+            seg = std::make_shared<Segment>
+                (make_segment_name(base_name_, count),
+                 std::max(segment_size_, c.csize_));
+            c.offset_ = 0;
+        }
+
+        write_full(seg->fd_, csize > 0 ? cbuf_.data() : batch.data(),
+                   c.csize_, c.offset_);
+
+        c.segment_ = seg;
+
+        return c;
+    }
+
+    void
+    ColdStore::flush_loop ()
+    {
+        gu::Lock lock(mtx_);
+
+        while (!exit_)
+        {
+            if (pending_.empty())
+            {
+                lock.wait(cond_);
+                continue;
+            }
+
+            Batch const         b(pending_.front());
+            unsigned long const gen(gen_);
+            size_t const        count(count_);
+            SegmentPtr const    last(segments_.empty() ? SegmentPtr() :
+                                     segments_.back());
+            /* only this thread writes to segments */
+            off_t const         offset(last ? last->used_ : 0);
+            SegmentPtr          seg(last);
+            Chunk               c;
+            std::string         error;
+
+            /* don't hold the lock while compressing and writing */
+            mtx_.unlock();
+            try
+            {
+                c = write_chunk(b, seg, offset, count);
+            }
+            catch (std::exception& e)
+            {
+                error = e.what();
+            }
+            mtx_.lock();
+
+            if (gen != gen_) continue; /* the batch was discarded by reset */
+
+            assert(pending_.front().data_ == b.data_);
+            pending_.pop_front();
+            pending_size_ -= b.data_->size();
+            cond_.broadcast();
+
+            if (!error.empty())
+            {
+                log_warn << "GCache cold store: " << error
+                         << ". Discarding history " << seqno_min_ << '-'
+                         << seqno_max_;
+                reset_locked();
+                continue;
+            }
+
+            if (seg != last)
+            {
+                segments_.push_back(seg);
+                count_++;
+
+                if (debug_)
+                {
+                    log_info << "GCache cold store: created segment "
+                             << seg->fd_.name() << ", total segments: "
+                             << segments_.size();
+                }
+            }
+
+            seg->used_ = c.offset_ + c.csize_;
+            seg->last_ = c.last_;
+            chunks_.push_back(c);
+            size_ += c.csize_;
+
+            if (debug_)
+            {
+                log_info << "GCache cold store: chunk " << c.first_ << '-'
+                         << c.last_ << ", " << c.usize_ << " -> " << c.csize_
+                         << " bytes (" << c.type_ << ')';
+            }
+
+            trim();
+        }
+    }
+
+    void*
+    ColdStore::flush_thread (void* const arg)
+    {
+        static_cast<ColdStore*>(arg)->flush_loop();
+        return NULL;
+    }
+
+    void
+    ColdStore::trim ()
+    {
+        /* the last segment is kept, so the limit is approximate */
+        while (size_ > max_size_ && segments_.size() > 1 &&
+               segments_.front()->last_ < seqno_locked_)
+        {
+            SegmentPtr const seg(segments_.front());
+
+            while (chunks_.front().segment_ == seg) chunks_.pop_front();
+
+            size_ -= seg->used_;
+            segments_.pop_front();
+
+            assert(!chunks_.empty());
+            seqno_min_ = chunks_.front().first_;
+        }
+    }
+
+    bool
+    ColdStore::find (seqno_t const seqno, Reader& r)
+    {
+        gu::Lock lock(mtx_);
+
+        if (!contains_locked(seqno)) return false;
+
+        /* hand the open batch over instead of copying it */
+        if (batch_ && seqno >= batch_first_) seal();
+
+        if (!pending_.empty() && seqno >= pending_.front().first_)
+        {
+            struct BatchLess
+            {
+                bool operator()(const Batch& b, seqno_t const s) const
+                {
+                    return b.last_ < s;
+                }
+            };
+
+            std::deque<Batch>::const_iterator const i
+                (std::lower_bound(pending_.begin(), pending_.end(), seqno,
+                                  BatchLess()));
+
+            assert(i != pending_.end());
+            assert(i->first_ <= seqno);
+
+            r.chunk_   = Chunk();
+            r.pending_ = i->data_;
+        }
+        else
+        {
+            struct ChunkLess
+            {
+                bool operator()(const Chunk& c, seqno_t const s) const
+                {
+                    return c.last_ < s;
+                }
+            };
+
+            std::deque<Chunk>::const_iterator const i
+                (std::lower_bound(chunks_.begin(), chunks_.end(), seqno,
+                                  ChunkLess()));
+
+            assert(i != chunks_.end());
+            assert(i->first_ <= seqno);
+
+            r.chunk_ = *i;
+            r.pending_.reset();
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<const ColdStore::Data>
+    ColdStore::Reader::read () const
+    {
+        assert(valid());
+
+        if (pending_) return pending_;
+
+        std::shared_ptr<Data> const ret(std::make_shared<Data>(chunk_.usize_));
+        const gu::FileDescriptor& fd(chunk_.segment_->fd_);
+
+        if (gu::Compression::NONE == chunk_.type_)
+        {
+            read_full(fd, ret->data(), chunk_.usize_, chunk_.offset_);
+        }
+        else
+        {
+            Data tmp(chunk_.csize_);
+            read_full(fd, tmp.data(), chunk_.csize_, chunk_.offset_);
+            gu::Compression::decompress(chunk_.type_, tmp.data(), tmp.size(),
+                                        ret->data(), ret->size());
+        }
+
+        return ret;
+    }
+
+    void
+    ColdStore::reset_locked ()
+    {
+        segments_.clear();
+        chunks_.clear();
+        pending_.clear();
+        pending_size_ = 0;
+        batch_.reset();
+        gen_++;
+        cond_.broadcast();
+
+        batch_first_ = SEQNO_NONE;
+        seqno_min_   = SEQNO_NONE;
+        seqno_max_   = SEQNO_NONE;
+        size_        = 0;
+    }
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+/*! @file compressed cold store class
+ *
+ * Released ordered buffers which are about to be discarded from the hot
+ * stores (MemStore, RingBuffer, PageStore) are appended here to extend the
+ * history available for IST. Buffers are gathered into batches which are
+ * handed over to a background thread to be compressed into chunks and
+ * appended to segment files. Seqno index is kept in memory only, so the store
+ * is not recovered on restart and segment files are unlinked right after
+ * creation. The oldest segments are dropped when the total compressed size
+ * exceeds the limit.
+ *
+ * The store has its own mutex which may be taken under the GCache mutex,
+ * but not the other way around. Compression and IO are done without either.
+ */
+
+#ifndef _gcache_cold_store_hpp_
+#define _gcache_cold_store_hpp_
+
+#include "gcache_bh.hpp"
+#include "gcache_seqno.hpp"
+
+#include <gu_compress.hpp>
+#include <gu_fdesc.hpp>
+#include <gu_lock.hpp>
+#include <gu_macros.hpp> // GU_COMPILE_ASSERT
+#include <gu_threads.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gcache
+{
+    class ColdStore
+    {
+    public:
+
+        /*! buffer record in the uncompressed chunk, followed by payload */
+        struct Record
+        {
+            int64_t  seqno_g;
+            uint32_t size;    /*! payload size */
+            int8_t   type;
+            uint8_t  skip;
+            uint16_t pad;
+        };
+
+        GU_COMPILE_ASSERT((sizeof(Record) % MemOps::ALIGNMENT) == 0,
+                          record_alignment_check);
+
+        static const Record* next(const Record* const r)
+        {
+            return reinterpret_cast<const Record*>(
+                reinterpret_cast<const uint8_t*>(r + 1) +
+                GU_ALIGN(r->size, MemOps::ALIGNMENT));
+        }
+
+        typedef std::vector<uint8_t> Data;
+
+    private:
+
+        struct Segment
+        {
+            gu::FileDescriptor fd_;
+            off_t              used_;
+            seqno_t            last_;
+
+            Segment(const std::string& name, size_t size);
+        };
+
+        typedef std::shared_ptr<Segment> SegmentPtr;
+
+        /* batch sealed for compression and writing */
+        struct Batch
+        {
+            seqno_t                     first_;
+            seqno_t                     last_;
+            std::shared_ptr<const Data> data_;
+        };
+
+        struct Chunk
+        {
+            seqno_t               first_;
+            seqno_t               last_;
+            SegmentPtr            segment_;
+            off_t                 offset_;
+            size_t                csize_;
+            size_t                usize_;
+            gu::Compression::Type type_;
+        };
+
+    public:
+
+        /*!
+         * Handle to the chunk containing requested seqno. Stays valid after
+         * the chunk is dropped from the store.
+         */
+        class Reader
+        {
+        public:
+
+            Reader() : chunk_(), pending_() {}
+
+            bool valid() const { return chunk_.segment_ || pending_; }
+
+            /*! reads and decompresses the chunk, may cause IO
+             *  @throws gu::Exception */
+            std::shared_ptr<const Data> read() const;
+
+        private:
+
+            Chunk                       chunk_;
+            std::shared_ptr<const Data> pending_; // not yet written batch
+
+            friend class ColdStore;
+        };
+
+        ColdStore (const std::string&    dir_name,
+                   size_t                max_size,
+                   gu::Compression::Type type,
+                   int                   dbg);
+
+        ~ColdStore();
+
+        bool enabled() const { return max_size_ > 0; }
+
+        /*! appends released buffer which is about to be discarded,
+         *  blocks if too many batches are waiting to be written */
+        void append (const BufferHeader* bh);
+
+        bool empty() const
+        {
+            gu::Lock lock(mtx_);
+            return SEQNO_NONE == seqno_min_;
+        }
+
+        /*! @return SEQNO_NONE if empty */
+        seqno_t seqno_min() const
+        {
+            gu::Lock lock(mtx_);
+            return seqno_min_;
+        }
+
+        /*! @return SEQNO_NONE if empty */
+        seqno_t seqno_max() const
+        {
+            gu::Lock lock(mtx_);
+            return seqno_max_;
+        }
+
+        bool contains (seqno_t const s) const
+        {
+            gu::Lock lock(mtx_);
+            return contains_locked(s);
+        }
+
+        /*! seqnos from s up must not be dropped */
+        void set_locked (seqno_t const s)
+        {
+            gu::Lock lock(mtx_);
+            seqno_locked_ = s;
+        }
+
+        /*! @return false if seqno is not in the store */
+        bool find (seqno_t s, Reader& r);
+
+        void reset()
+        {
+            gu::Lock lock(mtx_);
+            reset_locked();
+        }
+
+        /*! compressed size on disk */
+        size_t size() const
+        {
+            gu::Lock lock(mtx_);
+            return size_;
+        }
+
+        void set_debug(int const dbg)
+        {
+            gu::Lock lock(mtx_);
+            debug_ = dbg & DEBUG;
+        }
+
+    private:
+
+        static int    const DEBUG = 8; // debug flag
+        static size_t const BATCH_SIZE  = 1 << 20; // 1M
+        static size_t const MAX_PENDING = 8 * BATCH_SIZE;
+
+        bool contains_locked (seqno_t const s) const
+        {
+            return (SEQNO_NONE != seqno_min_ &&
+                    s >= seqno_min_ && s <= seqno_max_);
+        }
+
+        void reset_locked();
+
+        /* hands the open batch over to the flush thread */
+        void seal();
+
+        /* compresses and writes the batch to seg at offset or to a new
+         * segment if it does not fit there, called without lock */
+        Chunk write_chunk(const Batch& b, SegmentPtr& seg, off_t offset,
+                          size_t count);
+
+        void trim();
+
+        void flush_loop();
+
+        static void* flush_thread(void* arg);
+
+        std::string const      base_name_;
+        size_t const           max_size_;
+        size_t const           segment_size_;
+        gu::Compression::Type  type_;
+        std::deque<SegmentPtr> segments_;
+        std::deque<Chunk>      chunks_;
+        std::deque<Batch>      pending_;  /* sealed batches to be written */
+        size_t                 pending_size_;
+        std::shared_ptr<Data>  batch_;    /* open batch */
+        Data                   cbuf_;     /* compression buffer, flush thread */
+        seqno_t                batch_first_;
+        seqno_t                seqno_min_;
+        seqno_t                seqno_max_;
+        seqno_t                seqno_locked_;
+        size_t                 size_;
+        size_t                 count_;
+        unsigned long          gen_;      /* changes on reset */
+        int                    debug_;
+        mutable gu::Mutex      mtx_;
+        gu::Cond               cond_;
+        gu_thread_t            flush_thr_;
+        bool                   exit_;
+
+        ColdStore(const ColdStore&);
+        ColdStore& operator=(const ColdStore&);
+    };
+}
+
+#endif /* _gcache_cold_store_hpp_ */
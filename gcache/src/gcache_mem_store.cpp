@@ -4,6 +4,7 @@
 
 #include "gcache_mem_store.hpp"
 #include "gcache_page_store.hpp"
+#include "gcache_cold_store.hpp"
 
 #include <gu_logger.hpp>
 
@@ -20,6 +21,8 @@ MemStore::have_free_space (size_type size)
 
         if (BH_is_released(bh)) /* discard buffer */
         {
+            if (cold_) cold_->append(bh);
+
             seqno2ptr_.pop_front();
             bh->seqno_g = SEQNO_ILL;
 
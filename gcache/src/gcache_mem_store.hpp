@@ -17,6 +17,8 @@
 
 namespace gcache
 {
+    class ColdStore;
+
     class MemStore : public MemOps
     {
     public:
@@ -26,6 +28,7 @@ namespace gcache
               size_     (0),
               allocd_   (),
               seqno2ptr_(seqno2ptr),
+              cold_     (NULL),
               debug_    (dbg & DEBUG)
         {}
 
@@ -156,6 +159,9 @@ namespace gcache
 
         void set_debug(int const dbg) { debug_ = dbg & DEBUG; }
 
+        /* discarded seqnos will be appended to cs */
+        void set_cold_store(ColdStore* const cs) { cold_ = cs; }
+
     private:
 
         static int const DEBUG = 1;
@@ -166,6 +172,7 @@ namespace gcache
         size_t          size_;
         std::set<void*> allocd_;
         seqno2ptr_t&    seqno2ptr_;
+        ColdStore*      cold_;
         int             debug_;
     };
 }
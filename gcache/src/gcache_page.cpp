@@ -10,12 +10,14 @@
 #include <gu_throw.hpp>
 #include <gu_logger.hpp>
 #include <gu_hexdump.hpp>
+#include <gu_limits.h> // GU_PAGE_SIZE
 
 // for posix_fadvise()
 #if !defined(_XOPEN_SOURCE)
 #define _XOPEN_SOURCE 600
 #endif
 #include <fcntl.h>
+#include <sys/mman.h> // madvise()
 
 // for nonce initialization
 #include <chrono>
@@ -95,6 +97,21 @@ gcache::Page::drop_fs_cache() const
 #endif
 }
 
+void
+gcache::Page::prefault()
+{
+#ifdef MADV_POPULATE_WRITE /* Linux 5.14+ */
+    if (0 == ::madvise(mmap_.ptr, mmap_.size, MADV_POPULATE_WRITE)) return;
+#endif
+    volatile uint8_t* const ptr(static_cast<uint8_t*>(mmap_.ptr));
+    size_t            const page_size(GU_PAGE_SIZE);
+
+    for (size_t off(0); off < mmap_.size; off += page_size)
+    {
+        ptr[off] = ptr[off];
+    }
+}
+
 gcache::Page::Page (void*              ps,
                     const std::string& name,
                     const EncKey&      key,
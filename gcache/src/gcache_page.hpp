@@ -156,6 +156,16 @@ namespace gcache
         /* Drop filesystem cache on the file */
         void drop_fs_cache() const;
 
+        /* Fault in the whole mapping, so that later writes to the page
+         * don't block on the filesystem */
+        void prefault();
+
+        /* Hint that the page will be read sequentially */
+        void advise_sequential(bool const s) const
+        {
+            mmap_.advise_sequential(s);
+        }
+
         void* parent() const { return ps_; }
 
         void print(std::ostream& os) const;
@@ -10,6 +10,7 @@
 
 #include <gu_logger.hpp>
 #include <gu_throw.hpp>
+#include <gu_thread_keys.hpp>
 
 #include <cstdio>
 #include <cstring>
@@ -135,7 +136,158 @@ gcache::PageStore::set_enc_key (const Page::EncKey& new_key)
         log_info << "GCache: encryption key rotated, size: " << new_key.size();
     }
     new_page(0, new_key);
+
+    gu::Lock lock(pool_mtx_);
     enc_key_ = new_key;
+    pool_trim(true); /* pre-created pages use old key */
+}
+
+std::pair<std::string, gcache::Page::Nonce>
+gcache::PageStore::next_page_id (size_type const size)
+{
+    gu::Lock lock(pool_mtx_);
+
+    std::pair<std::string, Page::Nonce> const ret
+        (make_page_name(base_name_, count_), nonce_);
+
+    count_++;
+    nonce_ += Page::aligned_size(size); /* advance nonce for the next page */
+
+    return ret;
+}
+
+gcache::Page*
+gcache::PageStore::pool_take (size_type const min_size,
+                              const Page::EncKey& new_key)
+{
+    if (0 == pool_size_) return NULL;
+
+    gu::Lock lock(pool_mtx_);
+
+    if (pool_.empty() || pool_.front()->size() < min_size ||
+        new_key != enc_key_ /* this is a key change page */)
+    {
+        return NULL;
+    }
+
+    Page* const page(pool_.front());
+    pool_.pop_front();
+    pool_cond_.signal(); /* create a replacement */
+
+    return page;
+}
+
+/* must be called with pool_mtx_ locked */
+void
+gcache::PageStore::pool_trim (bool const stale)
+{
+    if (stale) pool_gen_++; /* pages being created are stale too */
+
+    while (pool_.size() > (stale ? 0 : pool_size_))
+    {
+        Page* const page(pool_.back());
+        std::string const name(page->name());
+
+        pool_.pop_back();
+        delete page;
+
+        if (remove(name.c_str()))
+        {
+            int const err(errno);
+            log_error << "Failed to remove page file '" << name << "': "
+                      << err << " (" << strerror(err) << ")";
+        }
+    }
+
+    pool_cond_.signal(); /* refill */
+}
+
+void
+gcache::PageStore::pool_loop ()
+{
+    gu::Lock lock(pool_mtx_);
+
+    while (!pool_exit_)
+    {
+        if (pool_.size() >= pool_size_)
+        {
+            lock.wait(pool_cond_);
+            continue;
+        }
+
+        size_type     const size(page_size_);
+        Page::EncKey  const key(enc_key_);
+        int           const dbg(debug_);
+        unsigned long const gen(pool_gen_);
+
+        Page* page(NULL);
+
+        /* don't hold the lock while creating the page */
+        pool_mtx_.unlock();
+        try
+        {
+            std::pair<std::string, Page::Nonce> const id(next_page_id(size));
+            page = new Page(this, id.first, key, id.second, size, dbg);
+            page->prefault();
+        }
+        catch (std::exception& e)
+        {
+            log_warn << "Failed to pre-create cache page: " << e.what();
+        }
+        pool_mtx_.lock();
+
+        if (NULL == page)
+        {
+            /* retry when the next page is taken or settings change */
+            if (!pool_exit_) lock.wait(pool_cond_);
+        }
+        else
+        {
+            pool_.push_back(page);
+            if (gen != pool_gen_ || pool_exit_) pool_trim(true);
+        }
+    }
+}
+
+void*
+gcache::PageStore::pool_thread (void* const arg)
+{
+    static_cast<PageStore*>(arg)->pool_loop();
+    return NULL;
+}
+
+void
+gcache::PageStore::set_prealloc_pages (size_t const n)
+{
+    gu::Lock lock(pool_mtx_);
+
+    pool_size_ = n;
+    pool_trim(false);
+
+    if (pool_size_ > 0 && pool_thr_ == pthread_t(-1))
+    {
+        int const err(pthread_create(&pool_thr_, NULL, pool_thread, this));
+        if (0 != err)
+        {
+            pool_thr_ = pthread_t(-1);
+            gu_throw_system_error(err)
+                << "Failed to create page pre-creation thread";
+        }
+    }
+
+    pool_cond_.signal();
+}
+
+void
+gcache::PageStore::set_page_size (size_t const size)
+{
+    gu::Lock lock(pool_mtx_);
+
+    if (size != page_size_)
+    {
+        page_size_ = size;
+        pool_trim(true); /* let them be recreated with the new size */
+    }
 }
 
 inline void
@@ -145,18 +297,20 @@ gcache::PageStore::new_page (size_type const size, const Page::EncKey& new_key)
     size_type const meta_size(Page::meta_size(key_buf_size));
     size_type const min_size(meta_size + Page::aligned_size(size));
 
-    Page* const page(new Page(this,
-                              make_page_name(base_name_, count_),
-                              new_key,
-                              nonce_,
-                              page_size_ > min_size ? page_size_ : min_size,
-                              debug_));
+    Page* page(pool_take(min_size, new_key));
+
+    if (NULL == page)
+    {
+        size_type const page_size(page_size_ > min_size ?
+                                  page_size_ : min_size);
+        std::pair<std::string, Page::Nonce> const id(next_page_id(page_size));
+
+        page = new Page(this, id.first, new_key, id.second, page_size, debug_);
+    }
 
     pages_.push_back (page);
     total_size_ += page->size();
     current_ = page;
-    count_++;
-    nonce_ += page->size(); /* advance nonce for the next page */
 
     /* allocate, write and release key buffer */
 
@@ -203,7 +357,8 @@ gcache::PageStore::PageStore (const std::string&       dir_name,
                               size_t             const page_size,
                               size_t             const keep_plaintext_size,
                               int                const dbg,
-                              bool               const keep_page)
+                              bool               const keep_page,
+                              size_t             const prealloc_pages)
     :
     base_name_ (make_base_name(dir_name)),
     encrypt_cb_(encrypt_cb),
@@ -224,7 +379,14 @@ gcache::PageStore::PageStore (const std::string&       dir_name,
     delete_thr_(pthread_t(-1)),
 #endif /* GCACHE_DETACH_THREAD */
     debug_     (dbg & DEBUG),
-    keep_page_ (keep_page)
+    keep_page_ (keep_page),
+    pool_      (),
+    pool_mtx_  (gu::get_mutex_key(gu::GU_MUTEX_KEY_GCACHE_PAGE_POOL)),
+    pool_cond_ (gu::get_cond_key(gu::GU_COND_KEY_GCACHE_PAGE_POOL)),
+    pool_size_ (0),
+    pool_gen_  (0),
+    pool_thr_  (pthread_t(-1)),
+    pool_exit_ (false)
 {
     int err = pthread_attr_init (&delete_page_attr_);
 
@@ -244,6 +406,19 @@ gcache::PageStore::PageStore (const std::string&       dir_name,
                                    << "page file deletion thread";
     }
 #endif /* GCACHE_DETACH_THREAD */
+
+    if (prealloc_pages > 0)
+    {
+        try
+        {
+            set_prealloc_pages(prealloc_pages);
+        }
+        catch (...)
+        {
+            pthread_attr_destroy (&delete_page_attr_);
+            throw;
+        }
+    }
 }
 
 void
@@ -261,6 +436,20 @@ gcache::PageStore::Plain::print(std::ostream& os) const
 
 gcache::PageStore::~PageStore ()
 {
+    if (pool_thr_ != pthread_t(-1))
+    {
+        {
+            gu::Lock lock(pool_mtx_);
+            pool_exit_ = true;
+            pool_cond_.signal();
+        }
+
+        pthread_join(pool_thr_, NULL);
+
+        gu::Lock lock(pool_mtx_);
+        pool_trim(true);
+    }
+
     if (enc2plain_.size() > 0)
     {
         int unflushed(0);
@@ -594,10 +783,26 @@ gcache::PageStore::repossess(BufferHeader* bh, const void* ptr)
 void
 gcache::PageStore::set_debug(int const dbg)
 {
+    gu::Lock lock(pool_mtx_);
+
     debug_ = dbg & DEBUG;
 
+    for (PageQueue::iterator i(pool_.begin()); i != pool_.end(); ++i)
+    {
+        (*i)->set_debug(debug_);
+    }
+
     for (PageQueue::iterator i(pages_.begin()); i != pages_.end(); ++i)
     {
         (*i)->set_debug(debug_);
     }
 }
+
+void
+gcache::PageStore::advise_sequential(bool const s) const
+{
+    for (PageQueue::const_iterator i(pages_.begin()); i != pages_.end(); ++i)
+    {
+        (*i)->advise_sequential(s);
+    }
+}
@@ -12,6 +12,7 @@
 #include "gcache_seqno.hpp"
 
 #include <gu_macros.hpp> // GU_COMPILE_ASSERT
+#include <gu_lock.hpp>
 
 #include <string>
 #include <deque>
@@ -34,7 +35,8 @@ namespace gcache
                    size_t             page_size,
                    size_t             plaintext_size,
                    int                dbg,
-                   bool               keep_page);
+                   bool               keep_page,
+                   size_t             prealloc_pages = 0);
 
         ~PageStore ();
 
@@ -84,7 +86,7 @@ namespace gcache
 
         void  set_enc_key(const Page::EncKey& key);
 
-        void  set_page_size (size_t size) { page_size_ = size; }
+        void  set_page_size (size_t size);
 
         void  set_keep_size (size_t size) { keep_size_ = size; }
 
@@ -95,10 +97,21 @@ namespace gcache
 
         void  set_debug(int dbg);
 
+        /* number of pages to pre-create in the background */
+        void  set_prealloc_pages (size_t n);
+
+        /* applies to existing pages only: new ones are hot in cache anyway */
+        void  advise_sequential(bool s) const;
+
         /* for unit tests */
         size_t count()       const { return count_;        }
         size_t total_pages() const { return pages_.size(); }
         size_t total_size()  const { return total_size_;   }
+        size_t pool_pages()  const
+        {
+            gu::Lock lock(pool_mtx_);
+            return pool_.size();
+        }
 
         void meta(const void* const ptr, std::ostream& os)
         {
@@ -149,8 +162,33 @@ namespace gcache
         int               debug_;
         bool        const keep_page_; /* whether to keep the last page */
 
+        /* Pages pre-created by pool_thr_ so that new_page() does not have to
+         * create, allocate and map files on the allocating thread. pool_mtx_
+         * also protects count_, nonce_, enc_key_, page_size_ and debug_
+         * against concurrent reads from pool_thr_. */
+        PageQueue         pool_;
+        gu::Mutex         pool_mtx_;
+        gu::Cond          pool_cond_;
+        size_t            pool_size_; /* how many pages to keep ready */
+        unsigned long     pool_gen_;  /* changes when pool pages go stale */
+        pthread_t         pool_thr_;
+        bool              pool_exit_;
+
         void new_page    (size_type size, const Page::EncKey& k);
 
+        /* name and nonce for a new page of a given size */
+        std::pair<std::string, Page::Nonce> next_page_id (size_type size);
+
+        /* returns a pre-created page of at least min_size or NULL */
+        Page* pool_take  (size_type min_size, const Page::EncKey& k);
+
+        /* deletes pre-created pages in excess of pool_size_, all if stale */
+        void pool_trim   (bool stale);
+
+        void pool_loop   ();
+
+        static void* pool_thread (void* arg);
+
         // returns true if a page could be deleted
         bool delete_page ();
 
@@ -18,6 +18,22 @@ static const std::string GCACHE_PARAMS_KEEP_PAGES_SIZE("gcache.keep_pages_size")
 static const std::string GCACHE_DEFAULT_KEEP_PAGES_SIZE("0");
 static const std::string GCACHE_PARAMS_KEEP_PLAINTEXT_SIZE
     ("gcache.keep_plaintext_size");
+static const std::string GCACHE_PARAMS_PREALLOC_PAGES
+    ("gcache.prealloc_pages");
+static const std::string GCACHE_DEFAULT_PREALLOC_PAGES("0");
+/* Size limit of the compressed history kept after buffers are discarded from
+ * the hot stores, 0 disables it. The history is held in unlinked segment
+ * files and indexed in memory only, so it is lost on restart: a restarted
+ * donor can serve IST only from what it has in the ring buffer and pages. */
+static const std::string GCACHE_PARAMS_COLD_SIZE  ("gcache.cold_size");
+static const std::string GCACHE_DEFAULT_COLD_SIZE ("0");
+static const std::string GCACHE_PARAMS_COLD_COMPRESSION
+    ("gcache.cold_compression");
+#ifdef GALERA_HAVE_LZ4
+static const std::string GCACHE_DEFAULT_COLD_COMPRESSION("lz4");
+#else
+static const std::string GCACHE_DEFAULT_COLD_COMPRESSION("none");
+#endif
 #ifndef NDEBUG
 static const std::string GCACHE_PARAMS_DEBUG      ("gcache.debug");
 static const std::string GCACHE_DEFAULT_DEBUG     ("0");
@@ -45,6 +61,12 @@ gcache::GCache::Params::register_params(gu::Config& cfg)
             gu::Config::Flag::type_integer);
     cfg.add(GCACHE_PARAMS_KEEP_PLAINTEXT_SIZE,
             gu::Config::Flag::type_integer);
+    cfg.add(GCACHE_PARAMS_PREALLOC_PAGES, GCACHE_DEFAULT_PREALLOC_PAGES,
+            gu::Config::Flag::type_integer);
+    cfg.add(GCACHE_PARAMS_COLD_SIZE, GCACHE_DEFAULT_COLD_SIZE,
+            gu::Config::Flag::read_only | gu::Config::Flag::type_integer);
+    cfg.add(GCACHE_PARAMS_COLD_COMPRESSION, GCACHE_DEFAULT_COLD_COMPRESSION,
+            gu::Config::Flag::read_only);
 #ifndef NDEBUG
     cfg.add(GCACHE_PARAMS_DEBUG,           GCACHE_DEFAULT_DEBUG);
 #endif
@@ -85,6 +107,10 @@ gcache::GCache::Params::Params (gu::Config& cfg, const std::string& data_dir)
     page_size_(cfg.get<size_t>(GCACHE_PARAMS_PAGE_SIZE)),
     keep_pages_size_(cfg.get<size_t>(GCACHE_PARAMS_KEEP_PAGES_SIZE)),
     keep_plaintext_size_(page_size_), /* default to page_size_ */
+    prealloc_pages_(cfg.get<size_t>(GCACHE_PARAMS_PREALLOC_PAGES)),
+    cold_size_(cfg.get<size_t>(GCACHE_PARAMS_COLD_SIZE)),
+    cold_compression_(gu::Compression::type
+                      (cfg.get(GCACHE_PARAMS_COLD_COMPRESSION))),
 #ifndef NDEBUG
     debug_    (cfg.get<int>(GCACHE_PARAMS_DEBUG)),
 #else
@@ -174,6 +200,27 @@ gcache::GCache::param_set (const std::string& key, const std::string& val)
         params.keep_plaintext_size(tmp_size);
         ps.set_keep_plaintext_size(params.keep_plaintext_size());
     }
+    else if (key == GCACHE_PARAMS_PREALLOC_PAGES)
+    {
+        size_t tmp_n = gu::Config::from_config<size_t>(val);
+
+        gu::Lock lock(mtx);
+        /* locking here serves two purposes: ensures atomic setting of config
+         * and params.prealloc_pages and syncs with malloc() method */
+
+        ps.set_prealloc_pages(tmp_n);
+        config.set<size_t>(key, tmp_n);
+        params.prealloc_pages(tmp_n);
+    }
+    else if (key == GCACHE_PARAMS_COLD_SIZE)
+    {
+        gu_throw_error(EPERM) << "Can't change cold store size in runtime.";
+    }
+    else if (key == GCACHE_PARAMS_COLD_COMPRESSION)
+    {
+        gu_throw_error(EPERM) << "Can't change cold store compression in "
+            "runtime.";
+    }
     else if (key == GCACHE_PARAMS_RECOVER)
     {
         gu_throw_error(EINVAL) << "'" << key
@@ -193,6 +240,7 @@ gcache::GCache::param_set (const std::string& key, const std::string& val)
         mem.set_debug(params.debug());
         rb.set_debug(params.debug());
         ps.set_debug(params.debug());
+        cs.set_debug(params.debug());
     }
 #endif
     else
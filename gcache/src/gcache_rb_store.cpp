@@ -5,6 +5,7 @@
 #include "gcache_rb_store.hpp"
 #include "gcache_page_store.hpp"
 #include "gcache_mem_store.hpp"
+#include "gcache_cold_store.hpp"
 #include "gcache_limits.hpp"
 
 #include <gu_logger.hpp>
@@ -12,10 +13,14 @@
 #include <gu_progress.hpp>
 #include <gu_hexdump.hpp>
 #include <gu_hash.h>
+#include <gu_limits.h> // GU_PAGE_SIZE
 
+#include <algorithm>
 #include <cassert>
 #include <iostream> // std::cerr
 
+#include <sys/mman.h> // posix_madvise()
+
 namespace gcache
 {
     static inline size_t check_size (size_t s)
@@ -76,6 +81,7 @@ namespace gcache
         size_trail_(0),
 //        mallocs_   (0),
 //        reallocs_  (0),
+        cold_      (NULL),
         debug_     (dbg & DEBUG),
         open_      (true)
     {
@@ -120,6 +126,8 @@ namespace gcache
 
             if (gu_likely (BH_is_released(bh)))
             {
+                if (cold_) cold_->append(bh);
+
                 seqno2ptr_.erase (j);
 
                 switch (bh->store)
@@ -709,6 +717,71 @@ namespace gcache
         ProgressCallback* pcb_;
     };
 
+    /* Helper class to ask the kernel to read the ring ahead of the serial
+     * scan, so that the scan does not wait for the pages to be read from
+     * disk one by one. Read-ahead is limited to a window ahead of the scan,
+     * so that the pages are not evicted before the scan gets to them. */
+    class scan_readahead
+    {
+    public:
+        scan_readahead(uint8_t* const begin, uint8_t* const end,
+                       uint8_t* const from)
+            : begin_  (begin),
+              end_    (end),
+              next_   (from),
+              size_   (end - begin),
+              scanned_(0),
+              advised_(0)
+        {
+            advise();
+        }
+
+        void update(size_t const amount)
+        {
+            scanned_ += amount;
+            if (scanned_ + WINDOW/2 >= advised_) advise();
+        }
+
+    private:
+
+        static size_t const CHUNK  = 1 << 24; // 16M
+        static size_t const WINDOW = 1 << 26; // 64M
+
+        /* advises the ring in chunks up to WINDOW ahead of the scan,
+         * wrapping around at the end */
+        void advise()
+        {
+            static uintptr_t const PAGE_SIZE_MASK(~(GU_PAGE_SIZE - 1));
+
+            while (advised_ < size_ && advised_ < scanned_ + WINDOW)
+            {
+                if (next_ >= end_) next_ = begin_;
+
+                size_t   const left(end_ - next_);
+                size_t   const len(left < CHUNK ? left : CHUNK);
+                uint8_t* const addr(reinterpret_cast<uint8_t*>
+                                    (uintptr_t(next_) & PAGE_SIZE_MASK));
+
+                /* just a hint, the scan works without it */
+                (void)posix_madvise(addr, next_ + len - addr,
+                                    POSIX_MADV_WILLNEED);
+
+                next_    += len;
+                advised_ += len;
+            }
+        }
+
+        uint8_t* const begin_;
+        uint8_t* const end_;
+        uint8_t*       next_;
+        size_t   const size_;
+        size_t         scanned_;
+        size_t         advised_;
+
+        scan_readahead(const scan_readahead&);
+        scan_readahead& operator=(const scan_readahead&);
+    };
+
     seqno_t
     RingBuffer::scan(off_t const offset, int const scan_step)
     {
@@ -738,6 +811,7 @@ namespace gcache
         gu::Progress<ptrdiff_t> progress(&scan_progress_callback,
                                          "GCache::RingBuffer initial scan",
                                          " bytes", end_ - start_, 1<<22/*4Mb*/);
+        scan_readahead readahead(start_, end_, segment_start);
 
         while (segment_scans < 2)
         {
@@ -755,6 +829,7 @@ namespace gcache
 #define GCACHE_SCAN_ADVANCE(amount)             \
             ptr += amount;                      \
             progress.update(amount);            \
+            readahead.update(amount);           \
             bh = BH_cast(ptr);                  \
             bh_offset = BH_offset(bh);
 
@@ -19,6 +19,8 @@
 
 namespace gcache
 {
+    class ColdStore;
+
     class RingBuffer : public MemOps
     {
     public:
@@ -74,6 +76,11 @@ namespace gcache
 
         void  seqno_reset();
 
+        void  advise_sequential(bool const s) const
+        {
+            mmap_.advise_sequential(s);
+        }
+
         /* returns true when successfully discards all seqnos in range */
         bool  discard_seqnos(seqno2ptr_t::iterator i_begin,
                              seqno2ptr_t::iterator i_end);
@@ -132,6 +139,9 @@ namespace gcache
 
         void set_debug(int const dbg) { debug_ = dbg & DEBUG; }
 
+        /* discarded seqnos will be appended to cs */
+        void set_cold_store(ColdStore* const cs) { cold_ = cs; }
+
 #ifdef GCACHE_RB_UNIT_TEST
         ptrdiff_t offset(const void* const ptr) const
         {
@@ -178,6 +188,8 @@ namespace gcache
         size_t             size_used_;
         size_t             size_trail_;
 
+        ColdStore*         cold_;
+
         int                debug_;
 
         bool               open_;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "GCache.hpp"
+#include "gcache_cold_test.hpp"
+
+#include <gu_config.hpp>
+
+#include <cstring>
+#include <unistd.h>
+
+using namespace gcache;
+
+static std::string const CACHE_NAME("gcache_cold_test.cache");
+static int         const BUF_SIZE(4096);
+
+static void
+fill(GCache& gc, seqno_t const first, seqno_t const last)
+{
+    for (seqno_t i(first); i <= last; ++i)
+    {
+        void* ptx;
+        void* const ptr(gc.malloc(BUF_SIZE, ptx));
+        ck_assert(NULL != ptr);
+
+        /* compressible payload identified by seqno */
+        ::memset(ptx, int(i % 251), BUF_SIZE);
+        ::memcpy(ptx, &i, sizeof(i));
+
+        gc.seqno_assign(ptr, i, i % 3, false);
+        gc.seqno_release(i);
+    }
+}
+
+/* checks that the history from first to last is present and intact */
+static void
+verify(GCache& gc, seqno_t first, seqno_t const last)
+{
+    std::vector<GCache::Buffer> v(100);
+
+    gc.seqno_lock(first);
+
+    size_t n;
+    while (first <= last && (n = gc.seqno_get_buffers(v, first)) > 0)
+    {
+        for (size_t i(0); i < n; ++i, ++first)
+        {
+            ck_assert_msg(v[i].seqno_g() == first, "expected %lld, got %lld",
+                          (long long)first, (long long)v[i].seqno_g());
+            ck_assert(v[i].size() == BUF_SIZE);
+            ck_assert(v[i].type() == first % 3);
+            ck_assert(!v[i].skip());
+
+            seqno_t s;
+            ::memcpy(&s, v[i].ptr(), sizeof(s));
+            ck_assert(s == first);
+            ck_assert(v[i].ptr()[BUF_SIZE - 1] == first % 251);
+        }
+    }
+
+    gc.seqno_unlock();
+
+    ck_assert_msg(first == last + 1, "history ended at %lld, expected %lld",
+                  (long long)first - 1, (long long)last);
+}
+
+/* waits for the cold store to drop history below min in the background */
+static seqno_t
+wait_min_above(GCache& gc, seqno_t const min)
+{
+    for (int i(0); i < 10000; ++i)
+    {
+        seqno_t const ret(gc.seqno_min());
+        if (ret > min) return ret;
+        ::usleep(1000);
+    }
+
+    return gc.seqno_min();
+}
+
+/* locks history at its current beginning, which may be moving */
+static seqno_t
+lock_min(GCache& gc)
+{
+    for (;;)
+    {
+        seqno_t const min(gc.seqno_min());
+        try
+        {
+            gc.seqno_lock(min);
+            return min;
+        }
+        catch (gu::NotFound&) {}
+    }
+}
+
+static void
+make_config(gu::Config& conf, const char* const cold_size,
+            const char* const compression)
+{
+    GCache::register_params(conf);
+    conf.parse("gcache.name = " + CACHE_NAME + "; gcache.size = 4M; "
+               "gcache.page_size = 4M; gcache.cold_size = " + cold_size +
+               "; gcache.cold_compression = " + compression);
+}
+
+START_TEST(cold_history)
+{
+    gu::Config conf;
+    make_config(conf, "64M", "lz4");
+
+    {
+        GCache gc(NULL, conf, "");
+        gc.seqno_reset(gu::GTID(gu::UUID(NULL, 0), SEQNO_NONE));
+
+        /* ring buffer wraps around several times */
+        seqno_t const last(10000);
+        fill(gc, 1, last);
+
+        /* compressed, nothing had to be dropped */
+        ck_assert(gc.seqno_min() == 1);
+        verify(gc, 1, last);
+
+        /* can start in the middle of a chunk */
+        verify(gc, 1234, last);
+
+        /* reading the tail hands the open batch over, appends go on */
+        verify(gc, last - 10, last);
+        fill(gc, last + 1, last + 500);
+        verify(gc, 1, last + 500);
+
+        /* history reset drops cold store too */
+        gc.seqno_reset(gu::GTID(gu::UUID(NULL, 0), SEQNO_NONE));
+        ck_assert(gc.seqno_min() == SEQNO_ILL);
+    }
+
+    ::unlink(CACHE_NAME.c_str());
+}
+END_TEST
+
+START_TEST(cold_trim)
+{
+    gu::Config conf;
+    make_config(conf, "8M", "none");
+
+    {
+        GCache gc(NULL, conf, "");
+        gc.seqno_reset(gu::GTID(gu::UUID(NULL, 0), SEQNO_NONE));
+
+        seqno_t last(10000);
+        fill(gc, 1, last);
+
+        /* uncompressed history exceeds the limit */
+        ck_assert(wait_min_above(gc, 1) > 1);
+
+        /* locked history is not dropped */
+        seqno_t const min(lock_min(gc));
+        verify(gc, min, last);
+        fill(gc, last + 1, last + 2000);
+        ck_assert(gc.seqno_min() == min);
+        verify(gc, min, last + 2000);
+        gc.seqno_unlock();
+
+        gc.seqno_release(last + 2000);
+        last += 4000;
+        fill(gc, last - 1999, last);
+        ck_assert(wait_min_above(gc, min) > min);
+        seqno_t const new_min(lock_min(gc));
+        verify(gc, new_min, last);
+        gc.seqno_unlock();
+    }
+
+    ::unlink(CACHE_NAME.c_str());
+}
+END_TEST
+
+/* cold history is not persisted, restarted cache must not report it */
+START_TEST(cold_restart)
+{
+    gu::Config conf;
+    make_config(conf, "64M", "none");
+
+    seqno_t const last(10000);
+    {
+        GCache gc(NULL, conf, "");
+        gc.seqno_reset(gu::GTID(gu::UUID(NULL, 0), SEQNO_NONE));
+
+        fill(gc, 1, last);
+        ck_assert(gc.seqno_min() == 1);
+    }
+
+    {
+        GCache gc(NULL, conf, "");
+
+        /* only what was left in the ring buffer is recovered */
+        seqno_t const min(gc.seqno_min());
+        ck_assert_msg(min > 1 && min < last, "seqno_min: %lld",
+                      (long long)min);
+        verify(gc, min, last);
+
+        try
+        {
+            gc.seqno_lock(min - 1);
+            ck_abort_msg("seqno %lld below recovered history locked",
+                         (long long)(min - 1));
+        }
+        catch (gu::NotFound&) {}
+
+        /* history is collected again from the recovered position */
+        fill(gc, last + 1, last + 2000);
+        ck_assert(gc.seqno_min() == min);
+        verify(gc, min, last + 2000);
+    }
+
+    ::unlink(CACHE_NAME.c_str());
+}
+END_TEST
+
+Suite* gcache_cold_suite()
+{
+    Suite* s = suite_create("gcache::ColdStore");
+    TCase* tc;
+
+    tc = tcase_create("test");
+    tcase_set_timeout(tc, 60);
+    if (gu::Compression::supported(gu::Compression::LZ4))
+    {
+        tcase_add_test(tc, cold_history);
+    }
+    tcase_add_test(tc, cold_trim);
+    tcase_add_test(tc, cold_restart);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
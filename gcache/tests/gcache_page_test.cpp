@@ -437,6 +437,80 @@ START_TEST(test4) // check that pages linger correctly and get deleted as they
 }
 END_TEST
 
+/* waits for the pre-creation thread to fill the pool */
+static void
+wait_pool(const PageStore& ps, size_t const expect)
+{
+    for (int i(0); i < 1000 && ps.pool_pages() != expect; ++i) usleep(10000);
+
+    ck_assert_msg(ps.pool_pages() == expect,
+                  "Expected pool_pages() = %zu, got %zu",
+                  expect, ps.pool_pages());
+}
+
+/* checks that new pages are taken from the pool of pre-created ones */
+static void
+t5(wsrep_encrypt_cb_t cb, void* app_ctx, const gcache::Page::EncKey& key)
+{
+    bool const enc(NULL != cb);
+    log_test(5, enc);
+
+    const char* const dir_name = "";
+    ssize_t const keep_size = 1;
+    ssize_t const page_size = (1 << 20);
+    ssize_t const buf_size  = page_size/2 + 1024; /* one buffer per page */
+    size_t  const pool_size = 2;
+
+    gcache::PageStore ps(dir_name, cb, app_ctx, keep_size, page_size, page_size,
+                         0, false, pool_size);
+
+    get_BH const BH(ps, enc);
+
+    wait_pool(ps, pool_size);
+    ck_assert(ps.total_pages() == 0);
+
+    /* key change page is never taken from the pool, old pages are dropped */
+    ps.set_enc_key(key);
+    ck_assert(ps.total_pages() == 1);
+    wait_pool(ps, pool_size);
+
+    size_t const count(ps.count());
+
+    void* ptx[4];
+    void* ptr[4];
+
+    for (int i(0); i < 3; ++i)
+    {
+        ptr[i] = ps.malloc(buf_size, ptx[i]);
+        ck_assert(NULL != ptr[i]);
+        ck_assert(ps.total_pages() == size_t(i + 1));
+    }
+
+    /* two pages were taken from the pool and it is refilled */
+    wait_pool(ps, pool_size);
+    ck_assert_msg(ps.count() == count + pool_size,
+                  "Expected count() = %zu, got %zu",
+                  count + pool_size, ps.count());
+
+    /* too big for pooled pages */
+    ptr[3] = ps.malloc(page_size * 2, ptx[3]);
+    ck_assert(NULL != ptr[3]);
+    ck_assert(ps.total_pages() == 4);
+    ck_assert(ps.pool_pages() == pool_size);
+
+    ps.set_prealloc_pages(1);
+    ck_assert(ps.pool_pages() == 1);
+
+    for (int i(0); i < 4; ++i) ps_free(ps, BH(ptr[i]), ptr[i]);
+}
+
+START_TEST(test5)
+{
+    t5(NULL, NULL, Key);
+    t5(gcache_test_encrypt_cb, NULL, Key);
+}
+END_TEST
+
 Suite* gcache_page_suite()
 {
     Suite* s = suite_create("gcache::PageStore");
@@ -447,6 +521,7 @@ Suite* gcache_page_suite()
     tcase_add_test(tc, test2);
     tcase_add_test(tc, test3);
     tcase_add_test(tc, test4);
+    tcase_add_test(tc, test5);
     suite_add_tcase(s, tc);
 
     return s;
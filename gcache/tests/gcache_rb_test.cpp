@@ -505,6 +505,60 @@ START_TEST(recovery)
 }
 END_TEST
 
+/* crash recovery of a ring restores all of its history */
+static void
+test_recovery_full(seqno_t const last)
+{
+    ::unlink(RB_NAME.c_str());
+
+    size_t const rb_size(ALLOC_SIZE(1) * 64);
+
+    seqno2ptr_t s2p(SEQNO_NONE);
+    gu::UUID    gid(GID);
+    RingBuffer  rb(NULL, RB_NAME, rb_size, s2p, gid, 0, false);
+
+    for (seqno_t g(1); g <= last; ++g)
+    {
+        void* const m(rb.malloc(ALLOC_SIZE(1)));
+        ck_assert(NULL != m);
+
+        s2p.insert(g, m);
+        ptr2BH(m)->seqno_g = g;
+        BH_release(ptr2BH(m));
+        rb.free(ptr2BH(m));
+    }
+
+    seqno_t const seqno_min(s2p.index_front());
+    ck_assert(s2p.index_back() == last);
+
+    /* open unclosed file */
+    {
+        seqno2ptr_t s2p1(SEQNO_NONE);
+        gu::UUID    gid1;
+        RingBuffer  rb1(NULL, RB_NAME, rb_size, s2p1, gid1, 0, true);
+
+        ck_assert(!s2p1.empty());
+        ck_assert_msg(s2p1.index_front() == seqno_min,
+                      "expected %lld, got %lld", (long long)seqno_min,
+                      (long long)s2p1.index_front());
+        ck_assert(s2p1.index_back() == last);
+
+        for (seqno_t g(seqno_min); g <= last; ++g)
+        {
+            ck_assert(s2p1[g] != seqno2ptr_t::null_value());
+            ck_assert(ptr2BH(s2p1[g])->seqno_g == g);
+        }
+    }
+
+    ::unlink(RB_NAME.c_str());
+}
+
+START_TEST(recovery_full)
+{
+    /* crash at every point of a few laps: before and after wrap around */
+    for (seqno_t last(40); last <= 300; ++last) test_recovery_full(last);
+}
+END_TEST
 
 Suite* gcache_rb_suite()
 {
@@ -519,6 +573,7 @@ Suite* gcache_rb_suite()
 
     tcase_set_timeout(tc, 60);
     tcase_add_test(tc, recovery);
+    tcase_add_test(tc, recovery_full);
     suite_add_tcase(ts, tc);
 
     return ts;
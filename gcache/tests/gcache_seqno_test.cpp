@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Codership Oy <info@codership.com>
+ */
+
+#include "GCache.hpp"
+#include "gcache_seqno_test.hpp"
+
+#include <gu_config.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+using namespace gcache;
+
+static std::string const CACHE_NAME("gcache_seqno_test.cache");
+static std::string const PAGE_NAME("gcache.page.");
+static int         const BUF_SIZE(4096);
+
+/* assigns seqnos from first to last without releasing them */
+static void
+fill(GCache& gc, seqno_t const first, seqno_t const last)
+{
+    for (seqno_t i(first); i <= last; ++i)
+    {
+        void* ptx;
+        void* const ptr(gc.malloc(BUF_SIZE, ptx));
+        ck_assert(NULL != ptr);
+
+        ::memset(ptx, int(i % 251), BUF_SIZE);
+        ::memcpy(ptx, &i, sizeof(i));
+
+        gc.seqno_assign(ptr, i, 0, false);
+    }
+}
+
+/* checks that the history from first to last is present and intact */
+static void
+verify(GCache& gc, seqno_t first, seqno_t const last)
+{
+    std::vector<GCache::Buffer> v(100);
+
+    gc.seqno_lock(first);
+
+    size_t n;
+    while (first <= last && (n = gc.seqno_get_buffers(v, first)) > 0)
+    {
+        for (size_t i(0); i < n; ++i, ++first)
+        {
+            ck_assert(v[i].seqno_g() == first);
+            ck_assert(v[i].size() == BUF_SIZE);
+
+            seqno_t s;
+            ::memcpy(&s, v[i].ptr(), sizeof(s));
+            ck_assert(s == first);
+            ck_assert(v[i].ptr()[BUF_SIZE - 1] == first % 251);
+        }
+    }
+
+    gc.seqno_unlock();
+
+    ck_assert_msg(first == last + 1, "history ended at %lld, expected %lld",
+                  (long long)first - 1, (long long)last);
+}
+
+/* Counts mappings of files which names contain name and how many of them
+ * are advised for sequential reading ("sr" in smaps VmFlags).
+ * Returns false if this information is not available. */
+static bool
+count_mappings(const std::string& name, int& total, int& sequential)
+{
+    std::ifstream smaps("/proc/self/smaps");
+    if (!smaps) return false;
+
+    total = sequential = 0;
+
+    bool        match(false);
+    bool        flags(false);
+    std::string line;
+    while (std::getline(smaps, line))
+    {
+        if (0 == line.compare(0, 8, "VmFlags:"))
+        {
+            flags = true;
+            if (match && line.find(" sr") != std::string::npos) ++sequential;
+        }
+        else if (line.find('-') < line.find(' ') &&
+                 line.find(':') > line.find(' '))
+        {
+            /* mapping header: address range, perms, ..., path */
+            match = (line.find(name) != std::string::npos);
+            total += match;
+        }
+    }
+
+    return flags;
+}
+
+START_TEST(prefetch)
+{
+    gu::Config conf;
+    GCache::register_params(conf);
+    conf.parse("gcache.name = " + CACHE_NAME + "; gcache.size = 1M; "
+               "gcache.page_size = 1M; gcache.keep_pages_size = 0");
+
+    {
+        GCache gc(NULL, conf, "");
+        gc.seqno_reset(gu::GTID(gu::UUID(NULL, 0), SEQNO_NONE));
+
+        /* ring buffer is filled with unreleased buffers, the rest goes
+         * to pages */
+        seqno_t const last(1000);
+        fill(gc, 1, last);
+
+        int rb, rb_seq, pages, pages_seq;
+        bool const smaps(count_mappings(CACHE_NAME, rb, rb_seq) &&
+                         count_mappings(PAGE_NAME, pages, pages_seq));
+        if (smaps)
+        {
+            ck_assert_int_eq(rb, 1);
+            ck_assert_msg(pages >= 3, "%d pages", pages);
+            ck_assert_int_eq(rb_seq + pages_seq, 0);
+        }
+
+        /* locked history is hinted for sequential reading */
+        gc.seqno_lock(1);
+        if (smaps)
+        {
+            ck_assert(count_mappings(CACHE_NAME, rb, rb_seq));
+            ck_assert(count_mappings(PAGE_NAME, pages, pages_seq));
+            ck_assert_int_eq(rb_seq, 1);
+            ck_assert_int_eq(pages_seq, pages);
+        }
+
+        /* ring buffer and page ranges, past the end of history */
+        gc.seqno_prefetch(1, last);
+        gc.seqno_prefetch(last - 10, 100);
+        verify(gc, 1, last); // nested lock keeps the hint
+
+        if (smaps)
+        {
+            ck_assert(count_mappings(CACHE_NAME, rb, rb_seq));
+            ck_assert(count_mappings(PAGE_NAME, pages, pages_seq));
+            ck_assert_int_eq(rb_seq, 1);
+            ck_assert_int_eq(pages_seq, pages);
+        }
+
+        /* back to normal when the last lock is released */
+        gc.seqno_unlock();
+        if (smaps)
+        {
+            ck_assert(count_mappings(CACHE_NAME, rb, rb_seq));
+            ck_assert(count_mappings(PAGE_NAME, pages, pages_seq));
+            ck_assert_int_eq(rb_seq + pages_seq, 0);
+        }
+
+        /* released buffers are discarded and their pages deleted by new
+         * allocations */
+        seqno_t const released(600);
+        gc.seqno_release(released);
+        fill(gc, last + 1, last + 300);
+
+        if (smaps)
+        {
+            ck_assert(count_mappings(PAGE_NAME + "000000", pages, pages_seq));
+            ck_assert_int_eq(pages, 0);
+        }
+
+        seqno_t const min(gc.seqno_min());
+        ck_assert(min > 1 && min <= released + 1);
+
+        gc.seqno_lock(min);
+        gc.seqno_prefetch(min, last + 300);
+        verify(gc, min, last + 300);
+        gc.seqno_unlock();
+    }
+
+    ::unlink(CACHE_NAME.c_str());
+
+    /* pages with unreleased buffers are left behind */
+    for (int i(0); i < 10; ++i)
+    {
+        std::ostringstream os;
+        os << PAGE_NAME << std::setfill('0') << std::setw(6) << i;
+        ::unlink(os.str().c_str());
+    }
+}
+END_TEST
+
+Suite* gcache_seqno_suite()
+{
+    Suite* s = suite_create("gcache::Seqno");
+    TCase* tc;
+
+    tc = tcase_create("test");
+    tcase_set_timeout(tc, 60);
+    tcase_add_test(tc, prefetch);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
@@ -12,6 +12,8 @@
 #include "gcache_mem_test.hpp"
 #include "gcache_rb_test.hpp"
 #include "gcache_page_test.hpp"
+#include "gcache_cold_test.hpp"
+#include "gcache_seqno_test.hpp"
 
 extern "C" {
 #include <check.h>
@@ -25,6 +27,8 @@ static suite_creator_t suites[] =
     gcache_mem_suite,
     gcache_rb_suite,
     gcache_page_suite,
+    gcache_cold_suite,
+    gcache_seqno_suite,
     0
 };
 
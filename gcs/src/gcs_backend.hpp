@@ -73,6 +73,32 @@ long fn (gcs_backend_t* const backend,    \
          size_t         const len,        \
          gcs_msg_type_t const msg_type)
 
+/*!
+ * Send a message gathered from several buffers. Backends that implement it
+ * spare the caller from assembling the message in a contiguous buffer.
+ *
+ * @param backend
+ *        a pointer to the backend handle
+ * @param bufs
+ *        array of buffers making up the message
+ * @param count
+ *        number of buffers in the array
+ * @param len
+ *        total length of the message
+ * @param msg_type
+ *        type of the message
+ * @return
+ *        negative error code in case of error
+ *        OR
+ *        amount of bytes sent
+ */
+#define GCS_BACKEND_SENDV_FN(fn)                \
+long fn (gcs_backend_t*       const backend,    \
+         const struct gu_buf* const bufs,       \
+         size_t               const count,      \
+         size_t               const len,        \
+         gcs_msg_type_t       const msg_type)
+
 /*!
  * Receive a message from the backend.
  *
@@ -167,6 +193,7 @@ typedef GCS_BACKEND_DESTROY_FN   ((*gcs_backend_destroy_t));
 typedef GCS_BACKEND_OPEN_FN      ((*gcs_backend_open_t));
 typedef GCS_BACKEND_CLOSE_FN     ((*gcs_backend_close_t));
 typedef GCS_BACKEND_SEND_FN      ((*gcs_backend_send_t));
+typedef GCS_BACKEND_SENDV_FN     ((*gcs_backend_sendv_t));
 typedef GCS_BACKEND_RECV_FN      ((*gcs_backend_recv_t));
 typedef GCS_BACKEND_NAME_FN      ((*gcs_backend_name_t));
 typedef GCS_BACKEND_MSG_SIZE_FN  ((*gcs_backend_msg_size_t));
@@ -181,6 +208,7 @@ struct gcs_backend
     gcs_backend_close_t     close;
     gcs_backend_destroy_t   destroy;
     gcs_backend_send_t      send;
+    gcs_backend_sendv_t     sendv; /* optional, may be NULL */
     gcs_backend_recv_t      recv;
     gcs_backend_name_t      name;
     gcs_backend_msg_size_t  msg_size;
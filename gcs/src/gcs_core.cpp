@@ -255,22 +255,33 @@ core_error (core_state_t state)
  * restart flag may be raised if configuration changes and new nodes are
  * added - that would require all previous members to resend partially sent
  * actions.
+ *
+ * Multiple buffers can be passed only if backend supports sendv().
  */
 static inline ssize_t
-core_msg_send (gcs_core_t*    core,
-               const void*    msg,
-               size_t         msg_len,
-               gcs_msg_type_t msg_type)
+core_msg_sendv (gcs_core_t*          core,
+                const struct gu_buf* bufs,
+                size_t               count,
+                size_t               msg_len,
+                gcs_msg_type_t       msg_type)
 {
     ssize_t ret;
 
+    assert (count > 0);
+    assert (1 == count || core->backend.sendv != NULL);
+
     if (gu_unlikely(0 != gu_mutex_lock (&core->send_lock))) abort();
     {
         if (gu_likely((CORE_PRIMARY  == core->state) ||
                       (CORE_EXCHANGE == core->state && GCS_MSG_STATE_MSG ==
                        msg_type))) {
 
-            ret = core->backend.send (&core->backend, msg, msg_len, msg_type);
+            if (1 == count)
+                ret = core->backend.send (&core->backend, bufs[0].ptr,
+                                          msg_len, msg_type);
+            else
+                ret = core->backend.sendv (&core->backend, bufs, count,
+                                           msg_len, msg_type);
 
             if (ret > 0 && ret != (ssize_t)msg_len &&
                 GCS_MSG_ACTION != msg_type) {
@@ -298,16 +309,18 @@ core_msg_send (gcs_core_t*    core,
 
 /*!
  * Repeats attempt at sending the message if -EAGAIN was returned
- * by core_msg_send()
+ * by core_msg_sendv()
  */
 static inline ssize_t
-core_msg_send_retry (gcs_core_t*    core,
-                     const void*    buf,
-                     size_t         buf_len,
-                     gcs_msg_type_t type)
+core_msg_sendv_retry (gcs_core_t*          core,
+                      const struct gu_buf* bufs,
+                      size_t               count,
+                      size_t               msg_len,
+                      gcs_msg_type_t       type)
 {
     ssize_t ret;
-    while ((ret = core_msg_send (core, buf, buf_len, type)) == -EAGAIN) {
+    while ((ret = core_msg_sendv (core, bufs, count, msg_len, type))
+           == -EAGAIN) {
         /* wait for primary configuration - sleep 0.01 sec */
         gu_debug ("Backend requested wait");
         usleep (10000);
@@ -316,6 +329,19 @@ core_msg_send_retry (gcs_core_t*    core,
     return ret;
 }
 
+static inline ssize_t
+core_msg_send_retry (gcs_core_t*    core,
+                     const void*    buf,
+                     size_t         buf_len,
+                     gcs_msg_type_t type)
+{
+    struct gu_buf const msg = { buf, (ssize_t)buf_len };
+    return core_msg_sendv_retry (core, &msg, 1, buf_len, type);
+}
+
+/*! maximum number of action buffer pieces in a fragment sent by sendv() */
+#define CORE_SENDV_MAX 32
+
 ssize_t
 gcs_core_send (gcs_core_t*          const conn,
                const struct gu_buf* const action,
@@ -362,44 +388,66 @@ gcs_core_send (gcs_core_t*          const conn,
         return ret;
     }
 
+    /* If backend can gather, fragment header and action buffers are passed
+     * to it as they are, otherwise the fragment is assembled in send_buf. */
+    bool const     gather = (conn->backend.sendv != NULL);
+    /* first unsent byte of action */
     int            idx  = 0;
-    const uint8_t* ptr  = (const uint8_t*)action[idx].ptr;
-    size_t         left = action[idx].size;
+    size_t         off  = 0;
 
     do {
-        const size_t chunk_size =
+        size_t chunk_size =
             act_size < frg.frag_len ? act_size : frg.frag_len;
 
-        /* Here is the only time we have to cast frg.frag */
-        char* dst = (char*)frg.frag;
-        size_t to_copy = chunk_size;
+        struct gu_buf frag[CORE_SENDV_MAX + 1] = {
+            { conn->send_buf, hdr_size }
+        };
+        size_t frag_cnt = 1;
 
-        while (to_copy > 0) {        // gather action bufs into one
-            if (to_copy <= left) {
-                memcpy (dst, ptr, to_copy);
-                ptr     += to_copy;
-                left    -= to_copy;
-                to_copy = 0;
-            }
-            else {
-                memcpy (dst, ptr, left);
-                dst     += left;
-                to_copy -= left;
-                idx++;
-                ptr  = (const uint8_t*)action[idx].ptr;
-                left = action[idx].size;
+        int    i     = idx;
+        size_t o     = off;
+        size_t to_go = chunk_size;
+
+        while (to_go > 0) {
+            const uint8_t* const ptr = (const uint8_t*)action[i].ptr + o;
+            size_t const left = action[i].size - o;
+            size_t const n    = left < to_go ? left : to_go;
+
+            if (n > 0) {
+                if (!gather) {
+                    /* Here is the only time we have to cast frg.frag */
+                    memcpy ((char*)frg.frag + chunk_size - to_go, ptr, n);
+                }
+                else if (frag_cnt <= CORE_SENDV_MAX) {
+                    frag[frag_cnt].ptr  = ptr;
+                    frag[frag_cnt].size = n;
+                    frag_cnt++;
+                }
+                else {
+                    /* too many pieces, send what we have collected */
+                    chunk_size -= to_go;
+                    break;
+                }
+
+                to_go -= n;
             }
+
+            i++;
+            o = 0;
         }
 
         send_size = hdr_size + chunk_size;
 
+        if (!gather) frag[0].size = send_size;
+
 #ifdef GCS_CORE_TESTING
         gu_lock_step_wait (&conn->ls); // pause after every fragment
-        gu_info ("Sent %p of size %zu. Total sent: %zu, left: %zu",
-                 (char*)conn->send_buf + hdr_size, chunk_size, sent, act_size);
+        gu_info ("Sent fragment of size %zu in %zu buffers. "
+                 "Total sent: %zu, left: %zu",
+                 chunk_size, frag_cnt, sent, act_size);
 #endif
-        ret = core_msg_send_retry (conn, conn->send_buf, send_size,
-                                   GCS_MSG_ACTION);
+        ret = core_msg_sendv_retry (conn, frag, frag_cnt, send_size,
+                                    GCS_MSG_ACTION);
         GU_DBUG_SYNC_WAIT("gcs_core_after_frag_send");
 #ifdef GCS_CORE_TESTING
 //        gu_lock_step_wait (&conn->ls); // pause after every fragment
@@ -416,28 +464,22 @@ gcs_core_send (gcs_core_t*          const conn,
             act_size -= ret;
 
             if (gu_unlikely((size_t)ret < chunk_size)) {
-                /* Could not send all that was copied: */
-
-                /* 1. adjust frag_len, don't copy more than we could send */
+                /* Could not send all that was collected:
+                 * adjust frag_len, don't collect more than we could send */
                 frg.frag_len = ret;
+            }
 
-                /* 2. move ptr back to point at the first unsent byte */
-                size_t move_back = chunk_size - ret;
-                size_t ptrdiff   = ptr - (uint8_t*)action[idx].ptr;
-                do {
-                    if (move_back <= ptrdiff) {
-                        ptr -= move_back;
-                        left = action[idx].size - ptrdiff + move_back;
-                        break;
-                    }
-                    else {
-                        assert (idx > 0);
-                        move_back -= ptrdiff;
-                        idx--;
-                        ptrdiff = action[idx].size;
-                        ptr = (uint8_t*)action[idx].ptr + ptrdiff;
-                    }
-                } while (true);
+            /* advance to the first unsent byte */
+            size_t adv = ret;
+            while (adv > 0) {
+                size_t const left = action[idx].size - off;
+                if (adv < left) {
+                    off += adv;
+                    break;
+                }
+                adv -= left;
+                idx++;
+                off  = 0;
             }
         }
         else {
@@ -15,6 +15,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include <algorithm> // std::min
+
 #include <galerautils.h>
 
 #define GCS_COMP_MSG_ACCESS // for gcs_comp_memb_t
@@ -124,6 +126,37 @@ GCS_BACKEND_SEND_FN(dummy_send)
     return err;
 }
 
+/* models backend that can't gather: assembles the message in a temporary
+ * buffer, at most max_send_size bytes, as dummy_send() would send */
+static
+GCS_BACKEND_SENDV_FN(dummy_sendv)
+{
+    dummy_t* dummy = backend->conn;
+
+    if (gu_unlikely(NULL == dummy)) return -EBADFD;
+
+    size_t const send_size(len < dummy->max_send_size ?
+                           len : dummy->max_send_size);
+    char* const buf(static_cast<char*>(gu_malloc(send_size)));
+
+    if (gu_unlikely(NULL == buf)) return -ENOMEM;
+
+    size_t off(0);
+    for (size_t i(0); i < count && off < send_size; ++i)
+    {
+        size_t const n(std::min<size_t>(bufs[i].size, send_size - off));
+        memcpy(buf + off, bufs[i].ptr, n);
+        off += n;
+    }
+    assert(off == send_size);
+
+    long const ret(dummy_send(backend, buf, send_size, msg_type));
+
+    gu_free(buf);
+
+    return ret;
+}
+
 static
 GCS_BACKEND_RECV_FN(dummy_recv)
 {
@@ -298,6 +331,7 @@ GCS_BACKEND_CREATE_FN(gcs_dummy_create)
     backend->close     = dummy_close;
     backend->destroy   = dummy_destroy;
     backend->send      = dummy_send;
+    backend->sendv     = dummy_sendv;
     backend->recv      = dummy_recv;
     backend->name      = dummy_name;
     backend->msg_size  = dummy_msg_size;
@@ -504,22 +504,10 @@ static GCS_BACKEND_MSG_SIZE_FN(gcomm_msg_size)
 }
 
 
-static GCS_BACKEND_SEND_FN(gcomm_send)
+static long
+gcomm_send_datagram(GCommConn& conn, Datagram& dg, size_t const len,
+                    gcs_msg_type_t const msg_type)
 {
-    GCommConn::Ref ref(backend);
-
-    if (gu_unlikely(ref.get() == 0))
-    {
-        return -EBADFD;
-    }
-
-    GCommConn& conn(*ref.get());
-
-    Datagram dg(
-        SharedBuffer(
-            new Buffer(reinterpret_cast<const byte_t*>(buf),
-                       reinterpret_cast<const byte_t*>(buf) + len)));
-
     int err;
     // Set thread scheduling params if gcomm thread runs with
     // non-default params
@@ -569,6 +557,53 @@ static GCS_BACKEND_SEND_FN(gcomm_send)
 }
 
 
+static GCS_BACKEND_SEND_FN(gcomm_send)
+{
+    GCommConn::Ref ref(backend);
+
+    if (gu_unlikely(ref.get() == 0))
+    {
+        return -EBADFD;
+    }
+
+    Datagram dg(
+        SharedBuffer(
+            new Buffer(reinterpret_cast<const byte_t*>(buf),
+                       reinterpret_cast<const byte_t*>(buf) + len)));
+
+    return gcomm_send_datagram(*ref.get(), dg, len, msg_type);
+}
+
+
+/* Gathers message directly into datagram payload. This is the only copy
+ * on the way to the socket: gcomm must own the payload since it is queued
+ * for asynchronous write and kept for retransmission. */
+static GCS_BACKEND_SENDV_FN(gcomm_sendv)
+{
+    GCommConn::Ref ref(backend);
+
+    if (gu_unlikely(ref.get() == 0))
+    {
+        return -EBADFD;
+    }
+
+    Buffer* const payload(new Buffer());
+    SharedBuffer const sb(payload);
+    payload->reserve(len);
+
+    for (size_t i(0); i < count; ++i)
+    {
+        const byte_t* const ptr(static_cast<const byte_t*>(bufs[i].ptr));
+        payload->insert(payload->end(), ptr, ptr + bufs[i].size);
+    }
+    assert(payload->size() == len);
+
+    Datagram dg(sb);
+
+    return gcomm_send_datagram(*ref.get(), dg, len, msg_type);
+}
+
+
 static void fill_cmp_msg(const View& view, const gcomm::UUID& my_uuid,
                          gcs_comp_msg_t* cm)
 {
@@ -924,6 +959,7 @@ GCS_BACKEND_CREATE_FN(gcs_gcomm_create)
     backend->close     = gcomm_close;
     backend->destroy   = gcomm_destroy;
     backend->send      = gcomm_send;
+    backend->sendv     = gcomm_sendv;
     backend->recv      = gcomm_recv;
     backend->name      = gcomm_name;
     backend->msg_size  = gcomm_msg_size;
@@ -518,7 +518,7 @@ core_test_cleanup ()
 
 // just a smoke test for core API
 static void
-test_api(bool const enc)
+test_api(bool const enc, bool const gather = true)
 {
     gu::Config config;
     core_test_init (&config, enc);
@@ -527,6 +527,9 @@ test_api(bool const enc)
     ck_assert(NULL != Core);
     ck_assert(NULL != Backend);
 
+    ck_assert(NULL != Backend->sendv);
+    if (!gather) Backend->sendv = NULL; // fragments are assembled in core
+
     long     ret;
     long     tout = 100; // 100 ms timeout
     const struct gu_buf* act = act3;
@@ -589,6 +592,12 @@ START_TEST (gcs_core_test_apiE)
 }
 END_TEST
 
+START_TEST (gcs_core_test_api_nogather)
+{
+    test_api(false, false);
+}
+END_TEST
+
 // do a single send step, compare with the expected result
 static inline bool
 CORE_SEND_STEP (gcs_core_t* core, long timeout, long ret, int line)
@@ -1089,6 +1098,7 @@ Suite *gcs_core_suite(void)
       tcase_add_test  (tcase, gcs_code_msg);
       tcase_add_test  (tcase, gcs_core_test_api);
       tcase_add_test  (tcase, gcs_core_test_apiE);
+      tcase_add_test  (tcase, gcs_core_test_api_nogather);
       tcase_add_test  (tcase, gcs_core_test_own_v0);
       tcase_add_test  (tcase, gcs_core_test_own_v1);
       tcase_add_test  (tcase, gcs_core_test_own_v1E);